@@ -0,0 +1,150 @@
+/**
+** \file Bench.cpp
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:50
+** \date Last update: 2026-10-16 19:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#include "./Bench.hpp"
+
+namespace bench {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr double min_run_ns = 20e6;
+        constexpr std::uint64_t max_iterations = std::uint64_t(1) << 32;
+        constexpr int repetitions = 7;
+
+        double since(Clock::time_point start) {
+            return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+
+        std::string escape(std::string const &str) {
+            std::string out;
+
+            for (char c : str) {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                out += c;
+            }
+
+            return out;
+        }
+
+        std::string number(double value) {
+            char buf[32];
+
+            std::snprintf(buf, sizeof(buf), "%.3f", value);
+            return buf;
+        }
+    }
+
+    Suite::Suite(std::string fixture, std::string filter)
+    : _fixture(std::move(fixture)), _filter(std::move(filter)) {}
+
+    std::string const &Suite::getFixture() const noexcept {
+        return _fixture;
+    }
+
+    void Suite::run(std::string const &name, Body const &body) {
+        if (!selected(name))
+            return;
+
+        _results.push_back(measure(name, 1, [&body](std::uint64_t n) {
+            Clock::time_point start = Clock::now();
+
+            body(n);
+            return since(start);
+        }));
+    }
+
+    /*
+    ** Threads are started once per timed run, and wait on a flag, so their
+    ** creation isn't measured. The run lasts until the last one is done.
+    */
+    void Suite::runThreads(std::string const &name, unsigned threads, ThreadBody const &body) {
+        if (!selected(name))
+            return;
+
+        _results.push_back(measure(name, threads, [threads, &body](std::uint64_t n) {
+            std::atomic<unsigned> ready{0};
+            std::atomic<bool> go{false};
+            std::vector<std::thread> workers;
+
+            for (unsigned t = 0; t < threads; ++t)
+                workers.emplace_back([&, t]() {
+                    ready.fetch_add(1);
+                    while (!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    body(t, n);
+                });
+
+            while (ready.load() != threads)
+                std::this_thread::yield();
+
+            Clock::time_point start = Clock::now();
+
+            go.store(true, std::memory_order_release);
+            for (auto &w : workers)
+                w.join();
+
+            return since(start);
+        }));
+    }
+
+    /*
+    ** Keys are always printed in the same order, with a fixed precision,
+    ** so that two result files can be compared line by line.
+    */
+    void Suite::printJson(std::ostream &out) const {
+        out << "{\n";
+        out << "  \"compiler\": \"" << escape(__VERSION__) << "\",\n";
+        out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "  \"benchmarks\": [\n";
+
+        for (std::size_t i = 0; i < _results.size(); ++i) {
+            Result const &r = _results[i];
+
+            out << "    {\"name\": \"" << escape(r.name) << "\""
+                << ", \"threads\": " << r.threads
+                << ", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << number(r.ns_per_op)
+                << ", \"min_ns\": " << number(r.min_ns)
+                << ", \"max_ns\": " << number(r.max_ns)
+                << "}" << (i + 1 < _results.size() ? "," : "") << "\n";
+        }
+
+        out << "  ]\n";
+        out << "}\n";
+    }
+
+    bool Suite::selected(std::string const &name) const {
+        return _filter.empty() || name.find(_filter) != std::string::npos;
+    }
+
+    Result Suite::measure(std::string const &name, unsigned threads, std::function<double(std::uint64_t)> const &timed) const {
+        std::uint64_t n = 1;
+        std::vector<double> samples;
+
+        std::cerr << name << "..." << std::endl;
+
+        while (n < max_iterations && timed(n) < min_run_ns)
+            n *= 2;
+
+        for (int i = 0; i < repetitions; ++i)
+            samples.push_back(timed(n) / n);
+
+        std::sort(samples.begin(), samples.end());
+
+        return {name, threads, n, samples[samples.size() / 2], samples.front(), samples.back()};
+    }
+}
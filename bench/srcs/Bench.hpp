@@ -0,0 +1,87 @@
+/**
+** \file Bench.hpp
+** Header for the microbenchmark harness.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:50
+** \date Last update: 2026-10-16 19:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef bench_Bench_hpp_
+#define bench_Bench_hpp_
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+    /**
+    ** \brief Result of a benchmark.
+    **
+    ** ns_per_op is the median of the repetitions, min_ns and max_ns their
+    ** extremes. For a multithreaded benchmark, it's the wall time of one
+    ** operation, as seen by each thread.
+    */
+    struct Result {
+        std::string name;
+        unsigned threads;
+        std::uint64_t iterations;
+        double ns_per_op;
+        double min_ns;
+        double max_ns;
+    };
+
+    /**
+    ** \class Suite
+    ** \brief Runs benchmarks, and prints their results as JSON.
+    **
+    ** A benchmark is a function running a given number of iterations of
+    ** the measured operation. The number of iterations is first doubled
+    ** until a run lasts long enough to be timed reliably, then the run is
+    ** repeated, and the median is kept.
+    **
+    ** A filter may be given, in which case only the benchmarks whose name
+    ** contains it are run.
+    */
+    class Suite {
+        public:
+            using Body = std::function<void(std::uint64_t)>;
+            using ThreadBody = std::function<void(unsigned, std::uint64_t)>;
+
+            explicit Suite(std::string fixture, std::string filter = std::string());
+
+            [[nodiscard]]
+            std::string const &getFixture() const noexcept;
+
+            void run(std::string const &name, Body const &body);
+            void runThreads(std::string const &name, unsigned threads, ThreadBody const &body);
+
+            void printJson(std::ostream &out) const;
+        private:
+            bool selected(std::string const &name) const;
+            Result measure(std::string const &name, unsigned threads, std::function<double(std::uint64_t)> const &timed) const;
+
+            std::string _fixture;
+            std::string _filter;
+            std::vector<Result> _results;
+    };
+
+    /**
+    ** \brief Keep the compiler from optimizing a value away.
+    **
+    ** \param value Value that must be computed.
+    */
+    template <typename T>
+    inline void doNotOptimize(T const &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    void lookupBenchmarks(Suite &suite);
+    void functionBenchmarks(Suite &suite);
+    void contentionBenchmarks(Suite &suite);
+}
+
+#endif
@@ -0,0 +1,66 @@
+/**
+** \file bench_Contention.cpp
+** Lookups made concurrently, by several threads, through dlsym and
+** through a single BasicLoader shared by const reference.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:50
+** \date Last update: 2026-10-16 19:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/backends.hpp"
+
+#include "./Bench.hpp"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdu = clonixin::dynamicloader::utils;
+
+namespace bench {
+    namespace {
+        constexpr std::size_t name_count = 64;
+    }
+
+    /*
+    ** Thread counts go up to the number of hardware threads, so that the
+    ** results measure contention, not oversubscription.
+    */
+    void contentionBenchmarks(Suite &suite) {
+        std::vector<std::string> strings;
+        std::vector<cdu::ZStringView> names;
+        unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+        for (std::size_t i = 0; i < name_count; ++i)
+            strings.push_back("bench_fn_" + std::to_string(i));
+        for (auto const &str : strings)
+            names.push_back(str);
+
+        void *hndl = dlopen(suite.getFixture().c_str(), RTLD_NOW);
+        cd::BasicLoader<cd::backends::DefaultBackend> const loader(suite.getFixture());
+
+        for (unsigned threads = 1; threads <= std::min(max_threads, 8u); threads *= 2) {
+            std::string suffix = "/threads:" + std::to_string(threads);
+
+            suite.runThreads("dlsym/hit" + suffix, threads, [&](unsigned t, std::uint64_t n) {
+                for (std::uint64_t i = 0; i < n; ++i)
+                    doNotOptimize(dlsym(hndl, names[(i + t) & (name_count - 1)].c_str()));
+            });
+
+            suite.runThreads("BasicLoader<LinuxBackend>/getSymbol/hit" + suffix, threads, [&](unsigned t, std::uint64_t n) {
+                for (std::uint64_t i = 0; i < n; ++i)
+                    doNotOptimize(loader.getSymbol<void *>(names[(i + t) & (name_count - 1)]));
+            });
+        }
+
+        if (hndl != nullptr)
+            dlclose(hndl);
+    }
+}
@@ -0,0 +1,45 @@
+/**
+** \file bench_Function.cpp
+** Compare calls through a Function handle with calls through the raw
+** function pointer, and through a std::function.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:35
+** \date Last update: 2026-10-16 19:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <functional>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/backends.hpp"
+
+#include "./Bench.hpp"
+
+namespace cd = clonixin::dynamicloader;
+
+namespace bench {
+    namespace {
+        /*
+        ** The argument changes at each iteration, and every result is kept,
+        ** so the calls can't be hoisted out of the loop, nor dropped.
+        */
+        template <typename Fn>
+        void calls(Fn const &fn, std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(fn(static_cast<int>(i & 7)));
+        }
+    }
+
+    void functionBenchmarks(Suite &suite) {
+        cd::BasicLoader<cd::backends::DefaultBackend> fixture(suite.getFixture());
+
+        int (*raw)(int) = fixture.getSymbol<int (*)(int)>("bench_fn_0");
+        cd::Function<int(int)> handle = fixture.getFunction<int(int)>("bench_fn_0");
+        std::function<int(int)> erased = raw;
+
+        suite.run("call/raw_pointer", [&](std::uint64_t n) { calls(raw, n); });
+        suite.run("call/Function", [&](std::uint64_t n) { calls(handle, n); });
+        suite.run("call/std::function", [&](std::uint64_t n) { calls(erased, n); });
+    }
+}
@@ -0,0 +1,141 @@
+/**
+** \file bench_Lookup.cpp
+** Single threaded symbol lookups: raw dlsym, the Linux backend, and
+** BasicLoader over the Linux and mock backends, on hits and misses.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:50
+** \date Last update: 2026-10-16 19:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/backends.hpp"
+#include "resources/mocks/backends/MockBackend.hpp"
+
+#include "./Bench.hpp"
+
+namespace cd = clonixin::dynamicloader;
+namespace cde = clonixin::dynamicloader::exceptions;
+namespace cdu = clonixin::dynamicloader::utils;
+
+using tests::mocks::backends::MockBackend;
+
+namespace bench {
+    namespace {
+        /*
+        ** Lookups cycle through name_count names, so that a single cache
+        ** line doesn't stay hot. name_count must be a power of two.
+        */
+        constexpr std::size_t name_count = 64;
+
+        constexpr char static_name[] = "bench_fn_7";
+
+        struct Names {
+            explicit Names(char const *prefix) {
+                for (std::size_t i = 0; i < name_count; ++i)
+                    strings.push_back(prefix + std::to_string(i));
+                for (auto const &str : strings)
+                    views.push_back(str);
+            }
+
+            cdu::ZStringView operator[](std::uint64_t i) const noexcept {
+                return views[i & (name_count - 1)];
+            }
+
+            std::vector<std::string> strings;
+            std::vector<cdu::ZStringView> views;
+        };
+    }
+
+    void lookupBenchmarks(Suite &suite) {
+        Names hits("bench_fn_");
+        Names misses("bench_missing_");
+
+        void *hndl = dlopen(suite.getFixture().c_str(), RTLD_NOW);
+        cd::BasicLoader<cd::backends::DefaultBackend> loader(suite.getFixture());
+        cd::backends::DefaultBackend const &backend = loader.accessBackend();
+        cd::BasicLoader<MockBackend> mock("mock", MockBackend::dont_fail);
+
+        for (std::size_t i = 0; i < name_count; ++i)
+            mock.accessBackend()[hits.strings[i]] = dlsym(hndl, hits.strings[i].c_str());
+
+        suite.run("dlsym/hit", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(dlsym(hndl, hits[i].c_str()));
+        });
+
+        suite.run("dlsym/miss", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(dlsym(hndl, misses[i].c_str()));
+        });
+
+        suite.run("LinuxBackend/lookupSymbol/hit", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(backend.lookupSymbol(hits[i]).sym);
+        });
+
+        suite.run("LinuxBackend/containsSymbol/miss", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(backend.containsSymbol(misses[i]));
+        });
+
+        suite.run("BasicLoader<LinuxBackend>/getSymbol/hit", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(loader.getSymbol<void *>(hits[i]));
+        });
+
+        suite.run("BasicLoader<LinuxBackend>/getSymbol/static_name", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(loader.getSymbol<static_name, void *>());
+        });
+
+        suite.run("BasicLoader<LinuxBackend>/getSymbol/miss_throw", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                try {
+                    doNotOptimize(loader.getSymbol<void *>(misses[i]));
+                } catch (cde::DLException<cde::Type::LoadSym> const &e) {
+                    doNotOptimize(e);
+                }
+            }
+        });
+
+        suite.run("BasicLoader<LinuxBackend>/tryGetSymbol/miss", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(loader.tryGetSymbol<void *>(misses[i]).has_value());
+        });
+
+        suite.run("BasicLoader<LinuxBackend>/findSymbol/miss", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(loader.findSymbol<void *>(misses[i]).hasValue());
+        });
+
+        suite.run("BasicLoader<MockBackend>/getSymbol/hit", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(mock.getSymbol<void *>(hits[i]));
+        });
+
+        suite.run("BasicLoader<MockBackend>/getSymbol/miss_throw", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) {
+                try {
+                    doNotOptimize(mock.getSymbol<void *>(misses[i]));
+                } catch (cde::DLException<cde::Type::LoadSym> const &e) {
+                    doNotOptimize(e);
+                }
+            }
+        });
+
+        suite.run("BasicLoader<MockBackend>/tryGetSymbol/miss", [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i)
+                doNotOptimize(mock.tryGetSymbol<void *>(misses[i]).has_value());
+        });
+
+        if (hndl != nullptr)
+            dlclose(hndl);
+    }
+}
@@ -0,0 +1,36 @@
+/**
+** \file main.cpp
+** Entry point of the microbenchmarks.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:50
+** \date Last update: 2026-10-16 19:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <iostream>
+
+#include "./Bench.hpp"
+
+/*
+** Usage: bench_dynamicloader <fixture> [filter]
+**
+** The results are printed on the standard output, as JSON, and the
+** progress on the error output.
+*/
+int main(int ac, char **av) {
+    if (ac < 2) {
+        std::cerr << "Usage: " << av[0] << " <fixture> [filter]" << std::endl;
+        return 1;
+    }
+
+    bench::Suite suite(av[1], ac > 2 ? av[2] : "");
+
+    bench::lookupBenchmarks(suite);
+    bench::functionBenchmarks(suite);
+    bench::contentionBenchmarks(suite);
+
+    suite.printJson(std::cout);
+
+    return 0;
+}
@@ -0,0 +1,371 @@
+/**
+** \file BasicLoader/AsyncOpener.hpp
+** Header for AsyncOpener, opening libraries on a pool of worker threads,
+** and PendingLoader, the future result of such an opening.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 17:50
+** \date Last update: 2026-10-16 17:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef BasicLoader_AsyncOpener_hpp_
+#define BasicLoader_AsyncOpener_hpp_
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utils/sfinae.hpp"
+#include "BasicLoader/BasicLoader.hpp"
+
+namespace clonixin::dynamicloader {
+    class AsyncOpener;
+
+    namespace _internals {
+        /**
+        ** \brief An opening waiting in the queue of an AsyncOpener.
+        */
+        struct OpenTask {
+            int priority;
+            std::uint64_t seq;
+            bool queued;
+            std::function<void()> run;
+        };
+
+        /**
+        ** \brief Queue order: highest priority first, then first submitted.
+        */
+        struct OpenTaskOrder {
+            bool operator()(std::shared_ptr<OpenTask> const &lhs, std::shared_ptr<OpenTask> const &rhs) const noexcept {
+                if (lhs->priority != rhs->priority)
+                    return lhs->priority > rhs->priority;
+                return lhs->seq < rhs->seq;
+            }
+        };
+    }
+
+    /**
+    ** \class PendingLoader
+    ** \brief Future BasicLoader, being opened by an AsyncOpener.
+    **
+    ** Waiting on a PendingLoader whose opening has not started yet moves it
+    ** to the front of the queue, so that a thread blocked on a library
+    ** never waits behind less urgent ones.
+    **
+    ** \warning A PendingLoader must not outlive the AsyncOpener it comes
+    ** from.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <class Backend>
+    class PendingLoader {
+        public:
+            PendingLoader(PendingLoader const &) = delete;
+            PendingLoader(PendingLoader &&) noexcept = default;
+
+            PendingLoader &operator=(PendingLoader const &) = delete;
+            PendingLoader &operator=(PendingLoader &&) noexcept = default;
+
+            [[nodiscard]]
+            BasicLoader<Backend> get();
+            void wait() const;
+            bool promote() const;
+
+            [[nodiscard]]
+            bool isReady() const;
+            [[nodiscard]]
+            bool valid() const noexcept;
+        private:
+            PendingLoader(std::future<BasicLoader<Backend>> &&future, std::shared_ptr<_internals::OpenTask> task, AsyncOpener *opener) noexcept;
+
+        private:
+            std::future<BasicLoader<Backend>> _future;
+            std::shared_ptr<_internals::OpenTask> _task;
+            AsyncOpener *_opener;
+
+            friend AsyncOpener;
+    };
+
+    /**
+    ** \class AsyncOpener
+    ** \brief Pool of worker threads opening libraries in the background.
+    **
+    ** Each call to open() queues the construction of a BasicLoader, and
+    ** returns immediately a PendingLoader. Queued openings are run by
+    ** priority, highest first, and in submission order for a given
+    ** priority. An opening someone waits on is promoted to Urgent.
+    **
+    ** If the backend provides a static prefetch(std::string const &path)
+    ** function, it's called by the worker before constructing the loader,
+    ** to start reading the library while other libraries are relocated.
+    **
+    ** Openings still queued when the AsyncOpener is destroyed are run
+    ** before the destructor returns.
+    */
+    class AsyncOpener {
+        public:
+            /**
+            ** \brief Priority given to the openings someone waits on.
+            */
+            static constexpr int Urgent = std::numeric_limits<int>::max();
+
+            explicit AsyncOpener(std::size_t workers = 0);
+            AsyncOpener(AsyncOpener const &) = delete;
+            ~AsyncOpener();
+
+            AsyncOpener &operator=(AsyncOpener const &) = delete;
+
+            template <class Backend, typename... Args>
+            [[nodiscard]]
+            PendingLoader<Backend> open(std::string const &path, int priority, Args &&... args);
+
+            [[nodiscard]]
+            std::size_t getQueued() const;
+        private:
+            bool promote(std::shared_ptr<_internals::OpenTask> const &task);
+            void work();
+
+        private:
+            mutable std::mutex _lock;
+            std::condition_variable _ready;
+            std::set<std::shared_ptr<_internals::OpenTask>, _internals::OpenTaskOrder> _queue;
+            std::uint64_t _seq;
+            bool _stopping;
+            std::vector<std::thread> _workers;
+
+            template <class Backend>
+            friend class PendingLoader;
+    };
+
+    /**
+    ** \brief Wrap a future loader.
+    **
+    ** \param future Future set by the worker running the opening.
+    ** \param task Queued opening, used to promote it.
+    ** \param opener AsyncOpener running the opening.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <class Backend>
+    PendingLoader<Backend>::PendingLoader(std::future<BasicLoader<Backend>> &&future, std::shared_ptr<_internals::OpenTask> task, AsyncOpener *opener) noexcept
+    : _future(std::move(future)), _task(std::move(task)), _opener(opener) {}
+
+    /**
+    ** \brief Wait for the loader, and retrieve it.
+    **
+    ** If the opening is still queued, it's promoted to the front of the
+    ** queue first. This function may only be called once.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return The opened loader.
+    **
+    ** \throw DLException<Open> or any exception thrown by the constructor of
+    ** the loader.
+    */
+    template <class Backend>
+    BasicLoader<Backend> PendingLoader<Backend>::get() {
+        wait();
+        _task.reset();
+        return _future.get();
+    }
+
+    /**
+    ** \brief Wait for the opening to complete.
+    **
+    ** If the opening is still queued, it's promoted to the front of the
+    ** queue first.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <class Backend>
+    void PendingLoader<Backend>::wait() const {
+        (void)promote();
+        _future.wait();
+    }
+
+    /**
+    ** \brief Move the opening to the front of the queue, without waiting.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return true if the opening was still queued, and has been promoted.
+    */
+    template <class Backend>
+    bool PendingLoader<Backend>::promote() const {
+        return _task != nullptr && _opener->promote(_task);
+    }
+
+    /**
+    ** \brief Check whether the opening is complete, without waiting.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return true if get() would not block.
+    */
+    template <class Backend>
+    bool PendingLoader<Backend>::isReady() const {
+        return _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /**
+    ** \brief Check whether the loader can still be retrieved.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return false once get() has been called.
+    */
+    template <class Backend>
+    bool PendingLoader<Backend>::valid() const noexcept {
+        return _future.valid();
+    }
+
+    /**
+    ** \brief Start the worker threads.
+    **
+    ** \param workers Number of threads. If 0, one per hardware thread.
+    */
+    inline AsyncOpener::AsyncOpener(std::size_t workers) : _seq(0), _stopping(false) {
+        if (workers == 0)
+            workers = std::max(1u, std::thread::hardware_concurrency());
+
+        _workers.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i)
+            _workers.emplace_back(&AsyncOpener::work, this);
+    }
+
+    /**
+    ** \brief Run the remaining openings, and stop the worker threads.
+    */
+    inline AsyncOpener::~AsyncOpener() {
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _stopping = true;
+        }
+        _ready.notify_all();
+
+        for (auto &worker : _workers)
+            worker.join();
+    }
+
+    /**
+    ** \brief Queue the opening of a library.
+    **
+    ** The arguments are copied, and passed, along with path, to the
+    ** constructor of BasicLoader<Backend>, on a worker thread.
+    **
+    ** \param path Path of the library.
+    ** \param priority Openings with a higher priority are run first.
+    ** \param args Extra arguments given to the backend.
+    **
+    ** \tparam Backend Type of the backend of the loader.
+    ** \tparam Args Types of the extra arguments.
+    **
+    ** \return A PendingLoader, which will hold the loader, or the exception
+    ** thrown by its constructor.
+    */
+    template <class Backend, typename... Args>
+    PendingLoader<Backend> AsyncOpener::open(std::string const &path, int priority, Args &&... args) {
+        auto promise = std::make_shared<std::promise<BasicLoader<Backend>>>();
+        auto task = std::make_shared<_internals::OpenTask>();
+        std::future<BasicLoader<Backend>> future = promise->get_future();
+
+        task->priority = priority;
+        task->queued = true;
+        task->run = [promise, path, params = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)]() mutable {
+            try {
+                if constexpr (hasprefetch_v<Backend>)
+                    Backend::prefetch(path);
+
+                promise->set_value(std::apply([&path](auto &... p) {
+                    return BasicLoader<Backend>(path, p...);
+                }, params));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        };
+
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            task->seq = _seq++;
+            _queue.insert(task);
+        }
+        _ready.notify_one();
+
+        return PendingLoader<Backend>(std::move(future), std::move(task), this);
+    }
+
+    /**
+    ** \brief Get the number of openings that have not started yet.
+    **
+    ** \return The size of the queue.
+    */
+    inline std::size_t AsyncOpener::getQueued() const {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        return _queue.size();
+    }
+
+    /**
+    ** \brief Move a queued opening to the front of the queue.
+    **
+    ** \param task The opening to promote.
+    **
+    ** \return false if the opening already started.
+    */
+    inline bool AsyncOpener::promote(std::shared_ptr<_internals::OpenTask> const &task) {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        if (!task->queued || task->priority == Urgent)
+            return false;
+
+        _queue.erase(task);
+        task->priority = Urgent;
+        _queue.insert(task);
+
+        return true;
+    }
+
+    /**
+    ** \brief Worker loop: run openings until the opener is destroyed and
+    ** the queue is empty.
+    */
+    inline void AsyncOpener::work() {
+        for (;;) {
+            std::shared_ptr<_internals::OpenTask> task;
+
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+
+                _ready.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+                if (_queue.empty())
+                    return;
+
+                task = *_queue.begin();
+                _queue.erase(_queue.begin());
+                task->queued = false;
+            }
+
+            task->run();
+            task->run = nullptr;
+        }
+    }
+}
+
+#endif
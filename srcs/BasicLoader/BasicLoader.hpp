@@ -4,7 +4,7 @@
 **
 ** \author phantomas <phantomas@phantomas.xyz>
 ** \date Creation: 2020-04-17 00:56
-** \date Last update: 2020-04-29 02:23
+** \date Last update: 2026-10-16 23:55
 ** \copyright GNU Lesser Public Licence v3
 */
 
@@ -13,13 +13,23 @@
 
 #include <string>
 #include <optional>
+#include <memory>
+#include <vector>
 #if __cplusplus < 201703L
     #warning "C++ version should be c++17 or higher."
 #endif
 #include <type_traits>
 
 #include "utils/sfinae.hpp"
+#include "utils/ZStringView.hpp"
+#include "utils/SymbolCache.hpp"
+#include "utils/StaticName.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
 #include "exceptions/DLException.hpp"
+#include "BasicLoader/Function.hpp"
+#include "BasicLoader/SymbolTable.hpp"
+#include "BasicLoader/SymbolResult.hpp"
 
 namespace clonixin::dynamicloader {
     namespace cde = clonixin::dynamicloader::exceptions;
@@ -40,11 +50,11 @@ namespace clonixin::dynamicloader {
     ** The backend must also provide at least the following functions:
     **   - bool hasError() noexcept, which is called to check whether the last
     **     operation caused an error or not.
-    **   - bool %hasSymbol() noexcept, which is called to check whether a given
-    **     symbol exists or not.
+    **   - bool %hasSymbol(utils::ZStringView name) noexcept, which is called to
+    **     check whether a given symbol exists or not.
     **   - std::string getPath() noexcept, a function returning the path of the
     **     opened dynamic library.
-    **   - SymAddr getSymbol(std::string const name) noexcept, which is called
+    **   - SymAddr getSymbol(utils::ZStringView name) noexcept, which is called
     **     when retrieving a symbol, and should return an opaque type, that can
     **     be compared to nullptr, and reinterpreted as any types.
     **   - std::string getPath() const noexcept, called if the path of the resource
@@ -56,11 +66,62 @@ namespace clonixin::dynamicloader {
     **     denoting whether the operation was successful or not. On error, the
     **     backend should not be modified.
     **
+    ** The backend may also provide the following optional functions:
+    **   - std::size_t getSymbols(utils::ZStringView const *names,
+    **     std::size_t count, SymAddr *out, bool *failed, std::string *errors)
+    **     const noexcept, which resolves count symbols at once, storing their
+    **     addresses in out, whether each lookup failed in failed, and the
+    **     error message of the failed ones in errors. It returns the number
+    **     of failed lookups. If available, it's used by resolveSymbols()
+    **     instead of one lookup per symbol.
+    **   - Lookup lookupSymbol(utils::ZStringView name) const noexcept, and
+    **     bool containsSymbol(utils::ZStringView name) const noexcept, which
+    **     behave like getSymbol() and hasSymbol(), but return their error by
+    **     value instead of storing it in the backend. Lookup can be any type
+    **     with sym, has_error and error members. They must be safe to call
+    **     concurrently.
+    **   - bool mayContainSymbol(utils::ZStringView name) const noexcept,
+    **     which returns false if the symbol is known not to exist, without
+    **     allocating. It may return true for symbols that don't exist, but
+    **     must never return false for a symbol the backend would find, as
+    **     findSymbol() reports such names missing without looking them up.
+    **
+    ** Symbol names are passed around as utils::ZStringView, which can be built
+    ** from a string literal, a char const *, or a std::string without any
+    ** copy. Looking up a literal on a warm cache never allocates.
+    **
     ** It's assumed that the backend will follow RAII pattern, and manage the
     ** lifetime of it's handle. It's highly encouraged to handle the move
     ** operations without opening a new handle, as the wrapper will discard the
     ** old value, which in turn will call the destructor.
     **
+    ** Every lookup result, successful or not, is kept in a per-loader cache,
+    ** so that a given name only goes through the backend once. Only the
+    ** first utils::SymbolCache::MaxMisses failed lookups are kept, so that
+    ** probing for arbitrary names can't grow the cache without bound. The
+    ** cache is tagged by a generation number, which changes whenever the
+    ** backend is reset or replaced, dropping every cached entries at once.
+    **
+    ** If the backend provides lookupSymbol() and containsSymbol(), the const
+    ** member functions of this class never modify the backend, and the cache
+    ** can be read and filled concurrently, so a single loader can be shared,
+    ** through a const reference, by any number of threads, without locking.
+    ** With other backends, const member functions go through the stateful
+    ** getSymbol() and hasSymbol() functions, and concurrent calls must be
+    ** serialized by the caller. Non-const member functions always require
+    ** exclusive access.
+    **
+    ** findSymbol() and the tryGetSymbol() overloads that don't report the
+    ** error don't allocate when a lookup fails, once the name is cached, or
+    ** if the backend's mayContainSymbol() rejects it. Error messages are only
+    ** formatted when they are asked for. If memory runs out while caching a
+    ** result, or formatting a message, the noexcept functions still return
+    ** the result of the backend, without its message.
+    **
+    ** When utils::Metrics are enabled, every lookup is counted, along with
+    ** whether it was served by the cache, and how it failed. When
+    ** utils::Trace is enabled, resets are traced.
+    **
     ** \tparam Backend Type of the backend class.
     */
     template <class Backend>
@@ -82,82 +143,136 @@ namespace clonixin::dynamicloader {
             bool reset(Backend &&bck) noexcept;
 
             [[nodiscard]]
-            bool hasSymbol(std::string const &name) const noexcept;
+            bool hasSymbol(utils::ZStringView name) const noexcept;
 
             /* ifptr_t<T> functions */
             template <typename T>
             [[nodiscard]]
-            ifptr_t<T> getSymbol(std::string const &name) const;
+            ifptr_t<T> getSymbol(utils::ZStringView name) const;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<ifptr_t<T>> tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept;
+            std::optional<ifptr_t<T>> tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<ifptr_t<T>> tryGetSymbol(std::string const &name) const noexcept;
+            std::optional<ifptr_t<T>> tryGetSymbol(utils::ZStringView name) const noexcept;
             /* !ifptr_t<T> functions */
 
             /* iflref_t<T> functions */
             template <typename T>
             [[nodiscard]]
-            iflref_t<T> getSymbol(std::string const &name) const;
+            iflref_t<T> getSymbol(utils::ZStringView name) const;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<refw<iflref_t<T>>> tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept;
+            std::optional<refw<iflref_t<T>>> tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<refw<iflref_t<T>>> tryGetSymbol(std::string const &name) const noexcept;
+            std::optional<refw<iflref_t<T>>> tryGetSymbol(utils::ZStringView name) const noexcept;
             /* !iflref_t<T> functions */
 
             /* ifmove_t<T> functions */
             template <typename T>
             [[nodiscard]]
-            ifmove_t<T> getSymbol(std::string const &name) const;
+            ifmove_t<T> getSymbol(utils::ZStringView name) const;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<ifmove_t<T>> tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept;
+            std::optional<ifmove_t<T>> tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<ifmove_t<T>> tryGetSymbol(std::string const &name) const noexcept;
+            std::optional<ifmove_t<T>> tryGetSymbol(utils::ZStringView name) const noexcept;
             /* !ifmove_t<T> functions */
 
             /* ifcopy_t<T> functions */
             template <typename T>
             [[nodiscard]]
-            ifcopy_t<T> getSymbol(std::string const &name) const;
+            ifcopy_t<T> getSymbol(utils::ZStringView name) const;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<ifcopy_t<T>> tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept;
+            std::optional<ifcopy_t<T>> tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept;
 
             template <typename T>
             [[nodiscard]]
-            std::optional<ifcopy_t<T>> tryGetSymbol(std::string const &name) const noexcept;
+            std::optional<ifcopy_t<T>> tryGetSymbol(utils::ZStringView name) const noexcept;
             /* !ifcopy_t<T> functions */
 
             /* iferror_t<T> functions */
             template <typename T>
             [[noreturn]]
-            iferror_t<T> getSymbol(std::string const &name) const;
+            iferror_t<T> getSymbol(utils::ZStringView name) const;
 
             template <typename T>
             [[noreturn]]
-            std::optional<iferror_t<T>> tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept;
+            std::optional<iferror_t<T>> tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept;
 
             template <typename T>
             [[noreturn]]
-            std::optional<iferror_t<T>> tryGetSymbol(std::string const &name) const noexcept;
+            std::optional<iferror_t<T>> tryGetSymbol(utils::ZStringView name) const noexcept;
             /* !iferror_t<T> functions */
 
+            template <typename T>
+            [[nodiscard]]
+            SymbolResult<T> findSymbol(utils::ZStringView name) const noexcept;
+
+            /* Function handles */
+            template <typename Sig>
+            [[nodiscard]]
+            Function<Sig> getFunction(utils::ZStringView name) const;
+
+            template <typename Sig>
+            [[nodiscard]]
+            std::optional<Function<Sig>> tryGetFunction(utils::ZStringView name) const noexcept;
+            /* !Function handles */
+
+            /* Batch functions */
+            template <typename Names>
+            [[nodiscard]]
+            SymbolTable<typename Backend::SymAddr> resolveSymbols(Names const &names) const;
+
+            template <typename Names>
+            [[nodiscard]]
+            SymbolTable<typename Backend::SymAddr> getSymbols(Names const &names) const;
+            /* !Batch functions */
+
+            /* Compile time names functions */
+            template <auto &Name, typename T>
+            [[nodiscard]]
+            T getSymbol() const;
+            /* !Compile time names functions */
+
+            template <typename B = Backend>
+            [[nodiscard]]
+            auto getSymbolIndex() const -> decltype(std::declval<B const &>().getSymbolIndex());
+
+            [[nodiscard]]
+            std::uint64_t getGeneration() const noexcept;
+
             [[nodiscard]]
             Backend &accessBackend();
+        private:
+            using Entry = typename utils::SymbolCache<typename Backend::SymAddr>::Entry;
+
+            Entry const &lookup(utils::ZStringView name, Entry &uncached) const;
+            Entry const &lookup(utils::ZStringView name, std::uint64_t hash, Entry &uncached) const;
+
+            template <typename T>
+            static T castSymbol(typename Backend::SymAddr sym);
+
+            static void countLookup(typename Backend::SymAddr sym, bool has_error, bool cached) noexcept;
+
+            static std::string pathOf(void const *loader);
+
+            template <typename, class>
+            friend class LazySymbol;
+
         private:
             mutable Backend     _backend;
+            mutable utils::SymbolCache<typename Backend::SymAddr> _cache;
     };
 
     /**
@@ -201,14 +316,15 @@ namespace clonixin::dynamicloader {
     ** \brief Move constructor
     **
     ** This constructor initialize the object backend by std::move-ing the
-    ** other object backend.
+    ** other object backend. The symbol cache is moved along with it.
     **
     ** \param oth BasicLoader to be moved.
     **
     ** \tparam Backend Type of the backend object.
     */
     template <class Backend>
-    BasicLoader<Backend>::BasicLoader(BasicLoader && oth) noexcept : _backend(oth._backend) {}
+    BasicLoader<Backend>::BasicLoader(BasicLoader && oth) noexcept
+    : _backend(std::move(oth._backend)), _cache(std::move(oth._cache)) {}
 
     /**
     ** \brief BasicLoader Destructor
@@ -227,7 +343,8 @@ namespace clonixin::dynamicloader {
     ** \brief Move assignment operator
     **
     ** This operator call the move assignment operator on it's backend by
-    ** std::move-ing the backend of the other object.
+    ** std::move-ing the backend of the other object. The symbol cache is
+    ** moved along with it.
     **
     ** \param rhs BasicLoader to be moved.
     **
@@ -238,13 +355,15 @@ namespace clonixin::dynamicloader {
     template <class Backend>
     BasicLoader<Backend>& BasicLoader<Backend>::operator=(BasicLoader<Backend> &&rhs) noexcept {
         _backend = std::move(rhs._backend);
+        _cache = std::move(rhs._cache);
         return *this;
     }
 
     /**
     ** \brief rvalue backend assignation.
     **
-    ** This operator move assign the BasicLoader backend.
+    ** This operator move assign the BasicLoader backend, and invalidate the
+    ** symbol cache.
     **
     ** \param rhs Backend object to be std::move'd
     **
@@ -259,6 +378,7 @@ namespace clonixin::dynamicloader {
     template <class Backend>
     BasicLoader<Backend>& BasicLoader<Backend>::operator=(Backend &&rhs) noexcept {
         _backend = std::move(rhs);
+        _cache.invalidate();
         return *this;
     }
 
@@ -266,6 +386,7 @@ namespace clonixin::dynamicloader {
     ** \brief Reset the underlying backend.
     **
     ** This function calls the backend reset function, with a new path and args.
+    ** The symbol cache is invalidated, whether the reset is successful or not.
     **
     ** \param path Path of the file to load
     ** \param args Variadic list of optional arguments, that will be passed as-is to the constructor.
@@ -279,7 +400,14 @@ namespace clonixin::dynamicloader {
     template <class Backend>
     template <typename... Args>
     bool BasicLoader<Backend>::reset(std::string const &path, Args &&... args) noexcept {
-        return _backend.reset(path, std::forward<Args>(args)...);
+        utils::Trace::Span span(utils::Trace::Kind::Reset, path);
+
+        _cache.invalidate();
+        if (_backend.reset(path, std::forward<Args>(args)...))
+            return true;
+
+        utils::Trace::instant(utils::Trace::Kind::Error, path);
+        return false;
     }
 
     /**
@@ -301,7 +429,10 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     bool BasicLoader<Backend>::reset(Backend && bck) noexcept {
+        utils::Trace::Span span(utils::Trace::Kind::Reset, bck.getPath());
+
         _backend = std::move(bck);
+        _cache.invalidate();
         return true;
     }
 
@@ -312,6 +443,11 @@ namespace clonixin::dynamicloader {
     ** Use this function if you use a symbol name as a magic value, but don't
     ** need the actual value.
     **
+    ** If the name was already looked up, the cached result is used.
+    ** Otherwise, Backend::hasSymbol is called, which may answer faster than
+    ** a full lookup, especially for missing symbols. Its result is not
+    ** cached.
+    **
     ** \param name The name of the symbol needed.
     **
     ** \tparam Backend Type of the backend object.
@@ -319,8 +455,14 @@ namespace clonixin::dynamicloader {
     ** \return This function return true if the symbol returns.
     */
     template <class Backend>
-    bool BasicLoader<Backend>::hasSymbol(std::string const &name) const noexcept {
-        return _backend.hasSymbol(name);
+    bool BasicLoader<Backend>::hasSymbol(utils::ZStringView name) const noexcept {
+        if (Entry const *cached = _cache.find(name, utils::hashName(name.data(), name.size())))
+            return !cached->has_error;
+
+        if constexpr (haslookup_v<Backend>)
+            return _backend.containsSymbol(name);
+        else
+            return _backend.hasSymbol(name);
     }
 
     /**
@@ -361,13 +503,14 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    ifptr_t<T> BasicLoader<Backend>::getSymbol(std::string const &name) const {
-        void * sym = _backend.getSymbol(name);
+    ifptr_t<T> BasicLoader<Backend>::getSymbol(utils::ZStringView name) const {
+        Entry uncached{};
+        Entry const &e = lookup(name, uncached);
 
-        if (sym == nullptr && _backend.hasError())
-            throw cde::DLException<cde::Type::LoadSym>(name, _backend.getLastError());
+        if (e.sym == nullptr && e.has_error)
+            throw cde::DLException<cde::Type::LoadSym>(name.str(), e.error);
 
-        return reinterpret_cast<T>(sym);
+        return reinterpret_cast<T>(e.sym);
     }
 
     /**
@@ -387,7 +530,8 @@ namespace clonixin::dynamicloader {
     ** \param err_type A reference on a exceptions::Type which will be changed
     ** to reflect the kind of error, if needed.
     ** \param err_out A reference on a std::string on which the assignment
-    ** operator will be called with a string describing the error.
+    ** operator will be called with a string describing the error. It's
+    ** cleared if the message can't be allocated.
     **
     ** \tparam Backend Type of the backend object.
     ** \tparam T A type for which std::is_pointer_v<T> is true.
@@ -397,16 +541,20 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<ifptr_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept {
-        typename Backend::SymAddr sym = _backend.getSymbol(name);
-
-        if (sym == nullptr && _backend.hasError()) {
-            err_type = cde::Type::LoadSym;
-            err_out = _backend.getLastError();
+    std::optional<ifptr_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res) {
+            err_type = res.error().getType();
+            try {
+                err_out = res.error().getMessage();
+            } catch (...) {
+                err_out.clear();
+            }
             return std::nullopt;
         }
 
-        return reinterpret_cast<T>(sym);
+        return res.value();
     }
 
     /**
@@ -432,10 +580,13 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<ifptr_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name) const noexcept {
-        std::string discard;
-        cde::Type tdiscard;
-        return tryGetSymbol<T>(name, tdiscard, discard);
+    std::optional<ifptr_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res)
+            return std::nullopt;
+
+        return res.value();
     }
     /**@}*/
 
@@ -479,15 +630,16 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    iflref_t<T> BasicLoader<Backend>::getSymbol(std::string const &name) const {
-        typename Backend::SymAddr sym = _backend.getSymbol(name);
+    iflref_t<T> BasicLoader<Backend>::getSymbol(utils::ZStringView name) const {
+        Entry uncached{};
+        Entry const &e = lookup(name, uncached);
 
-        if (sym == nullptr && _backend.hasError())
-            throw cde::DLException<cde::Type::LoadSym>(name, _backend.getLastError());
-        else if (sym == nullptr)
-            throw cde::DLException<cde::Type::NullSym>(name, std::string(_backend.getPath() + ": Symbol " + name + " is NULL and cannot be casted."));
+        if (e.sym == nullptr && e.has_error)
+            throw cde::DLException<cde::Type::LoadSym>(name.str(), e.error);
+        else if (e.sym == nullptr)
+            SymbolError(cde::Type::NullSym, name, nullptr, this, &pathOf).raise();
 
-        return *reinterpret_cast<std::remove_reference_t<T> *>(sym);
+        return *reinterpret_cast<std::remove_reference_t<T> *>(e.sym);
     }
 
     /**
@@ -505,7 +657,8 @@ namespace clonixin::dynamicloader {
     ** \param err_type A reference on a exceptions::Type which will be changed
     ** to reflect the kind of error, if needed.
     ** \param err_out A reference on a std::string on which the assignment
-    ** operator will be called with a string describing the error.
+    ** operator will be called with a string describing the error. It's
+    ** cleared if the message can't be allocated.
     **
     ** \tparam Backend Type of the backend object.
     ** \tparam T A lvalue reference type
@@ -517,23 +670,20 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<refw<iflref_t<T>>> BasicLoader<Backend>::tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept {
-        typename Backend::SymAddr sym = _backend.getSymbol(name);
-
-        if (sym == nullptr) {
-            if (_backend.hasError()) {
-                err_type = cde::Type::LoadSym;
-                err_out = _backend.getLastError();
-            }
-            else {
-                err_type = cde::Type::NullSym;
-                err_out = _backend.getPath() + ": Symbol " + name + " is NULL and cannot be cast-ed.";
+    std::optional<refw<iflref_t<T>>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res) {
+            err_type = res.error().getType();
+            try {
+                err_out = res.error().getMessage();
+            } catch (...) {
+                err_out.clear();
             }
-
             return std::nullopt;
         }
 
-        return *reinterpret_cast<std::remove_reference_t<T> *>(sym);
+        return res.value();
     }
 
     /**
@@ -559,10 +709,13 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<refw<iflref_t<T>>> BasicLoader<Backend>::tryGetSymbol(std::string const &name) const noexcept {
-        std::string discard;
-        cde::Type tdiscard;
-        return tryGetSymbol<T>(name, tdiscard, discard);
+    std::optional<refw<iflref_t<T>>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res)
+            return std::nullopt;
+
+        return res.value();
     }
     /**@}*/
 
@@ -607,15 +760,16 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    ifmove_t<T> BasicLoader<Backend>::getSymbol(std::string const &name) const {
-        typename Backend::SymAddr sym = _backend.getSymbol(name);
+    ifmove_t<T> BasicLoader<Backend>::getSymbol(utils::ZStringView name) const {
+        Entry uncached{};
+        Entry const &e = lookup(name, uncached);
 
-        if (sym == nullptr && _backend.hasError())
-            throw cde::DLException<cde::Type::LoadSym>(name, _backend.getLastError());
-        else if (sym == nullptr)
-            throw cde::DLException<cde::Type::NullSym>(name, std::string(_backend.getPath() + ": Symbol " + name + " is NULL and cannot be casted."));
+        if (e.sym == nullptr && e.has_error)
+            throw cde::DLException<cde::Type::LoadSym>(name.str(), e.error);
+        else if (e.sym == nullptr)
+            SymbolError(cde::Type::NullSym, name, nullptr, this, &pathOf).raise();
 
-        return std::move(*reinterpret_cast<T *>(sym));
+        return std::move(*reinterpret_cast<T *>(e.sym));
     }
 
     /**
@@ -633,7 +787,8 @@ namespace clonixin::dynamicloader {
     ** \param err_type A reference on a exceptions::Type which will be changed
     ** to reflect the kind of error, if needed.
     ** \param err_out A reference on a std::string on which the assignment
-    ** operator will be called with a string describing the error.
+    ** operator will be called with a string describing the error. It's
+    ** cleared if the message can't be allocated.
     **
     ** \tparam Backend Type of the backend object.
     ** \tparam T A non-pointer move constructible or move assignable type.
@@ -645,23 +800,20 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<ifmove_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept {
-        typename Backend::SymAddr sym = _backend.getSymbol(name);
-
-        if (sym == nullptr) {
-            if (_backend.hasError()) {
-                err_type = cde::Type::LoadSym;
-                err_out = _backend.getLastError();
+    std::optional<ifmove_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res) {
+            err_type = res.error().getType();
+            try {
+                err_out = res.error().getMessage();
+            } catch (...) {
+                err_out.clear();
             }
-            else {
-                err_type = cde::Type::NullSym;
-                err_out = _backend.getPath() + ": Symbol " + name + " is NULL and cannot be cast-ed.";
-            }
-
             return std::nullopt;
         }
 
-        return std::move(*reinterpret_cast<T *>(sym));
+        return res.value();
     }
 
     /**
@@ -687,10 +839,13 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<ifmove_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name) const noexcept {
-        std::string discard;
-        cde::Type tdiscard;
-        return tryGetSymbol<T>(name, tdiscard, discard);
+    std::optional<ifmove_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res)
+            return std::nullopt;
+
+        return res.value();
     }
     /**@}*/
 
@@ -737,15 +892,16 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    ifcopy_t<T> BasicLoader<Backend>::getSymbol(std::string const &name) const {
-        typename Backend::SymAddr sym = _backend.getSymbol(name);
+    ifcopy_t<T> BasicLoader<Backend>::getSymbol(utils::ZStringView name) const {
+        Entry uncached{};
+        Entry const &e = lookup(name, uncached);
 
-        if (sym == nullptr && _backend.hasError())
-            throw cde::DLException<cde::Type::LoadSym>(name, _backend.getLastError());
-        else if (sym == nullptr)
-            throw cde::DLException<cde::Type::NullSym>(name, std::string(_backend.getPath() + ": Symbol " + name + " is NULL and cannot be casted."));
+        if (e.sym == nullptr && e.has_error)
+            throw cde::DLException<cde::Type::LoadSym>(name.str(), e.error);
+        else if (e.sym == nullptr)
+            SymbolError(cde::Type::NullSym, name, nullptr, this, &pathOf).raise();
 
-        return *reinterpret_cast<T *>(sym);
+        return *reinterpret_cast<T *>(e.sym);
     }
 
     /**
@@ -763,7 +919,8 @@ namespace clonixin::dynamicloader {
     ** \param err_type A reference on a exceptions::Type which will be changed
     ** to reflect the kind of error, if needed.
     ** \param err_out A reference on a std::string on which the assignment
-    ** operator will be called with a string describing the error.
+    ** operator will be called with a string describing the error. It's
+    ** cleared if the message can't be allocated.
     **
     ** \tparam Backend Type of the backend object.
     ** \tparam T A non-pointer copy constructible or copy assignable type.
@@ -775,22 +932,20 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<ifcopy_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept {
-        typename Backend::SymAddr sym = _backend.getSymbol(name);
-
-        if (sym == nullptr) {
-            if (_backend.hasError()) {
-                err_type = cde::Type::LoadSym;
-                err_out = _backend.getLastError();
-            }
-            else {
-                err_type = cde::Type::NullSym;
-                err_out = _backend.getPath() + ": Symbol " + name + " is NULL and cannot be cast-ed.";
+    std::optional<ifcopy_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res) {
+            err_type = res.error().getType();
+            try {
+                err_out = res.error().getMessage();
+            } catch (...) {
+                err_out.clear();
             }
             return std::nullopt;
         }
 
-        return *reinterpret_cast<T *>(sym);
+        return *res.address();
     }
 
     /**
@@ -816,10 +971,13 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<ifcopy_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name) const noexcept {
-        std::string discard;
-        cde::Type tdiscard;
-        return tryGetSymbol<T>(name, tdiscard, discard);
+    std::optional<ifcopy_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name) const noexcept {
+        SymbolResult<T> res = findSymbol<T>(name);
+
+        if (!res)
+            return std::nullopt;
+
+        return *res.address();
     }
     /**@}*/
 
@@ -861,7 +1019,7 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    iferror_t<T> BasicLoader<Backend>::getSymbol(std::string const &name) const {
+    iferror_t<T> BasicLoader<Backend>::getSymbol(utils::ZStringView name) const {
         static_assert(!iserror_v<T>, "Type is neither copyable nor movable. You should use a pointer instead.");
         throw std::runtime_error("This function should not have been compiled.");
     }
@@ -887,7 +1045,7 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<iferror_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name, cde::Type &err_type, std::string &err_out) const noexcept {
+    std::optional<iferror_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name, cde::Type &err_type, std::string &err_out) const noexcept {
         static_assert(!iserror_v<T>, "Type is neither copyable nor movable. You should use a pointer instead.");
         throw std::runtime_error("This function should not have been compiled.");
     }
@@ -910,12 +1068,379 @@ namespace clonixin::dynamicloader {
     */
     template <class Backend>
     template <typename T>
-    std::optional<iferror_t<T>> BasicLoader<Backend>::tryGetSymbol(std::string const &name) const noexcept {
+    std::optional<iferror_t<T>> BasicLoader<Backend>::tryGetSymbol(utils::ZStringView name) const noexcept {
         static_assert(!iserror_v<T>, "Type is neither copyable nor movable. You should use a pointer instead.");
         throw std::runtime_error("This function should not have been compiled.");
     }
     /** @} */
 
+    /**
+    ** \brief Look a symbol up, without throwing nor allocating on failure.
+    **
+    ** The symbol is looked up in the cache, then, on a miss, checked with
+    ** Backend::mayContainSymbol, if available, and finally resolved by the
+    ** backend, and cached. Names rejected by mayContainSymbol are not cached.
+    ** Failed lookups that the cache refused, or that could not be cached for
+    ** lack of memory, are reported without the message of the backend.
+    **
+    ** On failure, the returned SymbolError only refers to name and to this
+    ** loader. It's message is formatted when SymbolError::getMessage is
+    ** called.
+    **
+    ** \param name The name of the symbol to retrieve. It must outlive the
+    ** result.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam T The type of the symbol, as it would be given to getSymbol.
+    **
+    ** \return A SymbolResult holding the address of the symbol, or the
+    ** description of the error. LoadSym is reported if the symbol could not
+    ** be found, NullSym if it's null and T is not a pointer.
+    */
+    template <class Backend>
+    template <typename T>
+    SymbolResult<T> BasicLoader<Backend>::findSymbol(utils::ZStringView name) const noexcept {
+        using target_t = std::remove_reference_t<T>;
+
+        std::uint64_t hash = utils::hashName(name.data(), name.size());
+        Entry const *e = _cache.find(name, hash);
+        Entry uncached{};
+
+        if (e == nullptr) {
+            if constexpr (hasprobe_v<Backend>) {
+                if (!_backend.mayContainSymbol(name)) {
+                    countLookup(nullptr, true, false);
+                    return SymbolError(cde::Type::LoadSym, name, nullptr, this, &pathOf);
+                }
+            }
+
+            try {
+                e = &lookup(name, hash, uncached);
+            } catch (...) {
+                e = &uncached;
+            }
+        } else
+            countLookup(e->sym, e->has_error, true);
+
+        if (e->has_error)
+            return SymbolError(cde::Type::LoadSym, name, e != &uncached ? &e->error : nullptr, this, &pathOf);
+
+        if constexpr (isptr_v<T>)
+            return reinterpret_cast<T>(e->sym);
+        else {
+            if (e->sym == nullptr)
+                return SymbolError(cde::Type::NullSym, name, nullptr, this, &pathOf);
+
+            return reinterpret_cast<target_t *>(e->sym);
+        }
+    }
+
+    /**
+    ** \brief Get a typed handle on a function.
+    **
+    ** The returned Function holds the raw address of the function, and can
+    ** be stored and copied freely, as a function pointer would.
+    **
+    ** \param name The name of the function to retrieve.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam Sig Signature of the function, R(Args...), optionally
+    ** noexcept.
+    **
+    ** \return A handle on the function, which is never empty.
+    **
+    ** \throw DLException<LoadSym> if the symbol could not be found.
+    ** \throw DLException<NullSym> if the symbol is null.
+    */
+    template <class Backend>
+    template <typename Sig>
+    Function<Sig> BasicLoader<Backend>::getFunction(utils::ZStringView name) const {
+        using pointer = typename Function<Sig>::pointer;
+
+        pointer fn = getSymbol<pointer>(name);
+
+        if (fn == nullptr)
+            SymbolError(cde::Type::NullSym, name, nullptr, this, &pathOf).raise();
+
+        return Function<Sig>(fn);
+    }
+
+    /**
+    ** \brief Optionally get a typed handle on a function.
+    **
+    ** Equivalent to getFunction, except that it never throws, nor allocates
+    ** once the name is cached.
+    **
+    ** \param name The name of the function to retrieve.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam Sig Signature of the function, R(Args...), optionally
+    ** noexcept.
+    **
+    ** \return A handle on the function, or std::nullopt if the symbol could
+    ** not be found, or is null.
+    */
+    template <class Backend>
+    template <typename Sig>
+    std::optional<Function<Sig>> BasicLoader<Backend>::tryGetFunction(utils::ZStringView name) const noexcept {
+        using pointer = typename Function<Sig>::pointer;
+
+        SymbolResult<pointer> res = findSymbol<pointer>(name);
+
+        if (!res || res.address() == nullptr)
+            return std::nullopt;
+
+        return Function<Sig>(res.address());
+    }
+
+    /**
+    ** \name Batch symbols getters
+    **
+    ** These functions resolve a whole set of symbols at once, and return
+    ** their address in a SymbolTable.
+    */
+    /**@{*/
+
+    /**
+    ** \brief Resolve a set of symbols at once.
+    **
+    ** Every names is first looked up in the symbol cache. The remaining ones
+    ** are then resolved in a single call to Backend::getSymbols if the
+    ** backend provides it, or by looking each of them up otherwise. Results
+    ** are stored in the cache, as long as it accepts them.
+    **
+    ** This function does not stop on the first missing symbol. Every symbols
+    ** that could not be resolved are reported in SymbolTable::getMissing.
+    **
+    ** \param names A range of names, such as a std::vector<std::string>, or an
+    ** array of char const *. The names are viewed, not copied, unless they
+    ** are reported missing.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam Names Type of the range of names.
+    **
+    ** \return A SymbolTable, holding the address of each symbol, in the same
+    ** order as names.
+    */
+    template <class Backend>
+    template <typename Names>
+    SymbolTable<typename Backend::SymAddr> BasicLoader<Backend>::resolveSymbols(Names const &names) const {
+        using SymAddr = typename Backend::SymAddr;
+
+        std::vector<utils::ZStringView> keys(std::begin(names), std::end(names));
+        std::vector<std::uint64_t> hashes(keys.size());
+        std::vector<Entry const *> entries(keys.size(), nullptr);
+        std::vector<std::size_t> misses;
+        std::vector<Entry> uncached;
+
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            hashes[i] = utils::hashName(keys[i].data(), keys[i].size());
+            entries[i] = _cache.find(keys[i], hashes[i]);
+
+            if (entries[i] == nullptr)
+                misses.push_back(i);
+        }
+
+        if (!misses.empty()) {
+            std::vector<utils::ZStringView> miss_names;
+            std::vector<SymAddr> miss_addrs(misses.size(), nullptr);
+            std::unique_ptr<bool[]> miss_failed(new bool[misses.size()]());
+            std::vector<std::string> miss_errors(misses.size());
+
+            uncached.resize(misses.size());
+            miss_names.reserve(misses.size());
+            for (std::size_t i = 0; i < misses.size(); ++i)
+                miss_names.push_back(keys[misses[i]]);
+
+            if constexpr (hasbatch_v<Backend>) {
+                (void)_backend.getSymbols(miss_names.data(), miss_names.size(), miss_addrs.data(), miss_failed.get(), miss_errors.data());
+            } else if constexpr (haslookup_v<Backend>) {
+                for (std::size_t i = 0; i < misses.size(); ++i) {
+                    auto result = _backend.lookupSymbol(miss_names[i]);
+
+                    miss_addrs[i] = result.sym;
+                    miss_failed[i] = result.has_error;
+                    if (result.has_error)
+                        miss_errors[i] = std::move(result.error);
+                }
+            } else {
+                for (std::size_t i = 0; i < misses.size(); ++i) {
+                    miss_addrs[i] = _backend.getSymbol(miss_names[i]);
+                    miss_failed[i] = miss_addrs[i] == nullptr && _backend.hasError();
+
+                    if (miss_failed[i])
+                        miss_errors[i] = _backend.getLastError();
+                }
+            }
+
+            for (std::size_t i = 0; i < misses.size(); ++i) {
+                std::size_t idx = misses[i];
+
+                uncached[i] = Entry{miss_addrs[i], miss_failed[i], std::move(miss_errors[i])};
+                entries[idx] = _cache.insert(keys[idx], hashes[idx], uncached[i]);
+                if (entries[idx] == nullptr)
+                    entries[idx] = &uncached[i];
+            }
+        }
+
+        SymbolTable<SymAddr> table(keys.size());
+
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (entries[i]->has_error)
+                table.setMissing(i, keys[i].str(), entries[i]->error);
+            else
+                table.set(i, entries[i]->sym);
+        }
+
+        return table;
+    }
+
+    /**
+    ** \brief Get a set of symbols at once.
+    **
+    ** This function calls BasicLoader::resolveSymbols, then, if any symbol
+    ** could not be resolved, throws a single exception describing every
+    ** missing symbols.
+    **
+    ** \param names A range of names, such as a std::vector<std::string>, or an
+    ** array of char const *.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam Names Type of the range of names.
+    **
+    ** \return A SymbolTable, holding the address of each symbol, in the same
+    ** order as names.
+    **
+    ** \throw DLException<LoadSym> if at least one symbol could not be found.
+    ** The name of the exception is the comma separated list of the missing
+    ** symbols, and it's message the concatenation of the backend errors.
+    */
+    template <class Backend>
+    template <typename Names>
+    SymbolTable<typename Backend::SymAddr> BasicLoader<Backend>::getSymbols(Names const &names) const {
+        SymbolTable<typename Backend::SymAddr> table = resolveSymbols(names);
+
+        if (!table.allResolved()) {
+            std::string missing_names;
+            std::string errors;
+
+            for (auto const &missing : table.getMissing()) {
+                if (!missing_names.empty()) {
+                    missing_names += ", ";
+                    errors += "\n";
+                }
+                missing_names += missing.name;
+                errors += missing.error;
+            }
+
+            throw cde::DLException<cde::Type::LoadSym>(missing_names, errors);
+        }
+
+        return table;
+    }
+    /**@}*/
+
+    /**
+    ** \brief Get a symbol whose name is known at compile time.
+    **
+    ** This function behaves like the getSymbol overload matching T, except
+    ** that the name is given as a template parameter, which must be a
+    ** reference on a constexpr char array:
+    **
+    **     static constexpr char plugin_entry[] = "plugin_entry";
+    **     auto fn = loader.getSymbol<plugin_entry, int (*)(int)>();
+    **
+    ** The hash of the name is computed at compile time. Each thread keeps a
+    ** slot per name and type, holding the last resolved address along with
+    ** the generation of the loader it was resolved from. As generations are
+    ** unique, once resolved, a lookup only costs a comparison against the
+    ** loader generation.
+    **
+    ** Only non null symbols are kept in the slot. Errors, and null symbols,
+    ** always go through the regular path, and are reported the same way.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam Name Reference on a constexpr char array holding the name.
+    ** \tparam T The type of the symbol, as accepted by the other getSymbol.
+    **
+    ** \return The symbol, as returned by the getSymbol overload matching T.
+    **
+    ** \throw DLException<LoadSym> if the symbol could not be found.
+    ** \throw DLException<NullSym> if the symbol is null, and T is not a pointer.
+    */
+    template <class Backend>
+    template <auto &Name, typename T>
+    T BasicLoader<Backend>::getSymbol() const {
+        using name_t = utils::StaticName<Name>;
+
+        struct Slot {
+            std::uint64_t generation;
+            typename Backend::SymAddr sym;
+        };
+        thread_local Slot slot = {0, nullptr};
+
+        std::uint64_t generation = _cache.getGeneration();
+        if (slot.generation == generation) {
+            countLookup(slot.sym, false, true);
+            return castSymbol<T>(slot.sym);
+        }
+
+        utils::ZStringView name(name_t::data, name_t::size);
+        Entry uncached{};
+        Entry const &e = lookup(name, name_t::hash, uncached);
+
+        if (e.sym == nullptr)
+            return getSymbol<T>(name);
+
+        slot = {generation, e.sym};
+        return castSymbol<T>(e.sym);
+    }
+
+    /**
+    ** \brief Cast a non null symbol to T.
+    **
+    ** Dispatch between the symbol getters semantics, depending on T. See the
+    ** getSymbol overloads for details.
+    **
+    ** \param sym The value returned by the backend. It must not be null,
+    ** unless T is a pointer.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam T The type of the symbol.
+    **
+    ** \return The symbol, cast to T.
+    */
+    template <class Backend>
+    template <typename T>
+    T BasicLoader<Backend>::castSymbol(typename Backend::SymAddr sym) {
+        static_assert(!iserror_v<T>, "Type is neither copyable nor movable. You should use a pointer instead.");
+
+        if constexpr (isptr_v<T>)
+            return reinterpret_cast<T>(sym);
+        else if constexpr (islref_v<T>)
+            return *reinterpret_cast<std::remove_reference_t<T> *>(sym);
+        else if constexpr (ismovable_v<T>)
+            return std::move(*reinterpret_cast<T *>(sym));
+        else
+            return *reinterpret_cast<T *>(sym);
+    }
+
+    /**
+    ** \brief Get the path of the library of a loader.
+    **
+    ** Used by SymbolError to format messages on demand.
+    **
+    ** \param loader Pointer on the BasicLoader that built the error.
+    **
+    ** \tparam Backend Type of the backend object.
+    **
+    ** \return The value returned by Backend::getPath().
+    */
+    template <class Backend>
+    std::string BasicLoader<Backend>::pathOf(void const *loader) {
+        return static_cast<BasicLoader const *>(loader)->_backend.getPath();
+    }
+
     /**
     ** \brief Gives direct access to the backend object.
     **
@@ -925,14 +1450,142 @@ namespace clonixin::dynamicloader {
     ** It's not considered safe to use, and does not enable the use of
     ** methods in this class, but could still prove useful in some scenarii.
     **
+    ** As the backend could be modified through the returned reference, the
+    ** symbol cache is invalidated.
+    **
     ** \return Return a reference on the backend of the current object.
     **
     ** \tparam Backend Type of the backend object.
     */
     template <class Backend>
     Backend & BasicLoader<Backend>::accessBackend() {
+        _cache.invalidate();
         return _backend;
     }
+
+    /**
+    ** \brief Get the index of the symbols exported by the library.
+    **
+    ** This function is only available if the backend provides a
+    ** getSymbolIndex() function, in which case it's result is returned as-is.
+    ** It enables the enumeration of the symbols of the library, without
+    ** having to guess their names.
+    **
+    ** \tparam Backend Type of the backend object.
+    ** \tparam B Defaulted to Backend, used for SFINAE.
+    **
+    ** \return The value returned by Backend::getSymbolIndex().
+    */
+    template <class Backend>
+    template <typename B>
+    auto BasicLoader<Backend>::getSymbolIndex() const -> decltype(std::declval<B const &>().getSymbolIndex()) {
+        return _backend.getSymbolIndex();
+    }
+
+    /**
+    ** \brief Get the generation of the symbol cache.
+    **
+    ** The generation changes every time the backend is reset, replaced, or
+    ** accessed through accessBackend(). Generations are unique across every
+    ** loaders of the process.
+    **
+    ** \tparam Backend Type of the backend object.
+    **
+    ** \return The current generation number.
+    */
+    template <class Backend>
+    std::uint64_t BasicLoader<Backend>::getGeneration() const noexcept {
+        return _cache.getGeneration();
+    }
+
+    /**
+    ** \brief Resolve a symbol, going through the cache.
+    **
+    ** If the name was already looked up during the current generation, the
+    ** cached result is returned, without calling the backend. Otherwise,
+    ** Backend::lookupSymbol, or Backend::getSymbol if the former is not
+    ** available, is called, and it's result stored in the cache, including
+    ** the error, if any. If another thread cached the same name in the
+    ** meantime, it's entry is returned instead.
+    **
+    ** The result is first stored in uncached, which is returned if the
+    ** cache refuses it. Should an allocation fail while caching it, uncached
+    ** still holds the address, and whether the lookup failed.
+    **
+    ** \param name The name of the symbol to retrieve.
+    ** \param uncached Storage for a result the cache doesn't keep.
+    **
+    ** \tparam Backend Type of the backend object.
+    **
+    ** \return A reference on the cache entry of the symbol, or on uncached.
+    */
+    template <class Backend>
+    typename BasicLoader<Backend>::Entry const &BasicLoader<Backend>::lookup(utils::ZStringView name, Entry &uncached) const {
+        return lookup(name, utils::hashName(name.data(), name.size()), uncached);
+    }
+
+    /**
+    ** \brief Resolve a symbol whose name hash is already known.
+    **
+    ** \param name The name of the symbol to retrieve.
+    ** \param hash The hash of name, as returned by utils::hashName().
+    ** \param uncached Storage for a result the cache doesn't keep.
+    **
+    ** \tparam Backend Type of the backend object.
+    **
+    ** \return A reference on the cache entry of the symbol, or on uncached.
+    */
+    template <class Backend>
+    typename BasicLoader<Backend>::Entry const &BasicLoader<Backend>::lookup(utils::ZStringView name, std::uint64_t hash, Entry &uncached) const {
+        if (Entry const *cached = _cache.find(name, hash)) {
+            countLookup(cached->sym, cached->has_error, true);
+            return *cached;
+        }
+
+        if constexpr (haslookup_v<Backend>) {
+            auto result = _backend.lookupSymbol(name);
+
+            uncached.sym = result.sym;
+            uncached.has_error = result.has_error;
+            uncached.error = std::move(result.error);
+        } else {
+            uncached.sym = _backend.getSymbol(name);
+            uncached.has_error = uncached.sym == nullptr && _backend.hasError();
+            if (uncached.has_error)
+                uncached.error = _backend.getLastError();
+        }
+
+        countLookup(uncached.sym, uncached.has_error, false);
+
+        Entry const *e = _cache.insert(name, hash, uncached);
+
+        return e != nullptr ? *e : uncached;
+    }
+
+    /**
+    ** \brief Record a lookup in the metrics, if they are enabled.
+    **
+    ** \param sym Address the lookup resolved to.
+    ** \param has_error Whether the lookup failed.
+    ** \param cached Whether the result came from the cache.
+    **
+    ** \tparam Backend Type of the backend object.
+    */
+    template <class Backend>
+    void BasicLoader<Backend>::countLookup(typename Backend::SymAddr sym, bool has_error, bool cached) noexcept {
+        using Metrics = utils::Metrics;
+
+        if (!Metrics::isEnabled())
+            return;
+
+        Metrics::add(Metrics::Counter::Lookups);
+        Metrics::add(cached ? Metrics::Counter::Hits : Metrics::Counter::Misses);
+
+        if (has_error)
+            Metrics::add(Metrics::Counter::NotFound);
+        else if (sym == nullptr)
+            Metrics::add(Metrics::Counter::NullSymbols);
+    }
 } // namespace clonixin::DLoader
 
 #endif
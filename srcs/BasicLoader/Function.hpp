@@ -0,0 +1,142 @@
+/**
+** \file BasicLoader/Function.hpp
+** Header for Function, a typed handle on a function symbol.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:35
+** \date Last update: 2026-10-16 19:35
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef BasicLoader_Function_hpp_
+#define BasicLoader_Function_hpp_
+
+#include <type_traits>
+#include <utility>
+
+namespace clonixin::dynamicloader {
+    namespace _internals {
+        /**
+        ** \class FunctionImpl
+        ** \brief Implementation of Function, shared by the noexcept and
+        ** the throwing signatures.
+        **
+        ** \tparam NoExcept Whether the function is noexcept.
+        ** \tparam R Return type of the function.
+        ** \tparam Args Types of the parameters of the function.
+        */
+        template <bool NoExcept, typename R, typename... Args>
+        class FunctionImpl {
+            public:
+                using pointer = R (*)(Args...) noexcept(NoExcept);
+
+                constexpr FunctionImpl() noexcept = default;
+                constexpr explicit FunctionImpl(pointer fn) noexcept;
+
+                template <typename... CallArgs, typename = std::enable_if_t<std::is_invocable_r_v<R, pointer, CallArgs...>>>
+                constexpr R operator()(CallArgs &&... args) const noexcept(NoExcept);
+
+                [[nodiscard]]
+                constexpr pointer get() const noexcept;
+                constexpr explicit operator bool() const noexcept;
+            private:
+                pointer _fn = nullptr;
+        };
+
+        /**
+        ** \brief Wrap a function pointer.
+        **
+        ** \param fn Address of the function.
+        **
+        ** \tparam NoExcept Whether the function is noexcept.
+        ** \tparam R Return type of the function.
+        ** \tparam Args Types of the parameters of the function.
+        */
+        template <bool NoExcept, typename R, typename... Args>
+        constexpr FunctionImpl<NoExcept, R, Args...>::FunctionImpl(pointer fn) noexcept
+        : _fn(fn) {}
+
+        /**
+        ** \brief Call the function.
+        **
+        ** Arguments are forwarded as given, and only converted to the types
+        ** of the parameters by the call itself, as with a raw pointer.
+        **
+        ** \param args Arguments of the call.
+        **
+        ** \tparam NoExcept Whether the function is noexcept.
+        ** \tparam R Return type of the function.
+        ** \tparam Args Types of the parameters of the function.
+        ** \tparam CallArgs Types of the arguments of the call.
+        **
+        ** \return The value returned by the function.
+        */
+        template <bool NoExcept, typename R, typename... Args>
+        template <typename... CallArgs, typename>
+        constexpr R FunctionImpl<NoExcept, R, Args...>::operator()(CallArgs &&... args) const noexcept(NoExcept) {
+            return _fn(std::forward<CallArgs>(args)...);
+        }
+
+        /**
+        ** \brief Get the address of the function.
+        **
+        ** \tparam NoExcept Whether the function is noexcept.
+        ** \tparam R Return type of the function.
+        ** \tparam Args Types of the parameters of the function.
+        **
+        ** \return The wrapped pointer.
+        */
+        template <bool NoExcept, typename R, typename... Args>
+        constexpr typename FunctionImpl<NoExcept, R, Args...>::pointer FunctionImpl<NoExcept, R, Args...>::get() const noexcept {
+            return _fn;
+        }
+
+        /**
+        ** \brief Check whether the handle holds a function.
+        **
+        ** \tparam NoExcept Whether the function is noexcept.
+        ** \tparam R Return type of the function.
+        ** \tparam Args Types of the parameters of the function.
+        **
+        ** \return false for a default constructed handle.
+        */
+        template <bool NoExcept, typename R, typename... Args>
+        constexpr FunctionImpl<NoExcept, R, Args...>::operator bool() const noexcept {
+            return _fn != nullptr;
+        }
+    }
+
+    /**
+    ** \class Function
+    ** \brief Typed handle on a function symbol, as returned by
+    ** BasicLoader::getFunction.
+    **
+    ** A Function only holds the raw function pointer. It's trivially
+    ** copyable, fits in a register, and calling it is the same indirect
+    ** call as calling the pointer: there is no type erasure, no
+    ** allocation, and no check. A noexcept signature is preserved, and
+    ** makes the call operator noexcept.
+    **
+    **     auto cosine = loader.getFunction<double(double) noexcept>("cos");
+    **     double one = cosine(0.0);
+    **
+    ** \tparam Sig Signature of the function, R(Args...) or R(Args...)
+    ** noexcept.
+    */
+    template <typename Sig>
+    class Function;
+
+    template <typename R, typename... Args>
+    class Function<R(Args...)> : public _internals::FunctionImpl<false, R, Args...> {
+        public:
+            using _internals::FunctionImpl<false, R, Args...>::FunctionImpl;
+    };
+
+    template <typename R, typename... Args>
+    class Function<R(Args...) noexcept> : public _internals::FunctionImpl<true, R, Args...> {
+        public:
+            using _internals::FunctionImpl<true, R, Args...>::FunctionImpl;
+    };
+}
+
+#endif
@@ -0,0 +1,378 @@
+/**
+** \file BasicLoader/LazySymbol.hpp
+** Header for LazySymbol, a handle on a symbol resolved on first use.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:20
+** \date Last update: 2026-10-16 23:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef BasicLoader_LazySymbol_hpp_
+#define BasicLoader_LazySymbol_hpp_
+
+#include <atomic>
+#include <string>
+#include <utility>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/backends.hpp"
+#include "exceptions/exceptions.hpp"
+#include "utils/ZStringView.hpp"
+
+namespace clonixin::dynamicloader {
+    namespace cde = clonixin::dynamicloader::exceptions;
+
+    /**
+    ** \class LazySymbol
+    ** \brief Handle on a symbol of a loader, resolved on first use.
+    **
+    ** A LazySymbol only stores a pointer on its loader, the name of the
+    ** symbol, and its address once resolved. Its constructor is constexpr,
+    ** so handles declared at namespace scope are constant initialized, and
+    ** cost nothing until they are used:
+    **
+    **     DefaultLoader plugin("libplugin.so");
+    **     LazySymbol<int(char const *)> plugin_init(plugin, "plugin_init");
+    **     LazySymbol<Config *> plugin_config(plugin, "plugin_config");
+    **
+    ** The first use resolves the symbol through BasicLoader::getSymbol, and
+    ** publishes its address in an atomic. Any number of threads may use
+    ** the same handle concurrently, as long as the loader allows
+    ** concurrent lookups. Threads racing on the first use all resolve the
+    ** same address. Afterward, a use is a single load of that address.
+    **
+    ** Only the function type and pointer specializations are defined. A
+    ** function pointer type is handled as the function type it points to.
+    **
+    ** \warning The address is not dropped when the loader is reset, and
+    ** reset() must be called on every handle of a loader that was reset.
+    ** The loader must outlive its handles.
+    **
+    ** \tparam T Type of the symbol, either R(Args...) or a pointer type.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename T, class Backend = backends::DefaultBackend>
+    class LazySymbol;
+
+    /**
+    ** \brief LazySymbol specialization for functions.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename R, typename... Args, class Backend>
+    class LazySymbol<R(Args...), Backend> {
+        public:
+            using pointer = R (*)(Args...);
+
+            constexpr LazySymbol(BasicLoader<Backend> const &loader, utils::ZStringView name) noexcept;
+            LazySymbol(LazySymbol const &) = delete;
+
+            LazySymbol &operator=(LazySymbol const &) = delete;
+
+            R operator()(Args... args) const;
+
+            [[nodiscard]]
+            pointer get() const;
+            bool resolve() const noexcept;
+            [[nodiscard]]
+            bool isResolved() const noexcept;
+            void reset() noexcept;
+        private:
+            pointer resolveSlow() const;
+
+            BasicLoader<Backend> const *_loader;
+            utils::ZStringView _name;
+            mutable std::atomic<pointer> _addr;
+    };
+
+    /**
+    ** \brief LazySymbol specialization for function pointers, which behaves
+    ** as the one for the function type they point to.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename R, typename... Args, class Backend>
+    class LazySymbol<R (*)(Args...), Backend> : public LazySymbol<R(Args...), Backend> {
+        public:
+            using LazySymbol<R(Args...), Backend>::LazySymbol;
+    };
+
+    /**
+    ** \brief LazySymbol specialization for data pointers.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename T, class Backend>
+    class LazySymbol<T *, Backend> {
+        public:
+            using pointer = T *;
+
+            constexpr LazySymbol(BasicLoader<Backend> const &loader, utils::ZStringView name) noexcept;
+            LazySymbol(LazySymbol const &) = delete;
+
+            LazySymbol &operator=(LazySymbol const &) = delete;
+
+            T &operator*() const;
+            T *operator->() const;
+
+            [[nodiscard]]
+            pointer get() const;
+            bool resolve() const noexcept;
+            [[nodiscard]]
+            bool isResolved() const noexcept;
+            void reset() noexcept;
+        private:
+            pointer resolveSlow() const;
+
+            BasicLoader<Backend> const *_loader;
+            utils::ZStringView _name;
+            mutable std::atomic<pointer> _addr;
+    };
+
+    /**
+    ** \brief Create an unresolved handle.
+    **
+    ** Nothing is looked up, so the loader may still be under construction,
+    ** as long as it's constructed before the first use of the handle.
+    **
+    ** \param loader Loader holding the symbol.
+    ** \param name Name of the symbol. The string must outlive the handle,
+    ** as a literal does.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename R, typename... Args, class Backend>
+    constexpr LazySymbol<R(Args...), Backend>::LazySymbol(BasicLoader<Backend> const &loader, utils::ZStringView name) noexcept
+    : _loader(&loader), _name(name), _addr(nullptr) {}
+
+    /**
+    ** \brief Call the function, resolving it first if needed.
+    **
+    ** \param args Arguments of the call.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return The value returned by the function.
+    **
+    ** \throw DLException<LoadSym> if the symbol can't be found.
+    ** \throw DLException<NullSym> if the symbol is null.
+    */
+    template <typename R, typename... Args, class Backend>
+    R LazySymbol<R(Args...), Backend>::operator()(Args... args) const {
+        return get()(std::forward<Args>(args)...);
+    }
+
+    /**
+    ** \brief Get the address of the function, resolving it first if needed.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return The address of the function, never nullptr.
+    **
+    ** \throw DLException<LoadSym> if the symbol can't be found.
+    ** \throw DLException<NullSym> if the symbol is null.
+    */
+    template <typename R, typename... Args, class Backend>
+    typename LazySymbol<R(Args...), Backend>::pointer LazySymbol<R(Args...), Backend>::get() const {
+        pointer fn = _addr.load(std::memory_order_acquire);
+
+        return fn != nullptr ? fn : resolveSlow();
+    }
+
+    /**
+    ** \brief Resolve the function now, without throwing.
+    **
+    ** Meant to check, or warm, handles ahead of their first call.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return true if the function is resolved.
+    */
+    template <typename R, typename... Args, class Backend>
+    bool LazySymbol<R(Args...), Backend>::resolve() const noexcept {
+        if (isResolved())
+            return true;
+
+        auto fn = _loader->template tryGetSymbol<pointer>(_name);
+
+        if (!fn || *fn == nullptr)
+            return false;
+
+        _addr.store(*fn, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    ** \brief Check whether the function was already resolved.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return true if the next use won't look the symbol up.
+    */
+    template <typename R, typename... Args, class Backend>
+    bool LazySymbol<R(Args...), Backend>::isResolved() const noexcept {
+        return _addr.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+    ** \brief Drop the resolved address, so the next use looks it up again.
+    **
+    ** \tparam R Return type of the function.
+    ** \tparam Args Types of the parameters of the function.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename R, typename... Args, class Backend>
+    void LazySymbol<R(Args...), Backend>::reset() noexcept {
+        _addr.store(nullptr, std::memory_order_release);
+    }
+
+    template <typename R, typename... Args, class Backend>
+    typename LazySymbol<R(Args...), Backend>::pointer LazySymbol<R(Args...), Backend>::resolveSlow() const {
+        pointer fn = _loader->template getSymbol<pointer>(_name);
+
+        if (fn == nullptr)
+            SymbolError(cde::Type::NullSym, _name, nullptr, _loader, &BasicLoader<Backend>::pathOf).raise();
+
+        _addr.store(fn, std::memory_order_release);
+        return fn;
+    }
+
+    /**
+    ** \brief Create an unresolved handle.
+    **
+    ** \param loader Loader holding the symbol.
+    ** \param name Name of the symbol. The string must outlive the handle,
+    ** as a literal does.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename T, class Backend>
+    constexpr LazySymbol<T *, Backend>::LazySymbol(BasicLoader<Backend> const &loader, utils::ZStringView name) noexcept
+    : _loader(&loader), _name(name), _addr(nullptr) {}
+
+    /**
+    ** \brief Access the object, resolving it first if needed.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return A reference on the object.
+    **
+    ** \throw DLException<LoadSym> if the symbol can't be found.
+    ** \throw DLException<NullSym> if the symbol is null.
+    */
+    template <typename T, class Backend>
+    T &LazySymbol<T *, Backend>::operator*() const {
+        return *get();
+    }
+
+    /**
+    ** \brief Access a member of the object, resolving it first if needed.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return The address of the object.
+    **
+    ** \throw DLException<LoadSym> if the symbol can't be found.
+    ** \throw DLException<NullSym> if the symbol is null.
+    */
+    template <typename T, class Backend>
+    T *LazySymbol<T *, Backend>::operator->() const {
+        return get();
+    }
+
+    /**
+    ** \brief Get the address of the object, resolving it first if needed.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return The address of the object, never nullptr.
+    **
+    ** \throw DLException<LoadSym> if the symbol can't be found.
+    ** \throw DLException<NullSym> if the symbol is null.
+    */
+    template <typename T, class Backend>
+    typename LazySymbol<T *, Backend>::pointer LazySymbol<T *, Backend>::get() const {
+        pointer ptr = _addr.load(std::memory_order_acquire);
+
+        return ptr != nullptr ? ptr : resolveSlow();
+    }
+
+    /**
+    ** \brief Resolve the object now, without throwing.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return true if the object is resolved.
+    */
+    template <typename T, class Backend>
+    bool LazySymbol<T *, Backend>::resolve() const noexcept {
+        if (isResolved())
+            return true;
+
+        auto ptr = _loader->template tryGetSymbol<pointer>(_name);
+
+        if (!ptr || *ptr == nullptr)
+            return false;
+
+        _addr.store(*ptr, std::memory_order_release);
+        return true;
+    }
+
+    /**
+    ** \brief Check whether the object was already resolved.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    **
+    ** \return true if the next use won't look the symbol up.
+    */
+    template <typename T, class Backend>
+    bool LazySymbol<T *, Backend>::isResolved() const noexcept {
+        return _addr.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+    ** \brief Drop the resolved address, so the next use looks it up again.
+    **
+    ** \tparam T Type of the object the symbol points to.
+    ** \tparam Backend Type of the backend of the loader.
+    */
+    template <typename T, class Backend>
+    void LazySymbol<T *, Backend>::reset() noexcept {
+        _addr.store(nullptr, std::memory_order_release);
+    }
+
+    template <typename T, class Backend>
+    typename LazySymbol<T *, Backend>::pointer LazySymbol<T *, Backend>::resolveSlow() const {
+        pointer ptr = _loader->template getSymbol<pointer>(_name);
+
+        if (ptr == nullptr)
+            SymbolError(cde::Type::NullSym, _name, nullptr, _loader, &BasicLoader<Backend>::pathOf).raise();
+
+        _addr.store(ptr, std::memory_order_release);
+        return ptr;
+    }
+}
+
+#endif
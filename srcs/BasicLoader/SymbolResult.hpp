@@ -0,0 +1,262 @@
+/**
+** \file BasicLoader/SymbolResult.hpp
+** Header for SymbolResult and SymbolError, the allocation free result of a
+** symbol lookup.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 16:25
+** \date Last update: 2026-10-16 23:05
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef BasicLoader_SymbolResult_hpp_
+#define BasicLoader_SymbolResult_hpp_
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "utils/sfinae.hpp"
+#include "exceptions/DLException.hpp"
+
+namespace clonixin::dynamicloader {
+    namespace cde = clonixin::dynamicloader::exceptions;
+
+    /**
+    ** \class SymbolError
+    ** \brief Description of a failed lookup, formatted on demand.
+    **
+    ** This class only stores an error code, and what is needed to build the
+    ** error message later: a view on the symbol name, an optional pointer on
+    ** the message reported by the backend, and a way to retrieve the path of
+    ** the library. Building a SymbolError never allocates. The message is
+    ** only formatted when getMessage() is called.
+    **
+    ** \warning A SymbolError refers to the name given to the lookup, and to
+    ** the loader that built it. It must not outlive any of them, nor be used
+    ** after the loader has been reset.
+    */
+    class SymbolError {
+        public:
+            /**
+            ** \brief Function returning the path of the library of a loader.
+            */
+            using PathFn = std::string (*)(void const *);
+
+            /**
+            ** \brief Create a new error.
+            **
+            ** \param type Kind of error.
+            ** \param name Name of the symbol.
+            ** \param detail Message reported by the backend, or nullptr.
+            ** \param loader Loader that failed, passed to path.
+            ** \param path Function returning the path of the library.
+            */
+            constexpr SymbolError(cde::Type type, std::string_view name, std::string const *detail, void const *loader, PathFn path) noexcept
+            : _type(type), _name(name), _detail(detail), _loader(loader), _path(path) {}
+
+            /**
+            ** \brief Get the kind of error.
+            **
+            ** \return LoadSym if the symbol could not be found, NullSym if it
+            ** was found, but is null and can't be dereferenced.
+            */
+            [[nodiscard]]
+            constexpr cde::Type getType() const noexcept { return _type; }
+
+            /**
+            ** \brief Get the name of the symbol.
+            **
+            ** \return A view on the name given to the lookup.
+            */
+            [[nodiscard]]
+            constexpr std::string_view getName() const noexcept { return _name; }
+
+            [[nodiscard]]
+            std::string getMessage() const;
+
+            [[noreturn]]
+            void raise() const;
+        private:
+            cde::Type _type;
+            std::string_view _name;
+            std::string const *_detail;
+            void const *_loader;
+            PathFn _path;
+    };
+
+    /**
+    ** \brief Format the error message.
+    **
+    ** If the backend reported a message, it's returned as-is. Otherwise,
+    ** a message is built from the path of the library and the name of the
+    ** symbol.
+    **
+    ** \return A human readable description of the error.
+    */
+    inline std::string SymbolError::getMessage() const {
+        if (_detail != nullptr && !_detail->empty())
+            return *_detail;
+
+        std::string msg = _path(_loader);
+
+        if (_type == cde::Type::NullSym)
+            return msg.append(": Symbol ").append(_name).append(" is NULL and cannot be casted.");
+
+        return msg.append(": undefined symbol: ").append(_name);
+    }
+
+    /**
+    ** \brief Throw the DLException matching this error.
+    **
+    ** \throw DLException<LoadSym> if the symbol could not be found.
+    ** \throw DLException<NullSym> if the symbol is null.
+    */
+    inline void SymbolError::raise() const {
+        if (_type == cde::Type::NullSym)
+            throw cde::DLException<cde::Type::NullSym>(std::string(_name), getMessage());
+
+        throw cde::DLException<cde::Type::LoadSym>(std::string(_name), getMessage());
+    }
+
+    /**
+    ** \class SymbolResult
+    ** \brief Either a symbol, or the reason it could not be retrieved.
+    **
+    ** This class is returned by BasicLoader::findSymbol. It holds the
+    ** address of the symbol, or a SymbolError, and never allocates.
+    **
+    ** The symbol is only cast to T when value() is called, following the
+    ** same semantics as BasicLoader::getSymbol: pointers are returned as-is,
+    ** references are bound to the symbol, movable types are moved from it,
+    ** and copyable types are copied.
+    **
+    ** \tparam T The type of the symbol, as it would be given to getSymbol.
+    */
+    template <typename T>
+    class SymbolResult {
+        static_assert(!iserror_v<T>, "Type is neither copyable nor movable. You should use a pointer instead.");
+
+        using storage_t = std::conditional_t<isptr_v<T>, T, std::remove_reference_t<T> *>;
+        public:
+            constexpr SymbolResult(storage_t sym) noexcept;
+            constexpr SymbolResult(SymbolError const &err) noexcept;
+
+            [[nodiscard]]
+            constexpr bool hasValue() const noexcept;
+            [[nodiscard]]
+            constexpr explicit operator bool() const noexcept;
+
+            [[nodiscard]]
+            T value() const;
+            [[nodiscard]]
+            storage_t address() const noexcept;
+
+            [[nodiscard]]
+            SymbolError const &error() const noexcept;
+        private:
+            bool _has_value;
+            union {
+                storage_t _sym;
+                SymbolError _err;
+            };
+    };
+
+    /**
+    ** \brief Create a successful result.
+    **
+    ** \param sym Address of the symbol.
+    **
+    ** \tparam T The type of the symbol.
+    */
+    template <typename T>
+    constexpr SymbolResult<T>::SymbolResult(storage_t sym) noexcept : _has_value(true), _sym(sym) {}
+
+    /**
+    ** \brief Create a failed result.
+    **
+    ** \param err Description of the error.
+    **
+    ** \tparam T The type of the symbol.
+    */
+    template <typename T>
+    constexpr SymbolResult<T>::SymbolResult(SymbolError const &err) noexcept : _has_value(false), _err(err) {}
+
+    /**
+    ** \brief Check whether the lookup succeeded.
+    **
+    ** \tparam T The type of the symbol.
+    **
+    ** \return true if the result holds a symbol.
+    */
+    template <typename T>
+    constexpr bool SymbolResult<T>::hasValue() const noexcept {
+        return _has_value;
+    }
+
+    /**
+    ** \brief Check whether the lookup succeeded.
+    **
+    ** \tparam T The type of the symbol.
+    **
+    ** \return true if the result holds a symbol.
+    */
+    template <typename T>
+    constexpr SymbolResult<T>::operator bool() const noexcept {
+        return _has_value;
+    }
+
+    /**
+    ** \brief Get the symbol.
+    **
+    ** \tparam T The type of the symbol.
+    **
+    ** \return The symbol, cast to T.
+    **
+    ** \throw DLException<LoadSym> if the symbol could not be found.
+    ** \throw DLException<NullSym> if the symbol is null, and T is not a pointer.
+    */
+    template <typename T>
+    T SymbolResult<T>::value() const {
+        if (!_has_value)
+            _err.raise();
+
+        if constexpr (isptr_v<T>)
+            return _sym;
+        else if constexpr (islref_v<T>)
+            return *_sym;
+        else if constexpr (ismovable_v<T>)
+            return std::move(*_sym);
+        else
+            return *_sym;
+    }
+
+    /**
+    ** \brief Get the address of the symbol.
+    **
+    ** \tparam T The type of the symbol.
+    **
+    ** \return The address of the symbol, or nullptr if the lookup failed.
+    */
+    template <typename T>
+    typename SymbolResult<T>::storage_t SymbolResult<T>::address() const noexcept {
+        return _has_value ? _sym : nullptr;
+    }
+
+    /**
+    ** \brief Get the error.
+    **
+    ** Must only be called on a failed result.
+    **
+    ** \tparam T The type of the symbol.
+    **
+    ** \return The description of the error.
+    */
+    template <typename T>
+    SymbolError const &SymbolResult<T>::error() const noexcept {
+        return _err;
+    }
+}
+
+#endif
@@ -0,0 +1,228 @@
+/**
+** \file BasicLoader/SymbolTable.hpp
+** Header for SymbolTable, the result of a batch symbol resolution.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 11:47
+** \date Last update: 2026-10-16 11:47
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef BasicLoader_SymbolTable_hpp_
+#define BasicLoader_SymbolTable_hpp_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/sfinae.hpp"
+
+namespace clonixin::dynamicloader {
+    /**
+    ** \class SymbolTable
+    ** \brief Contiguous table of resolved symbols.
+    **
+    ** This class is returned by BasicLoader::resolveSymbols. It holds the
+    ** address of every requested symbols, in the order they were requested,
+    ** in a contiguous array, along with a bitmap telling which one were
+    ** successfully resolved.
+    **
+    ** Symbols that could not be resolved have a null address, and are
+    ** reported, with the error returned by the backend, in getMissing().
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    class SymbolTable {
+        public:
+            /**
+            ** \brief Description of a symbol that could not be resolved.
+            */
+            struct Missing {
+                std::size_t index;
+                std::string name;
+                std::string error;
+            };
+
+            explicit SymbolTable(std::size_t count);
+
+            [[nodiscard]]
+            std::size_t size() const noexcept;
+            [[nodiscard]]
+            SymAddr const *data() const noexcept;
+            [[nodiscard]]
+            SymAddr operator[](std::size_t idx) const noexcept;
+
+            template <typename T>
+            [[nodiscard]]
+            ifptr_t<T> get(std::size_t idx) const noexcept;
+
+            [[nodiscard]]
+            bool isResolved(std::size_t idx) const noexcept;
+            [[nodiscard]]
+            std::uint64_t const *getStatus() const noexcept;
+            [[nodiscard]]
+            bool allResolved() const noexcept;
+            [[nodiscard]]
+            std::vector<Missing> const &getMissing() const noexcept;
+
+            void set(std::size_t idx, SymAddr sym) noexcept;
+            void setMissing(std::size_t idx, std::string name, std::string error);
+        private:
+            std::vector<SymAddr> _addrs;
+            std::vector<std::uint64_t> _status;
+            std::vector<Missing> _missing;
+    };
+
+    /**
+    ** \brief Create a table of count unresolved symbols.
+    **
+    ** \param count Number of symbols in the table.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    SymbolTable<SymAddr>::SymbolTable(std::size_t count)
+    : _addrs(count, nullptr), _status((count + 63) / 64, 0), _missing() {}
+
+    /**
+    ** \brief Get the number of symbols in the table.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return The number of requested symbols.
+    */
+    template <typename SymAddr>
+    std::size_t SymbolTable<SymAddr>::size() const noexcept {
+        return _addrs.size();
+    }
+
+    /**
+    ** \brief Get the address array.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return A pointer on the first element of the contiguous address array.
+    */
+    template <typename SymAddr>
+    SymAddr const *SymbolTable<SymAddr>::data() const noexcept {
+        return _addrs.data();
+    }
+
+    /**
+    ** \brief Get the address of a given symbol.
+    **
+    ** \param idx Index of the symbol, in the order it was requested.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return The address of the symbol, or nullptr if it could not be
+    ** resolved.
+    */
+    template <typename SymAddr>
+    SymAddr SymbolTable<SymAddr>::operator[](std::size_t idx) const noexcept {
+        return _addrs[idx];
+    }
+
+    /**
+    ** \brief Get the properly typed address of a given symbol.
+    **
+    ** \param idx Index of the symbol, in the order it was requested.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    ** \tparam T A type for which std::is_pointer_v<T> is true.
+    **
+    ** \return The address of the symbol, reinterpreted as T.
+    */
+    template <typename SymAddr>
+    template <typename T>
+    ifptr_t<T> SymbolTable<SymAddr>::get(std::size_t idx) const noexcept {
+        return reinterpret_cast<T>(_addrs[idx]);
+    }
+
+    /**
+    ** \brief Check whether a given symbol was resolved.
+    **
+    ** \param idx Index of the symbol, in the order it was requested.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return true if the backend found the symbol, false otherwise.
+    */
+    template <typename SymAddr>
+    bool SymbolTable<SymAddr>::isResolved(std::size_t idx) const noexcept {
+        return (_status[idx / 64] >> (idx % 64)) & 1;
+    }
+
+    /**
+    ** \brief Get the status bitmap.
+    **
+    ** Bit (idx % 64) of word (idx / 64) is set if the symbol at index idx
+    ** was resolved.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return A pointer on the first word of the bitmap.
+    */
+    template <typename SymAddr>
+    std::uint64_t const *SymbolTable<SymAddr>::getStatus() const noexcept {
+        return _status.data();
+    }
+
+    /**
+    ** \brief Check whether every symbols were resolved.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return true if no symbol is missing.
+    */
+    template <typename SymAddr>
+    bool SymbolTable<SymAddr>::allResolved() const noexcept {
+        return _missing.empty();
+    }
+
+    /**
+    ** \brief Get the symbols that could not be resolved.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return A vector describing every missing symbols, sorted by index.
+    */
+    template <typename SymAddr>
+    std::vector<typename SymbolTable<SymAddr>::Missing> const &SymbolTable<SymAddr>::getMissing() const noexcept {
+        return _missing;
+    }
+
+    /**
+    ** \brief Mark a symbol as resolved.
+    **
+    ** \param idx Index of the symbol.
+    ** \param sym Address of the symbol.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    void SymbolTable<SymAddr>::set(std::size_t idx, SymAddr sym) noexcept {
+        _addrs[idx] = sym;
+        _status[idx / 64] |= std::uint64_t(1) << (idx % 64);
+    }
+
+    /**
+    ** \brief Mark a symbol as missing.
+    **
+    ** Symbols must be marked missing in increasing index order.
+    **
+    ** \param idx Index of the symbol.
+    ** \param name Name of the symbol.
+    ** \param error Error reported by the backend.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    void SymbolTable<SymAddr>::setMissing(std::size_t idx, std::string name, std::string error) {
+        _addrs[idx] = nullptr;
+        _missing.push_back({idx, std::move(name), std::move(error)});
+    }
+}
+
+#endif
@@ -0,0 +1,435 @@
+/**
+** \file HotReloader/HotReloader.hpp
+** Header for HotReloader, reloading a library whenever its file is
+** replaced.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 18:40
+** \date Last update: 2026-10-16 23:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef HotReloader_HotReloader_hpp_
+#define HotReloader_HotReloader_hpp_
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "utils/Epoch.hpp"
+#include "utils/sfinae.hpp"
+#include "BasicLoader/BasicLoader.hpp"
+#include "BasicLoader/SymbolTable.hpp"
+#include "backends/backends.hpp"
+#include "backends/linux/ProcPath.hpp"
+#include "exceptions/exceptions.hpp"
+
+namespace clonixin::dynamicloader {
+    namespace cde = clonixin::dynamicloader::exceptions;
+
+    namespace _internals {
+        /**
+        ** \brief Owned file descriptor, closed on destruction.
+        */
+        struct FileDescriptor {
+            explicit FileDescriptor(int fd) noexcept : fd(fd) {}
+            FileDescriptor(FileDescriptor const &) = delete;
+            ~FileDescriptor() { ::close(fd); }
+
+            FileDescriptor &operator=(FileDescriptor const &) = delete;
+
+            int fd;
+        };
+    }
+
+    /**
+    ** \class HotReloader
+    ** \brief Library reloaded in the background whenever its file is
+    ** replaced.
+    **
+    ** A HotReloader owns a Generation: a loader on the library, and the
+    ** table of the symbols bound at construction. A background thread
+    ** watches the directory of the library with inotify. When the file is
+    ** replaced, a new Generation is built on that thread: the library is
+    ** opened, and every bound symbol is resolved again. If that succeeds,
+    ** the new Generation is published by a single atomic pointer store.
+    ** Otherwise, the current one is kept, and the error is available
+    ** through getLastError().
+    **
+    ** Readers only do an atomic load to get the current Generation, and
+    ** never take any lock. A Generation is immutable once published, so a
+    ** reader never sees a half-updated table. Replaced Generations are
+    ** retired through utils::Epoch, and closed once no thread that was
+    ** pinned when they were replaced is still pinned.
+    **
+    ** Readers must thus pin the epoch, for instance with a
+    ** utils::EpochGuard, before getting the current Generation or a bound
+    ** symbol, and keep it pinned for as long as they use them, including
+    ** while running the code of the library:
+    **
+    **     {
+    **         utils::EpochGuard guard;
+    **         reloader.get<void (*)(int)>(0)(42);
+    **     }
+    **
+    ** A Generation or symbol obtained without pinning may be closed at any
+    ** time by a reload.
+    **
+    ** The dynamic linker returns the already loaded object when a path is
+    ** opened again, even if the file changed. Each Generation thus opens
+    ** the library through a /proc/self/fd path no other load used, which
+    ** identifies the new file, even while a replaced Generation is still
+    ** loaded because a reader is pinned. The file must be replaced by a
+    ** new one, for instance through rename(), as install(1) does, rather
+    ** than rewritten in place. Libraries that can't be unloaded, such as
+    ** the ones opened with RTLD_NODELETE, should not be hot reloaded.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    */
+    template <class Backend = backends::DefaultBackend>
+    class HotReloader {
+        public:
+            using SymAddr = typename Backend::SymAddr;
+
+            /**
+            ** \brief An opened version of the library, and its bound symbols.
+            */
+            struct Generation {
+                Generation(BasicLoader<Backend> &&loader, SymbolTable<SymAddr> &&table, std::uint64_t number) noexcept;
+
+                BasicLoader<Backend> loader;
+                SymbolTable<SymAddr> table;
+                std::uint64_t number;
+            };
+
+            template <typename... Args>
+            HotReloader(std::string const &path, std::vector<std::string> symbols, Args &&... args);
+            HotReloader(HotReloader const &) = delete;
+            ~HotReloader();
+
+            HotReloader &operator=(HotReloader const &) = delete;
+
+            [[nodiscard]]
+            Generation const &current() const noexcept;
+
+            template <typename T>
+            [[nodiscard]]
+            ifptr_t<T> get(std::size_t idx) const noexcept;
+
+            [[nodiscard]]
+            std::uint64_t getGeneration() const noexcept;
+            [[nodiscard]]
+            std::string getLastError() const;
+            [[nodiscard]]
+            std::string const &getPath() const noexcept;
+
+            bool reload();
+        private:
+            using Factory = std::function<BasicLoader<Backend> (std::string const &)>;
+
+            std::unique_ptr<Generation> build(std::uint64_t number);
+            void watch();
+
+            static void release(void *generation) noexcept;
+
+        private:
+            std::string _path;
+            std::vector<std::string> _symbols;
+            Factory _factory;
+
+            std::atomic<Generation const *> _current;
+
+            mutable std::mutex _reload_lock;
+            std::string _last_error;
+
+            int _inotify;
+            int _stop;
+            std::thread _watcher;
+    };
+
+    /**
+    ** \brief Wrap an opened version of the library.
+    **
+    ** \param loader Loader on the library.
+    ** \param table Bound symbols.
+    ** \param number Number of the Generation, starting from 0.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    */
+    template <class Backend>
+    HotReloader<Backend>::Generation::Generation(BasicLoader<Backend> &&loader, SymbolTable<SymAddr> &&table, std::uint64_t number) noexcept
+    : loader(std::move(loader)), table(std::move(table)), number(number) {}
+
+    /**
+    ** \brief Open a library, bind its symbols, and start watching it.
+    **
+    ** \param path Path of the library.
+    ** \param symbols Names of the symbols to bind. They must all be found,
+    ** in the first version as in the following ones.
+    ** \param args Extra arguments given to the backend, on every reload.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    ** \tparam Args Types of the extra arguments.
+    **
+    ** \throw DLException<Open> if the library can't be opened, or watched.
+    ** \throw DLException<LoadSym> if a bound symbol is missing.
+    */
+    template <class Backend>
+    template <typename... Args>
+    HotReloader<Backend>::HotReloader(std::string const &path, std::vector<std::string> symbols, Args &&... args)
+    : _path(path), _symbols(std::move(symbols)), _current(nullptr), _inotify(-1), _stop(-1) {
+        _factory = [params = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)](std::string const &p) {
+            return std::apply([&p](auto const &... a) { return BasicLoader<Backend>(p, a...); }, params);
+        };
+
+        std::unique_ptr<Generation> first = build(0);
+        std::string dir = _path.substr(0, _path.find_last_of('/') + 1);
+
+        _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        _stop = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (_inotify < 0 || _stop < 0
+                || inotify_add_watch(_inotify, dir.empty() ? "." : dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            std::string error = std::strerror(errno);
+
+            if (_inotify >= 0)
+                ::close(_inotify);
+            if (_stop >= 0)
+                ::close(_stop);
+            throw cde::DLException<cde::Type::Open>(_path, error);
+        }
+
+        _current.store(first.release(), std::memory_order_release);
+        _watcher = std::thread(&HotReloader::watch, this);
+    }
+
+    /**
+    ** \brief Stop watching, and retire the current Generation.
+    **
+    ** Generations still used by pinned threads are closed once they unpin.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    */
+    template <class Backend>
+    HotReloader<Backend>::~HotReloader() {
+        std::uint64_t one = 1;
+
+        (void)!::write(_stop, &one, sizeof(one));
+        _watcher.join();
+
+        ::close(_inotify);
+        ::close(_stop);
+
+        utils::Epoch::retire(&release, const_cast<Generation *>(_current.load(std::memory_order_acquire)));
+    }
+
+    /**
+    ** \brief Get the current Generation.
+    **
+    ** This function never blocks. The Generation stays valid, even if a
+    ** newer one is published, as long as the calling thread keeps the
+    ** epoch pinned, from before this call.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return The last successfully loaded Generation.
+    */
+    template <class Backend>
+    typename HotReloader<Backend>::Generation const &HotReloader<Backend>::current() const noexcept {
+        return *_current.load(std::memory_order_acquire);
+    }
+
+    /**
+    ** \brief Get a bound symbol from the current Generation.
+    **
+    ** The symbol stays valid as long as the calling thread keeps the epoch
+    ** pinned, from before this call.
+    **
+    ** \param idx Index of the symbol, in the order given to the constructor.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    ** \tparam T A pointer type.
+    **
+    ** \return The address of the symbol, reinterpreted as T.
+    */
+    template <class Backend>
+    template <typename T>
+    ifptr_t<T> HotReloader<Backend>::get(std::size_t idx) const noexcept {
+        return current().table.template get<T>(idx);
+    }
+
+    /**
+    ** \brief Get the number of the current Generation.
+    **
+    ** The epoch is pinned while reading it, so that it may be called
+    ** without pinning.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return 0 for the first version, incremented by each reload.
+    */
+    template <class Backend>
+    std::uint64_t HotReloader<Backend>::getGeneration() const noexcept {
+        utils::EpochGuard guard;
+
+        return current().number;
+    }
+
+    /**
+    ** \brief Get the error of the last failed reload.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return The message of the exception thrown by the last failed
+    ** reload, or an empty string if the last reload succeeded.
+    */
+    template <class Backend>
+    std::string HotReloader<Backend>::getLastError() const {
+        std::lock_guard<std::mutex> lock(_reload_lock);
+
+        return _last_error;
+    }
+
+    /**
+    ** \brief Get the path of the watched library.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return The path given to the constructor.
+    */
+    template <class Backend>
+    std::string const &HotReloader<Backend>::getPath() const noexcept {
+        return _path;
+    }
+
+    /**
+    ** \brief Build a new Generation from the current file, and publish it.
+    **
+    ** This is what the watcher thread calls when the file is replaced. It
+    ** may also be called directly, from any thread. The replaced
+    ** Generation is retired, and closed once no thread pinned before the
+    ** new one was published is still pinned.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return true if the new Generation was published. On failure, the
+    ** current Generation is kept, and the error is available through
+    ** getLastError().
+    */
+    template <class Backend>
+    bool HotReloader<Backend>::reload() {
+        std::lock_guard<std::mutex> lock(_reload_lock);
+        Generation const *old = _current.load(std::memory_order_relaxed);
+
+        try {
+            std::unique_ptr<Generation> next = build(old->number + 1);
+
+            _current.store(next.release(), std::memory_order_release);
+            _last_error.clear();
+        } catch (std::exception const &e) {
+            _last_error = e.what();
+            return false;
+        }
+
+        utils::Epoch::retire(&release, const_cast<Generation *>(old));
+        return true;
+    }
+
+    /**
+    ** \brief Open the library through a new descriptor, and bind its
+    ** symbols.
+    **
+    ** The descriptor is closed once the library is mapped. Its number may
+    ** then be reused by the next Generation, which is why the path is
+    ** spelled differently on every load.
+    **
+    ** \param number Number of the new Generation.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return The new Generation.
+    **
+    ** \throw DLException<Open> if the library can't be opened.
+    ** \throw DLException<LoadSym> if a bound symbol is missing.
+    */
+    template <class Backend>
+    std::unique_ptr<typename HotReloader<Backend>::Generation> HotReloader<Backend>::build(std::uint64_t number) {
+        int fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0)
+            throw cde::DLException<cde::Type::Open>(_path, std::strerror(errno));
+
+        _internals::FileDescriptor file(fd);
+        BasicLoader<Backend> loader = _factory(backends::_linux::procPath(file.fd));
+        SymbolTable<SymAddr> table = loader.getSymbols(_symbols);
+
+        return std::make_unique<Generation>(std::move(loader), std::move(table), number);
+    }
+
+    /**
+    ** \brief Close a retired Generation, once no reader can still use it.
+    **
+    ** \param generation The Generation, as given to utils::Epoch::retire().
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    */
+    template <class Backend>
+    void HotReloader<Backend>::release(void *generation) noexcept {
+        delete static_cast<Generation *>(generation);
+    }
+
+    /**
+    ** \brief Watcher thread: reload the library whenever a file with its
+    ** name is written or moved in its directory.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    */
+    template <class Backend>
+    void HotReloader<Backend>::watch() {
+        std::string name = _path.substr(_path.find_last_of('/') + 1);
+        alignas(struct inotify_event) char buffer[4096];
+        struct pollfd fds[2] = {{_inotify, POLLIN, 0}, {_stop, POLLIN, 0}};
+
+        for (;;) {
+            if (poll(fds, 2, -1) < 0 && errno != EINTR)
+                return;
+            if (fds[1].revents != 0)
+                return;
+            if (fds[0].revents == 0)
+                continue;
+
+            bool changed = false;
+            ssize_t len;
+
+            while ((len = ::read(_inotify, buffer, sizeof(buffer))) > 0) {
+                for (char *ptr = buffer; ptr < buffer + len;) {
+                    auto const *event = reinterpret_cast<struct inotify_event const *>(ptr);
+
+                    changed = changed || (event->len > 0 && name == event->name);
+                    ptr += sizeof(struct inotify_event) + event->len;
+                }
+            }
+
+            if (changed)
+                (void)reload();
+        }
+    }
+}
+
+#endif
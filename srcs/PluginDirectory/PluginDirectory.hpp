@@ -0,0 +1,207 @@
+/**
+** \file PluginDirectory/PluginDirectory.hpp
+** Header for PluginDirectory, scanning a directory for loadable plugins.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 18:10
+** \date Last update: 2026-10-16 18:10
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef PluginDirectory_PluginDirectory_hpp_
+#define PluginDirectory_PluginDirectory_hpp_
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "BasicLoader/AsyncOpener.hpp"
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/backends.hpp"
+#include "backends/linux/ElfFile.hpp"
+#include "exceptions/exceptions.hpp"
+
+namespace clonixin::dynamicloader {
+    namespace cde = clonixin::dynamicloader::exceptions;
+
+    /**
+    ** \class PluginDirectory
+    ** \brief Set of plugins found in a directory, checked before loading.
+    **
+    ** The constructor lists the regular files of a directory, and checks
+    ** each of them with an ElfFile: it must be a shared object built for
+    ** the running process, and export every required symbol. This only
+    ** reads a few pages of each file, so a foreign or broken file is
+    ** skipped without any dlopen, nor any exception.
+    **
+    ** The accepted plugins can then be loaded concurrently, through an
+    ** AsyncOpener.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    */
+    template <class Backend = backends::DefaultBackend>
+    class PluginDirectory {
+        public:
+            using Status = backends::_linux::ElfFile::Status;
+
+            /**
+            ** \brief A file that was not accepted, and why.
+            */
+            struct Rejected {
+                std::string path;
+                Status status;
+                std::string reason;
+            };
+
+            explicit PluginDirectory(std::string const &dir, std::vector<std::string> required = {});
+
+            [[nodiscard]]
+            std::vector<std::string> const &getAccepted() const noexcept;
+            [[nodiscard]]
+            std::vector<Rejected> const &getRejected() const noexcept;
+
+            template <typename... Args>
+            [[nodiscard]]
+            std::vector<PendingLoader<Backend>> load(AsyncOpener &opener, int priority, Args &&... args) const;
+
+            template <typename... Args>
+            [[nodiscard]]
+            std::vector<BasicLoader<Backend>> loadAll(Args &&... args) const;
+        private:
+            std::vector<std::string> _accepted;
+            std::vector<Rejected> _rejected;
+    };
+
+    /**
+    ** \brief Scan a directory.
+    **
+    ** Files are checked in name order. Subdirectories are not searched.
+    **
+    ** \param dir Path of the directory.
+    ** \param required Names every plugin must export.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \throw DLException<Open> if the directory can't be listed.
+    */
+    template <class Backend>
+    PluginDirectory<Backend>::PluginDirectory(std::string const &dir, std::vector<std::string> required) {
+        namespace fs = std::filesystem;
+
+        std::error_code ec;
+        std::vector<std::string> paths;
+
+        for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec))
+            if (it->is_regular_file(ec))
+                paths.push_back(it->path().string());
+
+        if (ec)
+            throw cde::DLException<cde::Type::Open>(dir, ec.message());
+
+        std::sort(paths.begin(), paths.end());
+
+        for (auto &path : paths) {
+            backends::_linux::ElfFile file(path);
+
+            if (!file.isValid()) {
+                _rejected.push_back({std::move(path), file.getStatus(), backends::_linux::ElfFile::describe(file.getStatus())});
+                continue;
+            }
+
+            auto missing = std::find_if(required.begin(), required.end(),
+                [&file](std::string const &name) { return !file.exports(name); });
+
+            if (missing != required.end())
+                _rejected.push_back({std::move(path), Status::Ok, "Missing required symbol: " + *missing});
+            else
+                _accepted.push_back(std::move(path));
+        }
+    }
+
+    /**
+    ** \brief Get the plugins that passed every check.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return The paths of the accepted plugins, in name order.
+    */
+    template <class Backend>
+    std::vector<std::string> const &PluginDirectory<Backend>::getAccepted() const noexcept {
+        return _accepted;
+    }
+
+    /**
+    ** \brief Get the files that were skipped.
+    **
+    ** A rejected file with an Ok status is a valid shared object missing
+    ** one of the required symbols.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    **
+    ** \return The rejected files, in name order.
+    */
+    template <class Backend>
+    std::vector<typename PluginDirectory<Backend>::Rejected> const &PluginDirectory<Backend>::getRejected() const noexcept {
+        return _rejected;
+    }
+
+    /**
+    ** \brief Queue the opening of every accepted plugin.
+    **
+    ** \param opener AsyncOpener running the openings.
+    ** \param priority Priority of the openings.
+    ** \param args Extra arguments given to every backend.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    ** \tparam Args Types of the extra arguments.
+    **
+    ** \return One PendingLoader per accepted plugin, in the same order as
+    ** getAccepted().
+    */
+    template <class Backend>
+    template <typename... Args>
+    std::vector<PendingLoader<Backend>> PluginDirectory<Backend>::load(AsyncOpener &opener, int priority, Args &&... args) const {
+        std::vector<PendingLoader<Backend>> pending;
+
+        pending.reserve(_accepted.size());
+        for (auto const &path : _accepted)
+            pending.push_back(opener.template open<Backend>(path, priority, args...));
+
+        return pending;
+    }
+
+    /**
+    ** \brief Open every accepted plugin, and wait for all of them.
+    **
+    ** The openings run on a temporary AsyncOpener, with one worker per
+    ** hardware thread.
+    **
+    ** \param args Extra arguments given to every backend.
+    **
+    ** \tparam Backend Type of the backend of the loaders.
+    ** \tparam Args Types of the extra arguments.
+    **
+    ** \return The loaders, in the same order as getAccepted().
+    **
+    ** \throw DLException<Open> if a plugin fails to open anyway, for
+    ** instance because one of its dependencies is missing.
+    */
+    template <class Backend>
+    template <typename... Args>
+    std::vector<BasicLoader<Backend>> PluginDirectory<Backend>::loadAll(Args &&... args) const {
+        AsyncOpener opener;
+        std::vector<PendingLoader<Backend>> pending = load(opener, 0, std::forward<Args>(args)...);
+        std::vector<BasicLoader<Backend>> loaders;
+
+        loaders.reserve(pending.size());
+        for (auto &p : pending)
+            loaders.push_back(p.get());
+
+        return loaders;
+    }
+}
+
+#endif
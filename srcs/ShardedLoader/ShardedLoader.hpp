@@ -0,0 +1,378 @@
+/**
+** \file ShardedLoader/ShardedLoader.hpp
+** Header for ShardedLoader, loading independent copies of a library, one
+** per shard, and leasing one of them to each thread.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 22:30
+** \date Last update: 2026-10-16 23:45
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef ShardedLoader_ShardedLoader_hpp_
+#define ShardedLoader_ShardedLoader_hpp_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "utils/ZStringView.hpp"
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/backends.hpp"
+
+namespace clonixin::dynamicloader {
+    namespace _internals {
+        /**
+        ** \brief Shards of a ShardedLoader not leased to any thread.
+        **
+        ** Once every shard is leased, threads are given shared shards, in
+        ** turn. Those are never put back in the free list.
+        */
+        class ShardPool {
+            public:
+                explicit ShardPool(std::size_t size) : _size(size), _next(0) {
+                    _free.reserve(size);
+                    for (std::size_t i = size; i-- > 0;)
+                        _free.push_back(i);
+                }
+
+                std::size_t acquire(bool &exclusive) noexcept {
+                    std::lock_guard<std::mutex> lock(_lock);
+
+                    exclusive = !_free.empty();
+                    if (!exclusive)
+                        return _next++ % _size;
+
+                    std::size_t idx = _free.back();
+
+                    _free.pop_back();
+                    return idx;
+                }
+
+                void release(std::size_t idx) noexcept {
+                    std::lock_guard<std::mutex> lock(_lock);
+
+                    _free.push_back(idx);
+                }
+
+            private:
+                std::size_t _size;
+                std::size_t _next;
+                std::mutex _lock;
+                std::vector<std::size_t> _free;
+        };
+
+        /**
+        ** \brief Shards leased by the calling thread, one per ShardPool,
+        ** given back when the thread exits.
+        **
+        ** The pools are only referenced weakly, so that a ShardedLoader may
+        ** be destroyed while threads still hold its shards.
+        */
+        class ShardLeases {
+            public:
+                ShardLeases(ShardLeases const &) = delete;
+                ~ShardLeases() {
+                    for (Lease const &lease : _leases) {
+                        std::shared_ptr<ShardPool> pool = lease.pool.lock();
+
+                        if (pool != nullptr && lease.exclusive)
+                            pool->release(lease.idx);
+                    }
+                }
+
+                ShardLeases &operator=(ShardLeases const &) = delete;
+
+                /**
+                ** \brief Get the shard of a pool leased by the calling
+                ** thread, leasing one on the first call.
+                **
+                ** A lease whose pool was destroyed is dropped, as another
+                ** pool may since have been allocated at the same address.
+                */
+                static std::size_t get(std::shared_ptr<ShardPool> const &pool) noexcept {
+                    thread_local ShardLeases leases;
+                    std::vector<Lease> &held = leases._leases;
+                    bool exclusive;
+
+                    for (auto lease = held.begin(); lease != held.end();) {
+                        if (lease->pool.expired())
+                            lease = held.erase(lease);
+                        else if (lease->key == pool.get())
+                            return lease->idx;
+                        else
+                            ++lease;
+                    }
+
+                    try {
+                        held.reserve(held.size() + 1);
+                    } catch (...) {
+                        std::size_t idx = pool->acquire(exclusive);
+
+                        if (exclusive)
+                            pool->release(idx);
+                        return idx;
+                    }
+
+                    std::size_t idx = pool->acquire(exclusive);
+
+                    held.push_back({pool, pool.get(), idx, exclusive});
+                    return idx;
+                }
+
+            private:
+                struct Lease {
+                    std::weak_ptr<ShardPool> pool;
+                    ShardPool const *key;
+                    std::size_t idx;
+                    bool exclusive;
+                };
+
+                ShardLeases() = default;
+
+                std::vector<Lease> _leases;
+        };
+    }
+
+    /**
+    ** \class ShardedLoader
+    ** \brief Independent copies of a library, for libraries keeping global
+    ** state that isn't thread safe.
+    **
+    ** Instead of serializing every thread on a single copy of such a
+    ** library, the library is opened once per shard, each time in its own
+    ** link-map namespace, so that every shard has its own globals. The
+    ** default backend opens each shard with LinuxScopedBackend::NewScope;
+    ** a NamespacePool can be given instead, to stay under the glibc limit
+    ** on namespaces.
+    **
+    ** A thread leases a free shard the first time it uses the loader, and
+    ** gives it back when it exits, so that as long as no more threads use
+    ** the library at the same time than there are shards, each of them has
+    ** its own copy, however many threads came and went before. local() and
+    ** getSymbol() use the shard of the calling thread, while shard() and
+    ** getSymbols() reach any of them.
+    **
+    ** Once every shard is leased, the next threads are given shards that
+    ** are already in use, in turn, for their whole lifetime. Threads
+    ** sharing a shard must still serialize: run() calls a function with
+    ** the loader of the calling thread's shard, under a lock of that shard
+    ** only, which is never contended while each thread has its own shard.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    */
+    template <class Backend = backends::ScopedBackend>
+    class ShardedLoader {
+        public:
+            using Loader = BasicLoader<Backend>;
+
+            template <typename... Args>
+            ShardedLoader(std::string const &path, std::size_t shards, Args &&... args);
+            ShardedLoader(ShardedLoader const &) = delete;
+            ShardedLoader(ShardedLoader &&) noexcept = default;
+
+            ShardedLoader &operator=(ShardedLoader const &) = delete;
+            ShardedLoader &operator=(ShardedLoader &&) noexcept = default;
+
+            [[nodiscard]]
+            std::size_t size() const noexcept;
+            [[nodiscard]]
+            std::size_t localIndex() const noexcept;
+
+            [[nodiscard]]
+            Loader const &shard(std::size_t i) const noexcept;
+            [[nodiscard]]
+            Loader const &local() const noexcept;
+
+            template <typename T>
+            [[nodiscard]]
+            decltype(auto) getSymbol(utils::ZStringView name) const;
+            template <typename T>
+            [[nodiscard]]
+            decltype(auto) getSymbol(std::size_t i, utils::ZStringView name) const;
+            template <typename T>
+            [[nodiscard]]
+            auto getSymbols(utils::ZStringView name) const;
+
+            template <typename F>
+            decltype(auto) run(F &&f) const;
+        private:
+            /**
+            ** \brief A copy of the library, on its own cache lines, so that
+            ** locking a shard never slows down the others.
+            */
+            struct alignas(64) Shard {
+                template <typename... Args>
+                Shard(std::string const &path, Args &... args) : loader(path, args...) {}
+
+                Loader loader;
+                mutable std::mutex lock;
+            };
+
+            std::vector<std::unique_ptr<Shard>> _shards;
+            std::shared_ptr<_internals::ShardPool> _pool;
+    };
+
+    /**
+    ** \brief Open the shards.
+    **
+    ** The same arguments are given to the backend of every shard. There is
+    ** always at least one shard.
+    **
+    ** \param path Path of the library.
+    ** \param shards Number of copies of the library to open.
+    ** \param args Arguments of the backends, after the path.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    **
+    ** \throw DLException<Open> if a copy can't be opened. The copies
+    ** opened so far are closed.
+    */
+    template <class Backend>
+    template <typename... Args>
+    ShardedLoader<Backend>::ShardedLoader(std::string const &path, std::size_t shards, Args &&... args) {
+        shards = std::max<std::size_t>(shards, 1);
+        _shards.reserve(shards);
+
+        for (std::size_t i = 0; i < shards; ++i)
+            _shards.push_back(std::make_unique<Shard>(path, args...));
+        _pool = std::make_shared<_internals::ShardPool>(shards);
+    }
+
+    /**
+    ** \brief Get the number of shards.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    */
+    template <class Backend>
+    std::size_t ShardedLoader<Backend>::size() const noexcept {
+        return _shards.size();
+    }
+
+    /**
+    ** \brief Get the shard leased by the calling thread.
+    **
+    ** On its first call, the thread leases a free shard, or a shared one
+    ** if none is free, which it keeps until it exits.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    */
+    template <class Backend>
+    std::size_t ShardedLoader<Backend>::localIndex() const noexcept {
+        return _internals::ShardLeases::get(_pool);
+    }
+
+    /**
+    ** \brief Get the loader of a shard.
+    **
+    ** \param i Index of the shard, lower than size().
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    */
+    template <class Backend>
+    typename ShardedLoader<Backend>::Loader const &ShardedLoader<Backend>::shard(std::size_t i) const noexcept {
+        return _shards[i]->loader;
+    }
+
+    /**
+    ** \brief Get the loader of the calling thread's shard.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    */
+    template <class Backend>
+    typename ShardedLoader<Backend>::Loader const &ShardedLoader<Backend>::local() const noexcept {
+        return shard(localIndex());
+    }
+
+    /**
+    ** \brief Get a symbol from the calling thread's shard.
+    **
+    ** \param name Name of the symbol.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    ** \tparam T Type of the symbol, as for BasicLoader::getSymbol().
+    **
+    ** \throw As BasicLoader::getSymbol().
+    */
+    template <class Backend>
+    template <typename T>
+    decltype(auto) ShardedLoader<Backend>::getSymbol(utils::ZStringView name) const {
+        return local().template getSymbol<T>(name);
+    }
+
+    /**
+    ** \brief Get a symbol from a given shard.
+    **
+    ** \param i Index of the shard, lower than size().
+    ** \param name Name of the symbol.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    ** \tparam T Type of the symbol, as for BasicLoader::getSymbol().
+    **
+    ** \throw As BasicLoader::getSymbol().
+    */
+    template <class Backend>
+    template <typename T>
+    decltype(auto) ShardedLoader<Backend>::getSymbol(std::size_t i, utils::ZStringView name) const {
+        return shard(i).template getSymbol<T>(name);
+    }
+
+    /**
+    ** \brief Get a symbol from every shard.
+    **
+    ** Symbols returned by reference are wrapped in a
+    ** std::reference_wrapper.
+    **
+    ** \param name Name of the symbol.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    ** \tparam T Type of the symbol, as for BasicLoader::getSymbol().
+    **
+    ** \return The symbols, in shard order.
+    **
+    ** \throw As BasicLoader::getSymbol().
+    */
+    template <class Backend>
+    template <typename T>
+    auto ShardedLoader<Backend>::getSymbols(utils::ZStringView name) const {
+        using Symbol = decltype(shard(0).template getSymbol<T>(name));
+        using Stored = std::conditional_t<std::is_lvalue_reference_v<Symbol>,
+              std::reference_wrapper<std::remove_reference_t<Symbol>>, Symbol>;
+
+        std::vector<Stored> symbols;
+
+        symbols.reserve(_shards.size());
+        for (auto const &s : _shards)
+            symbols.push_back(s->loader.template getSymbol<T>(name));
+
+        return symbols;
+    }
+
+    /**
+    ** \brief Call a function with the calling thread's shard, under the
+    ** lock of that shard.
+    **
+    ** \param f Function called with the Loader const & of the shard.
+    **
+    ** \tparam Backend Type of the backend of the shards.
+    ** \tparam F Type of the function.
+    **
+    ** \return What f returned.
+    */
+    template <class Backend>
+    template <typename F>
+    decltype(auto) ShardedLoader<Backend>::run(F &&f) const {
+        Shard const &s = *_shards[localIndex()];
+        std::lock_guard<std::mutex> lock(s.lock);
+
+        return std::forward<F>(f)(s.loader);
+    }
+}
+
+#endif
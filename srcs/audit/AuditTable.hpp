@@ -0,0 +1,107 @@
+/**
+** \file audit/AuditTable.hpp
+** Header defining the table shared by the rtld_audit library and the
+** process it audits.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:50
+** \date Last update: 2026-10-16 23:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef audit_AuditTable_hpp_
+#define audit_AuditTable_hpp_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace clonixin::dynamicloader::audit {
+    constexpr std::uint32_t table_version = 1;
+    constexpr std::size_t max_objects = 512;
+    constexpr std::size_t object_name_size = 128;
+
+    /**
+    ** \brief Name of the function the audit library binds in place of the
+    ** stub defined by the dynamicloader library.
+    */
+    constexpr char const hook_name[] = "dynamicloader_rtld_audit";
+
+    /**
+    ** \brief Requests made to the audit library, through the hook.
+    **
+    ** Table only returns the table. Opening tells the audit library that
+    ** the calling thread is about to call dlopen(), and Opened that its
+    ** last dlopen() returned.
+    */
+    enum class HookOp : int {
+        Table, Opened, Opening
+    };
+
+    using Hook = void *(*)(int op);
+
+    /**
+    ** \brief Where an object is in its life.
+    */
+    enum class ObjectState : std::uint32_t {
+        Loading, Loaded, Closed
+    };
+
+    /**
+    ** \struct ObjectRecord
+    ** \brief What the audit library measured about a loaded object.
+    **
+    ** Everything but the atomics and consistent_ns is written before the
+    ** record is published, and never changes afterward. consistent_ns is
+    ** private to the audit library.
+    **
+    ** \var ObjectRecord::name
+    ** End of the path the object was loaded from. Empty for the executable.
+    ** \var ObjectRecord::root
+    ** Index of the first object mapped by the same load. It holds the
+    ** setup time of the whole load.
+    ** \var ObjectRecord::plt_slots
+    ** Number of PLT relocations of the object.
+    ** \var ObjectRecord::map_ns
+    ** Time spent finding and mapping the object. For the root of a load,
+    ** it is only known when the load was started through one of the linux
+    ** backends, and zero otherwise.
+    ** \var ObjectRecord::setup_ns
+    ** Time spent relocating and initializing every object of the load.
+    ** Zero on objects that aren't a root, and when unknown.
+    ** \var ObjectRecord::load_binds
+    ** PLT bindings resolved while the object was being loaded.
+    ** \var ObjectRecord::lazy_binds
+    ** PLT bindings resolved afterward, on first call.
+    */
+    struct ObjectRecord {
+        char name[object_name_size];
+        std::int64_t lmid;
+        std::uint32_t tid;
+        std::uint32_t root;
+        std::uint64_t plt_slots;
+        std::uint64_t map_ns;
+        std::uint64_t consistent_ns;
+        std::atomic<std::uint64_t> setup_ns;
+        std::atomic<std::uint64_t> load_binds;
+        std::atomic<std::uint64_t> lazy_binds;
+        std::atomic<ObjectState> state;
+    };
+
+    /**
+    ** \struct Table
+    ** \brief Every object seen by the audit library, in load order.
+    **
+    ** Records are only appended, under the dynamic loader's lock, and
+    ** published by a release store of count. Objects loaded once the
+    ** table is full are counted in dropped.
+    */
+    struct Table {
+        std::uint32_t version;
+        std::atomic<std::uint32_t> count;
+        std::atomic<std::uint64_t> dropped;
+        ObjectRecord objects[max_objects];
+    };
+}
+
+#endif
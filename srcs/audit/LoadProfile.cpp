@@ -0,0 +1,131 @@
+/**
+** \file audit/LoadProfile.cpp
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:50
+** \date Last update: 2026-10-16 23:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <cstring>
+
+#include <dlfcn.h>
+
+#include "audit/AuditTable.hpp"
+#include "audit/LoadProfile.hpp"
+
+/*
+** The stub the audit library binds in place of itself. It's only reached
+** when the process isn't audited.
+*/
+extern "C" void *dynamicloader_rtld_audit(int) {
+    return nullptr;
+}
+
+namespace clonixin::dynamicloader::audit {
+    namespace {
+        /*
+        ** Looked up once: LD_AUDIT can't change once the process started.
+        ** dlsym() goes through the audit library, which returns its own
+        ** hook instead of the stub. The stub isn't found when the library
+        ** is linked in an executable that doesn't export its symbols; the
+        ** error is cleared, so that backends don't report it.
+        */
+        Hook hook() noexcept {
+            static Hook const resolved = []() -> Hook {
+                void *sym = dlsym(RTLD_DEFAULT, hook_name);
+
+                if (sym == nullptr)
+                    (void)dlerror();
+                if (sym == nullptr || sym == reinterpret_cast<void *>(&dynamicloader_rtld_audit))
+                    return nullptr;
+                return reinterpret_cast<Hook>(sym);
+            }();
+
+            return resolved;
+        }
+
+        Table const *table() noexcept {
+            Hook h = hook();
+
+            if (h == nullptr)
+                return nullptr;
+
+            Table const *t = static_cast<Table const *>(h(static_cast<int>(HookOp::Table)));
+
+            return t != nullptr && t->version == table_version ? t : nullptr;
+        }
+    }
+
+    /**
+    ** \brief Check whether the process is audited by rtld_audit.
+    **
+    ** \return true if a profile is available.
+    */
+    bool LoadProfile::isActive() noexcept {
+        return table() != nullptr;
+    }
+
+    /**
+    ** \brief Read what was measured about every object seen so far.
+    **
+    ** \return The objects, in load order. Objects that were closed are
+    ** kept, and an object opened again gets a new entry.
+    */
+    std::vector<LoadProfile::Library> LoadProfile::libraries() {
+        std::vector<Library> libs;
+        Table const *t = table();
+
+        if (t == nullptr)
+            return libs;
+
+        std::uint32_t count = t->count.load(std::memory_order_acquire);
+
+        libs.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            ObjectRecord const &obj = t->objects[i];
+            ObjectState state = obj.state.load(std::memory_order_acquire);
+
+            libs.push_back({std::string(obj.name, strnlen(obj.name, object_name_size)), obj.lmid,
+                    obj.plt_slots, obj.map_ns, obj.setup_ns.load(std::memory_order_relaxed),
+                    obj.load_binds.load(std::memory_order_relaxed), obj.lazy_binds.load(std::memory_order_relaxed),
+                    state != ObjectState::Loading, state == ObjectState::Closed});
+        }
+
+        return libs;
+    }
+
+    /**
+    ** \brief Get the number of objects the audit library had no room for.
+    **
+    ** \return Number of objects missing from libraries().
+    */
+    std::uint64_t LoadProfile::dropped() noexcept {
+        Table const *t = table();
+
+        return t != nullptr ? t->dropped.load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+    ** \brief Tell the audit library that the calling thread is about to
+    ** call dlopen(), so that it can time the mapping of the object opened.
+    **
+    ** Does nothing when the process isn't audited.
+    */
+    void LoadProfile::opening() noexcept {
+        if (Hook h = hook())
+            (void)h(static_cast<int>(HookOp::Opening));
+    }
+
+    /**
+    ** \brief Tell the audit library that the calling thread's last
+    ** dlopen() succeeded, so that it can time its setup.
+    **
+    ** Does nothing when the process isn't audited. Must not be called
+    ** between a failed dlopen() and the dlerror() call reporting it.
+    */
+    void LoadProfile::opened() noexcept {
+        if (Hook h = hook())
+            (void)h(static_cast<int>(HookOp::Opened));
+    }
+}
@@ -0,0 +1,81 @@
+/**
+** \file audit/LoadProfile.hpp
+** Header defining LoadProfile, which reads what the rtld_audit library
+** measured about the objects loaded by the process.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:50
+** \date Last update: 2026-10-16 23:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef audit_LoadProfile_hpp_
+#define audit_LoadProfile_hpp_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace clonixin::dynamicloader::audit {
+    /**
+    ** \class LoadProfile
+    ** \brief Per object load phases and PLT bindings, as measured by the
+    ** rtld_audit library.
+    **
+    ** The profile is only available when the process is started with the
+    ** rtld_audit library in LD_AUDIT:
+    **
+    **     LD_AUDIT=lib/rtld_audit.so ./program
+    **
+    ** Otherwise, isActive() returns false, and libraries() is empty.
+    ** Auditing slows every PLT call down, so it is meant for profiling
+    ** runs, not for production.
+    **
+    ** The profile tells whether a plugin should be opened with
+    ** OpenFlags::Lazy or OpenFlags::Now: a plugin opened lazily that ends
+    ** up binding most of its plt_slots pays for each of them on first
+    ** call, while one that only binds a few of them would pay for all of
+    ** them at setup if opened with OpenFlags::Now.
+    **
+    ** The mapping time of an object opened after startup, and the setup
+    ** time of its load, are only known if it was opened through one of the
+    ** linux backends, which tell the audit library when dlopen() is called,
+    ** and when it returns.
+    */
+    class LoadProfile {
+        public:
+            /**
+            ** \brief What was measured about an object.
+            **
+            ** setup_ns covers relocations and initializers of every
+            ** object of a load, and is held by the first one; it is zero
+            ** for the others, and when unknown. For the startup objects,
+            ** it only covers relocations. map_ns is zero when unknown.
+            */
+            struct Library {
+                std::string name;
+                std::int64_t lmid;
+                std::uint64_t plt_slots;
+                std::uint64_t map_ns;
+                std::uint64_t setup_ns;
+                std::uint64_t load_binds;
+                std::uint64_t lazy_binds;
+                bool loaded;
+                bool closed;
+            };
+
+            LoadProfile() = delete;
+
+            [[nodiscard]]
+            static bool isActive() noexcept;
+            [[nodiscard]]
+            static std::vector<Library> libraries();
+            [[nodiscard]]
+            static std::uint64_t dropped() noexcept;
+
+            static void opening() noexcept;
+            static void opened() noexcept;
+    };
+}
+
+#endif
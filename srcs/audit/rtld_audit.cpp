@@ -0,0 +1,203 @@
+/**
+** \file audit/rtld_audit.cpp
+** The rtld_audit companion library, which profiles how objects are
+** loaded, and how often their PLT slots are bound.
+**
+** It is loaded by the dynamic loader through LD_AUDIT, before anything
+** else, and lives in its own link map list: it shares no symbol with the
+** audited process. The process reaches its table through a hook: the
+** dynamicloader library defines a stub named after hook_name, and every
+** binding of that name is redirected here.
+**
+** Loads are split in phases, from the la_activity() and la_objopen()
+** notifications: an object is mapped between the previous notification
+** and its la_objopen(), and the load is set up, relocations and
+** initializers, between LA_ACT_CONSISTENT and la_preinit() for the
+** startup objects, and the Opened hook call for later ones. The root of a
+** later load is already mapped when LA_ACT_ADD is reported: its mapping
+** starts at the Opening hook call, and is unknown without one.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:50
+** \date Last update: 2026-10-16 23:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <cstring>
+#include <ctime>
+
+#include <link.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "audit/AuditTable.hpp"
+
+namespace {
+    namespace cda = clonixin::dynamicloader::audit;
+
+    using cda::ObjectRecord;
+    using cda::ObjectState;
+
+    cda::Table table;
+
+    /*
+    ** Only touched from la_activity() and la_objopen(), which the dynamic
+    ** loader calls with its lock held. The startup objects are a load
+    ** started by la_version(): the executable and the dynamic loader are
+    ** reported before its LA_ACT_ADD.
+    */
+    std::uint64_t mark_ns = 0;
+    std::uint32_t root = 0;
+    bool adding = false;
+
+    /*
+    ** When the calling thread's pending dlopen() started, or 0. Consumed by
+    ** the LA_ACT_ADD of the load it starts, if any.
+    */
+    thread_local std::uint64_t opening_ns = 0;
+
+    std::uint64_t now() noexcept {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+    std::uint32_t tid() noexcept {
+        return static_cast<std::uint32_t>(syscall(SYS_gettid));
+    }
+
+    std::uint64_t pltSlots(struct link_map const *map) noexcept {
+        std::uint64_t size = 0;
+        std::uint64_t entry = sizeof(ElfW(Rela));
+
+        for (ElfW(Dyn) const *dyn = map->l_ld; dyn != nullptr && dyn->d_tag != DT_NULL; ++dyn) {
+            if (dyn->d_tag == DT_PLTRELSZ)
+                size = dyn->d_un.d_val;
+            else if (dyn->d_tag == DT_PLTREL && dyn->d_un.d_val == DT_REL)
+                entry = sizeof(ElfW(Rel));
+        }
+
+        return size / entry;
+    }
+
+    /*
+    ** Ends the loads still in progress in a thread. The setup time is only
+    ** known when the load is ended by the thread that started it.
+    */
+    void finish(std::uint32_t thread, bool timed, bool any_thread = false) noexcept {
+        std::uint64_t end = now();
+        std::uint32_t count = table.count.load(std::memory_order_acquire);
+
+        for (std::uint32_t i = count; i-- > 0;) {
+            ObjectRecord &obj = table.objects[i];
+
+            if ((!any_thread && obj.tid != thread) || obj.state.load(std::memory_order_relaxed) != ObjectState::Loading)
+                continue;
+
+            if (timed && obj.root == i && obj.consistent_ns != 0)
+                obj.setup_ns.store(end - obj.consistent_ns, std::memory_order_relaxed);
+            obj.state.store(ObjectState::Loaded, std::memory_order_release);
+        }
+    }
+
+    void *hook(int op) {
+        if (op == static_cast<int>(cda::HookOp::Opening))
+            opening_ns = now();
+        else if (op == static_cast<int>(cda::HookOp::Opened)) {
+            opening_ns = 0;
+            finish(tid(), true);
+        }
+
+        return &table;
+    }
+}
+
+extern "C" {
+    unsigned int la_version(unsigned int version) {
+        table.version = cda::table_version;
+        mark_ns = now();
+        adding = true;
+
+        return version < LAV_CURRENT ? version : LAV_CURRENT;
+    }
+
+    void la_activity(uintptr_t *, unsigned int flag) {
+        if (flag == LA_ACT_ADD && !adding) {
+            finish(tid(), false);
+            mark_ns = opening_ns;
+            opening_ns = 0;
+            root = table.count.load(std::memory_order_relaxed);
+            adding = true;
+        } else if (flag == LA_ACT_CONSISTENT && adding) {
+            std::uint64_t consistent = now();
+            std::uint32_t count = table.count.load(std::memory_order_relaxed);
+
+            if (root < count)
+                table.objects[root].consistent_ns = consistent;
+            adding = false;
+        }
+    }
+
+    unsigned int la_objopen(struct link_map *map, Lmid_t lmid, uintptr_t *cookie) {
+        std::uint64_t opened = now();
+        std::uint32_t idx = table.count.load(std::memory_order_relaxed);
+
+        *cookie = 0;
+        if (idx == cda::max_objects) {
+            table.dropped.fetch_add(1, std::memory_order_relaxed);
+            mark_ns = opened;
+            return LA_FLG_BINDTO | LA_FLG_BINDFROM;
+        }
+
+        ObjectRecord &obj = table.objects[idx];
+        char const *name = map->l_name != nullptr ? map->l_name : "";
+        std::size_t len = std::strlen(name);
+        std::size_t kept = len < cda::object_name_size ? len : cda::object_name_size - 1;
+
+        std::memcpy(obj.name, name + len - kept, kept);
+        obj.name[kept] = '\0';
+        obj.lmid = lmid;
+        obj.tid = tid();
+        obj.root = root < idx ? root : idx;
+        obj.plt_slots = pltSlots(map);
+        obj.map_ns = mark_ns != 0 ? opened - mark_ns : 0;
+        obj.state.store(ObjectState::Loading, std::memory_order_relaxed);
+
+        table.count.store(idx + 1, std::memory_order_release);
+        *cookie = idx + 1;
+        mark_ns = now();
+
+        return LA_FLG_BINDTO | LA_FLG_BINDFROM;
+    }
+
+    unsigned int la_objclose(uintptr_t *cookie) {
+        if (*cookie != 0)
+            table.objects[*cookie - 1].state.store(ObjectState::Closed, std::memory_order_release);
+
+        return 0;
+    }
+
+    void la_preinit(uintptr_t *) {
+        finish(0, true, true);
+    }
+
+    uintptr_t la_symbind64(Elf64_Sym *sym, unsigned int, uintptr_t *refcook, uintptr_t *,
+            unsigned int *flags, char const *name) {
+        *flags |= LA_SYMB_NOPLTENTER | LA_SYMB_NOPLTEXIT;
+
+        if (std::strcmp(name, cda::hook_name) == 0)
+            return reinterpret_cast<uintptr_t>(&hook);
+
+        if (*refcook != 0) {
+            ObjectRecord &obj = table.objects[*refcook - 1];
+
+            if (obj.state.load(std::memory_order_acquire) == ObjectState::Loading)
+                obj.load_binds.fetch_add(1, std::memory_order_relaxed);
+            else
+                obj.lazy_binds.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return sym->st_value;
+    }
+}
@@ -0,0 +1,550 @@
+/**
+** \file Bundle.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:50
+** \date Last update: 2026-10-16 21:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./Bundle.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    namespace {
+        constexpr char file_magic[8] = {'D', 'L', 'B', 'U', 'N', 'D', 'L', 'E'};
+        constexpr std::uint32_t file_version = 1;
+
+        /*
+        ** The index is the header, the entries sorted by name, then their
+        ** null terminated names. Every offset is relative to the start of
+        ** the file, and the checksum covers the index past the header.
+        ** Images follow the index, each on a page boundary.
+        */
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t entry_count;
+            std::uint64_t index_size;
+            std::uint64_t checksum;
+        };
+
+        struct EntryRecord {
+            std::uint8_t id[BuildId::max_size];
+            std::uint32_t id_size;
+            std::uint32_t compression;
+            std::uint64_t name;
+            std::uint32_t name_size;
+            std::uint32_t padding;
+            std::uint64_t offset;
+            std::uint64_t stored_size;
+            std::uint64_t size;
+        };
+
+        /*
+        ** A sequence of the compressed format is a token, whose high and
+        ** low nibbles are the literal count and the match length minus
+        ** min_match, the literals, the offset of the match backwards, on
+        ** two little endian bytes, then the match length. A nibble of 15
+        ** is extended by the bytes that follow, up to the first one under
+        ** 255. The last sequence has literals only.
+        */
+        constexpr std::size_t min_match = 4;
+        constexpr std::size_t max_offset = 65535;
+        constexpr unsigned int hash_bits = 16;
+
+        std::uint64_t checksum(unsigned char const *data, std::size_t size) noexcept {
+            std::uint64_t hash = 0xcbf29ce484222325;
+
+            for (std::size_t i = 0; i < size; ++i) {
+                hash ^= data[i];
+                hash *= 0x100000001b3;
+            }
+
+            return hash;
+        }
+
+        bool fits(std::uint64_t offset, std::uint64_t size, std::size_t total) noexcept {
+            return offset <= total && size <= total - offset;
+        }
+
+        std::uint64_t alignUp(std::uint64_t offset) noexcept {
+            return (offset + Bundle::page_size - 1) & ~std::uint64_t(Bundle::page_size - 1);
+        }
+
+        std::string_view nameOf(unsigned char const *map, EntryRecord const &rec) noexcept {
+            return std::string_view(reinterpret_cast<char const *>(map + rec.name), rec.name_size);
+        }
+
+        std::uint32_t read32(unsigned char const *p) noexcept {
+            std::uint32_t v;
+
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        void putLength(std::vector<unsigned char> &out, std::size_t length) {
+            for (length -= 15; length >= 255; length -= 255)
+                out.push_back(255);
+            out.push_back(static_cast<unsigned char>(length));
+        }
+
+        void putSequence(std::vector<unsigned char> &out, unsigned char const *literals, std::size_t count, std::size_t offset, std::size_t length) {
+            std::size_t match = length != 0 ? length - min_match : 0;
+
+            out.push_back(static_cast<unsigned char>((std::min<std::size_t>(count, 15) << 4) | std::min<std::size_t>(match, 15)));
+            if (count >= 15)
+                putLength(out, count);
+            out.insert(out.end(), literals, literals + count);
+
+            if (length == 0)
+                return;
+
+            out.push_back(static_cast<unsigned char>(offset & 0xff));
+            out.push_back(static_cast<unsigned char>(offset >> 8));
+            if (match >= 15)
+                putLength(out, match);
+        }
+
+        /*
+        ** Adds the extension bytes of a length to it, failing on a
+        ** truncated input or a length past limit.
+        */
+        bool getLength(unsigned char const *&in, unsigned char const *end, std::size_t &length, std::size_t limit) noexcept {
+            unsigned char byte = 255;
+
+            while (byte == 255) {
+                if (in == end)
+                    return false;
+
+                byte = *in++;
+                length += byte;
+                if (length > limit)
+                    return false;
+            }
+
+            return true;
+        }
+
+        /*
+        ** The build-id of an image is read from its PT_NOTE segments, if it
+        ** is an ELF file of the running process' class.
+        */
+        BuildId imageBuildId(std::vector<unsigned char> const &image) noexcept {
+            if (image.size() < sizeof(ElfW(Ehdr)) || std::memcmp(image.data(), ELFMAG, SELFMAG) != 0)
+                return BuildId();
+
+            ElfW(Ehdr) ehdr;
+
+            std::memcpy(&ehdr, image.data(), sizeof(ehdr));
+            if (ehdr.e_ident[EI_CLASS] != (sizeof(void *) == 8 ? ELFCLASS64 : ELFCLASS32) || ehdr.e_phentsize != sizeof(ElfW(Phdr))
+                    || !fits(ehdr.e_phoff, std::uint64_t(ehdr.e_phnum) * sizeof(ElfW(Phdr)), image.size()))
+                return BuildId();
+
+            for (ElfW(Half) i = 0; i < ehdr.e_phnum; ++i) {
+                ElfW(Phdr) phdr;
+
+                std::memcpy(&phdr, image.data() + ehdr.e_phoff + i * sizeof(ElfW(Phdr)), sizeof(phdr));
+                if (phdr.p_type != PT_NOTE || phdr.p_offset % alignof(ElfW(Nhdr)) != 0 || !fits(phdr.p_offset, phdr.p_filesz, image.size()))
+                    continue;
+
+                BuildId id = BuildId::fromNotes(image.data() + phdr.p_offset, phdr.p_filesz);
+
+                if (id.isValid())
+                    return id;
+            }
+
+            return BuildId();
+        }
+
+        bool writeAll(int fd, void const *data, std::size_t size) noexcept {
+            unsigned char const *bytes = static_cast<unsigned char const *>(data);
+
+            while (size != 0) {
+                ssize_t n = ::write(fd, bytes, size);
+
+                if (n <= 0)
+                    return false;
+                bytes += n;
+                size -= static_cast<std::size_t>(n);
+            }
+
+            return true;
+        }
+    }
+
+    Bundle::Bundle(std::string const &path) noexcept
+    : _path(path), _fd(-1), _map(nullptr), _size(0) {
+        struct stat st;
+
+        _fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (_fd < 0)
+            return;
+
+        if (fstat(_fd, &st) == 0 && S_ISREG(st.st_mode) && static_cast<std::size_t>(st.st_size) >= sizeof(FileHeader)) {
+            void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+
+            if (map != MAP_FAILED) {
+                _map = static_cast<unsigned char const *>(map);
+                _size = st.st_size;
+            }
+        }
+
+        if (_map == nullptr || !validate())
+            unmap();
+    }
+
+    Bundle::~Bundle() {
+        unmap();
+    }
+
+    std::string const &Bundle::getPath() const noexcept {
+        return _path;
+    }
+
+    bool Bundle::isLoaded() const noexcept {
+        return _map != nullptr;
+    }
+
+    std::size_t Bundle::size() const noexcept {
+        if (_map == nullptr)
+            return 0;
+
+        return reinterpret_cast<FileHeader const *>(_map)->entry_count;
+    }
+
+    /*
+    ** The descriptor stays open as long as the bundle, so that images can
+    ** be copied from it by the kernel.
+    */
+    int Bundle::getFd() const noexcept {
+        return _fd;
+    }
+
+    Bundle::Entry Bundle::at(std::size_t i) const noexcept {
+        EntryRecord const &rec = reinterpret_cast<EntryRecord const *>(_map + sizeof(FileHeader))[i];
+        Entry entry;
+
+        std::memcpy(entry.id.bytes.data(), rec.id, BuildId::max_size);
+        entry.id.size = rec.id_size;
+        entry.name = utils::ZStringView(reinterpret_cast<char const *>(_map + rec.name), rec.name_size);
+        entry.compression = static_cast<Compression>(rec.compression);
+        entry.offset = rec.offset;
+        entry.stored_size = rec.stored_size;
+        entry.size = rec.size;
+
+        return entry;
+    }
+
+    bool Bundle::find(utils::ZStringView name, Entry &entry) const noexcept {
+        if (_map == nullptr)
+            return false;
+
+        EntryRecord const *first = reinterpret_cast<EntryRecord const *>(_map + sizeof(FileHeader));
+        EntryRecord const *last = first + size();
+        EntryRecord const *rec = std::lower_bound(first, last, name.view(), [this](EntryRecord const &lhs, std::string_view key) {
+            return nameOf(_map, lhs) < key;
+        });
+
+        if (rec == last || nameOf(_map, *rec) != name.view())
+            return false;
+
+        entry = at(static_cast<std::size_t>(rec - first));
+        return true;
+    }
+
+    std::vector<std::string> Bundle::getNames() const {
+        std::vector<std::string> names;
+
+        names.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i)
+            names.emplace_back(at(i).name.view());
+
+        return names;
+    }
+
+    /*
+    ** Writes the image of the entry, of entry.size bytes, to out.
+    */
+    bool Bundle::extract(Entry const &entry, unsigned char *out) const noexcept {
+        if (_map == nullptr)
+            return false;
+
+        unsigned char const *in = _map + entry.offset;
+
+        if (entry.compression == Compression::None) {
+            std::memcpy(out, in, entry.size);
+            return true;
+        }
+
+        return decompress(in, entry.stored_size, out, entry.size);
+    }
+
+    /*
+    ** Images are read whole, as the index, which comes first, holds their
+    ** stored sizes. The file is written next to the old one, then renamed
+    ** over it, as OffsetCache::save() does.
+    */
+    bool Bundle::create(std::string const &path, std::vector<Source> const &sources, Compression compression) noexcept {
+        struct Image {
+            Source const *source;
+            BuildId id;
+            Compression compression;
+            std::uint64_t size;
+            std::vector<unsigned char> stored;
+        };
+
+        try {
+            std::vector<Image> images;
+
+            for (Source const &source : sources) {
+                std::ifstream file(source.path, std::ios::binary);
+
+                if (!file)
+                    return false;
+
+                Image image{&source, BuildId(), Compression::None, 0, {}};
+
+                image.stored.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+                if (file.bad())
+                    return false;
+
+                image.id = imageBuildId(image.stored);
+                image.size = image.stored.size();
+
+                if (compression == Compression::Lz) {
+                    std::vector<unsigned char> packed = compress(image.stored.data(), image.stored.size());
+
+                    if (packed.size() < image.stored.size()) {
+                        image.stored = std::move(packed);
+                        image.compression = Compression::Lz;
+                    }
+                }
+
+                images.push_back(std::move(image));
+            }
+
+            std::sort(images.begin(), images.end(), [](Image const &lhs, Image const &rhs) {
+                return lhs.source->name < rhs.source->name;
+            });
+
+            auto duplicate = std::adjacent_find(images.begin(), images.end(), [](Image const &lhs, Image const &rhs) {
+                return lhs.source->name == rhs.source->name;
+            });
+
+            if (duplicate != images.end())
+                return false;
+
+            std::vector<unsigned char> index(sizeof(FileHeader) + images.size() * sizeof(EntryRecord));
+            std::vector<EntryRecord> records;
+
+            for (Image const &image : images) {
+                EntryRecord rec{};
+
+                std::memcpy(rec.id, image.id.bytes.data(), BuildId::max_size);
+                rec.id_size = image.id.size;
+                rec.compression = static_cast<std::uint32_t>(image.compression);
+                rec.name = index.size();
+                rec.name_size = static_cast<std::uint32_t>(image.source->name.size());
+                rec.stored_size = image.stored.size();
+                rec.size = image.size;
+                index.insert(index.end(), image.source->name.begin(), image.source->name.end());
+                index.push_back('\0');
+                records.push_back(rec);
+            }
+
+            std::uint64_t offset = alignUp(index.size());
+
+            for (EntryRecord &rec : records) {
+                rec.offset = offset;
+                offset = alignUp(offset + rec.stored_size);
+            }
+
+            FileHeader header{};
+
+            std::memcpy(index.data() + sizeof(FileHeader), records.data(), records.size() * sizeof(EntryRecord));
+            std::memcpy(header.magic, file_magic, sizeof(file_magic));
+            header.version = file_version;
+            header.entry_count = static_cast<std::uint32_t>(records.size());
+            header.index_size = index.size();
+            header.checksum = checksum(index.data() + sizeof(FileHeader), index.size() - sizeof(FileHeader));
+            std::memcpy(index.data(), &header, sizeof(header));
+
+            std::string tmp = path + ".XXXXXX";
+            int fd = mkstemp(tmp.data());
+
+            if (fd < 0)
+                return false;
+
+            std::vector<unsigned char> padding(page_size, 0);
+            std::uint64_t written = index.size();
+            bool ok = writeAll(fd, index.data(), index.size());
+
+            for (std::size_t i = 0; ok && i < images.size(); ++i) {
+                ok = writeAll(fd, padding.data(), records[i].offset - written)
+                    && writeAll(fd, images[i].stored.data(), images[i].stored.size());
+                written = records[i].offset + images[i].stored.size();
+            }
+
+            ok = ok && fchmod(fd, 0644) == 0;
+            ok = ::close(fd) == 0 && ok;
+            if (ok)
+                ok = std::rename(tmp.c_str(), path.c_str()) == 0;
+            if (!ok)
+                (void)::unlink(tmp.c_str());
+
+            return ok;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    /*
+    ** Greedy matching against the last position seen with the same four
+    ** bytes. Images larger than 4 GiB are returned uncompressed.
+    */
+    std::vector<unsigned char> Bundle::compress(unsigned char const *data, std::size_t size) {
+        if (size > UINT32_MAX)
+            return std::vector<unsigned char>(data, data + size);
+
+        std::vector<std::uint32_t> table(std::size_t(1) << hash_bits, 0);
+        std::vector<unsigned char> out;
+        std::size_t anchor = 0;
+        std::size_t i = 0;
+
+        out.reserve(size + size / 255 + 16);
+
+        while (i + min_match <= size) {
+            std::uint32_t hash = (read32(data + i) * 2654435761u) >> (32 - hash_bits);
+            std::size_t candidate = table[hash];
+
+            table[hash] = static_cast<std::uint32_t>(i + 1);
+
+            if (candidate == 0 || i - (candidate - 1) > max_offset || read32(data + candidate - 1) != read32(data + i)) {
+                ++i;
+                continue;
+            }
+
+            std::size_t match = candidate - 1;
+            std::size_t length = min_match;
+
+            while (i + length < size && data[match + length] == data[i + length])
+                ++length;
+
+            putSequence(out, data + anchor, i - anchor, i - match, length);
+            i += length;
+            anchor = i;
+        }
+
+        putSequence(out, data + anchor, size - anchor, 0, 0);
+
+        return out;
+    }
+
+    /*
+    ** Every read and write is bounds checked, so that a corrupted image
+    ** fails to decompress instead of writing past out. The input must end
+    ** with a sequence of literals only, and fill the output exactly.
+    */
+    bool Bundle::decompress(unsigned char const *in, std::size_t in_size, unsigned char *out, std::size_t out_size) noexcept {
+        unsigned char const *end = in + in_size;
+        unsigned char *op = out;
+        unsigned char *out_end = out + out_size;
+
+        while (in != end) {
+            unsigned char token = *in++;
+            std::size_t count = token >> 4;
+
+            if (count == 15 && !getLength(in, end, count, out_size))
+                return false;
+            if (count > static_cast<std::size_t>(end - in) || count > static_cast<std::size_t>(out_end - op))
+                return false;
+
+            std::memcpy(op, in, count);
+            in += count;
+            op += count;
+
+            if (in == end)
+                return op == out_end;
+            if (end - in < 2)
+                return false;
+
+            std::size_t offset = in[0] | (std::size_t(in[1]) << 8);
+            std::size_t length = token & 15;
+
+            in += 2;
+            if (length == 15 && !getLength(in, end, length, out_size))
+                return false;
+            length += min_match;
+
+            if (offset == 0 || offset > static_cast<std::size_t>(op - out) || length > static_cast<std::size_t>(out_end - op))
+                return false;
+
+            unsigned char const *from = op - offset;
+
+            if (offset >= length) {
+                std::memcpy(op, from, length);
+                op += length;
+            } else {
+                for (std::size_t j = 0; j < length; ++j)
+                    *op++ = from[j];
+            }
+        }
+
+        return false;
+    }
+
+    /*
+    ** Everything the lookups and extract() rely on is checked once, here:
+    ** the checksum of the index, the order of its entries, that every name
+    ** lies in the index, and every image after it, page aligned, and inside
+    ** the file.
+    */
+    bool Bundle::validate() const noexcept {
+        FileHeader const *header = reinterpret_cast<FileHeader const *>(_map);
+
+        if (std::memcmp(header->magic, file_magic, sizeof(file_magic)) != 0 || header->version != file_version
+                || header->index_size < sizeof(FileHeader) || header->index_size > _size
+                || !fits(sizeof(FileHeader), std::uint64_t(header->entry_count) * sizeof(EntryRecord), header->index_size)
+                || header->checksum != checksum(_map + sizeof(FileHeader), header->index_size - sizeof(FileHeader)))
+            return false;
+
+        EntryRecord const *recs = reinterpret_cast<EntryRecord const *>(_map + sizeof(FileHeader));
+
+        for (std::uint32_t i = 0; i < header->entry_count; ++i) {
+            EntryRecord const &rec = recs[i];
+
+            if (rec.id_size > BuildId::max_size || rec.compression > static_cast<std::uint32_t>(Compression::Lz)
+                    || !fits(rec.name, std::uint64_t(rec.name_size) + 1, header->index_size) || _map[rec.name + rec.name_size] != '\0'
+                    || (i != 0 && !(nameOf(_map, recs[i - 1]) < nameOf(_map, rec)))
+                    || rec.offset % page_size != 0 || rec.offset < header->index_size || !fits(rec.offset, rec.stored_size, _size)
+                    || (rec.compression == static_cast<std::uint32_t>(Compression::None) && rec.stored_size != rec.size))
+                return false;
+        }
+
+        return true;
+    }
+
+    void Bundle::unmap() noexcept {
+        if (_map != nullptr)
+            munmap(const_cast<unsigned char *>(_map), _size);
+        if (_fd >= 0)
+            ::close(_fd);
+        _map = nullptr;
+        _size = 0;
+        _fd = -1;
+    }
+}
@@ -0,0 +1,121 @@
+/**
+** \file Bundle.hpp
+** Single file holding many shared objects, behind a mapped index.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:50
+** \date Last update: 2026-10-16 21:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef Bundle_hpp_
+#define Bundle_hpp_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/ZStringView.hpp"
+
+#include "./OffsetCache.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class Bundle
+    ** \brief Read-only view on a bundle of plugins.
+    **
+    ** A bundle is one file holding the images of many shared objects, each
+    ** starting on a page boundary, after an index giving, for each of them,
+    ** its name, where its image lies, its size and its build-id. Deploying
+    ** and opening one file laid out sequentially avoids a directory lookup
+    ** and a scattered read per plugin.
+    **
+    ** The file is mapped when the bundle is built, and its index is
+    ** checksummed and bounds checked once: if anything is off, the bundle
+    ** is empty. Only the pages of the index are read until a plugin is
+    ** opened, by a LinuxBundleBackend.
+    **
+    ** An image may be stored compressed, with a LZ77 block format close to
+    ** LZ4's, built for decompression speed rather than ratio. create()
+    ** only keeps the compressed form of an image when it is smaller.
+    **
+    ** A bundle can be shared by any number of threads, and only needs to
+    ** live as long as the plugins are being opened.
+    */
+    class Bundle {
+        public:
+            static constexpr std::size_t page_size = 4096;
+
+            enum struct Compression : std::uint32_t {
+                None,
+                Lz
+            };
+
+            /**
+            ** \brief One plugin of the bundle, as found in its index.
+            **
+            ** The name is null terminated. The offset and stored size are
+            ** those of the image in the file, the size that of the image
+            ** once decompressed.
+            */
+            struct Entry {
+                utils::ZStringView name = "";
+                BuildId id;
+                Compression compression = Compression::None;
+                std::uint64_t offset = 0;
+                std::uint64_t stored_size = 0;
+                std::uint64_t size = 0;
+            };
+
+            /**
+            ** \brief A plugin to put in a bundle, by create().
+            */
+            struct Source {
+                std::string name;
+                std::string path;
+            };
+
+            explicit Bundle(std::string const &path) noexcept;
+            Bundle(Bundle const &) = delete;
+
+            ~Bundle();
+
+            Bundle &operator=(Bundle const &) = delete;
+
+            [[nodiscard]]
+            std::string const &getPath() const noexcept;
+            [[nodiscard]]
+            bool isLoaded() const noexcept;
+            [[nodiscard]]
+            std::size_t size() const noexcept;
+            [[nodiscard]]
+            int getFd() const noexcept;
+
+            [[nodiscard]]
+            Entry at(std::size_t i) const noexcept;
+            [[nodiscard]]
+            bool find(utils::ZStringView name, Entry &entry) const noexcept;
+            [[nodiscard]]
+            std::vector<std::string> getNames() const;
+
+            bool extract(Entry const &entry, unsigned char *out) const noexcept;
+
+            static bool create(std::string const &path, std::vector<Source> const &sources, Compression compression = Compression::None) noexcept;
+
+            static std::vector<unsigned char> compress(unsigned char const *data, std::size_t size);
+            static bool decompress(unsigned char const *in, std::size_t in_size, unsigned char *out, std::size_t out_size) noexcept;
+
+        private:
+            bool validate() const noexcept;
+            void unmap() noexcept;
+
+        private:
+            std::string _path;
+            int _fd;
+            unsigned char const *_map;
+            std::size_t _size;
+    };
+}
+
+#endif
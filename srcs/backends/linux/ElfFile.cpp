@@ -0,0 +1,229 @@
+/**
+** \file ElfFile.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 18:10
+** \date Last update: 2026-10-16 23:10
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <cstring>
+#include <utility>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./ElfFile.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    namespace {
+        /*
+        ** The dynamic linker is mapped from offset 0, so its ELF header
+        ** describes the class, byte order and machine of the process.
+        */
+        ElfW(Ehdr) const *hostHeader() noexcept {
+            static ElfW(Ehdr) const *header = []() -> ElfW(Ehdr) const * {
+                Dl_info info;
+
+                if (dladdr(reinterpret_cast<void *>(&dlopen), &info) == 0 || info.dli_fbase == nullptr)
+                    return nullptr;
+                return static_cast<ElfW(Ehdr) const *>(info.dli_fbase);
+            }();
+
+            return header;
+        }
+    }
+
+    ElfFile::ElfFile(std::string const &path) noexcept
+    : _map(nullptr), _size(0), _status(Status::Unreadable) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st;
+
+        if (fd < 0)
+            return;
+
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            if (static_cast<std::size_t>(st.st_size) < sizeof(ElfW(Ehdr))) {
+                _status = Status::NotElf;
+            } else {
+                void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if (map != MAP_FAILED) {
+                    _map = static_cast<unsigned char const *>(map);
+                    _size = st.st_size;
+                }
+            }
+        }
+        ::close(fd);
+
+        if (_map != nullptr)
+            _status = parse();
+    }
+
+    ElfFile::ElfFile(ElfFile &&oth) noexcept
+    : _map(std::exchange(oth._map, nullptr)), _size(std::exchange(oth._size, 0)),
+    _status(std::exchange(oth._status, Status::Unreadable)), _loads(std::move(oth._loads)),
+    _dynamic(std::move(oth._dynamic)), _image(std::exchange(oth._image, ElfImage())) {}
+
+    ElfFile::~ElfFile() {
+        unmap();
+    }
+
+    ElfFile &ElfFile::operator=(ElfFile &&rhs) noexcept {
+        if (this != std::addressof(rhs)) {
+            unmap();
+
+            _map = std::exchange(rhs._map, nullptr);
+            _size = std::exchange(rhs._size, 0);
+            _status = std::exchange(rhs._status, Status::Unreadable);
+            _loads = std::move(rhs._loads);
+            _dynamic = std::move(rhs._dynamic);
+            _image = std::exchange(rhs._image, ElfImage());
+        }
+
+        return *this;
+    }
+
+    ElfFile::Status ElfFile::getStatus() const noexcept {
+        return _status;
+    }
+
+    bool ElfFile::isValid() const noexcept {
+        return _status == Status::Ok;
+    }
+
+    bool ElfFile::exports(utils::ZStringView name) const noexcept {
+        return isValid() && _image.findSymbol(name.c_str()) != nullptr;
+    }
+
+    ElfImage const &ElfFile::getImage() const noexcept {
+        return _image;
+    }
+
+    char const *ElfFile::describe(Status status) noexcept {
+        switch (status) {
+            case Status::Ok: return "Valid shared object";
+            case Status::Unreadable: return "File could not be read";
+            case Status::NotElf: return "Not an ELF file";
+            case Status::WrongClass: return "ELF class does not match the process";
+            case Status::WrongByteOrder: return "Byte order does not match the process";
+            case Status::WrongMachine: return "Machine does not match the process";
+            case Status::NotShared: return "Not a shared object";
+            case Status::NoDynamic: return "No usable dynamic section";
+            case Status::BadTables: return "Symbol tables are truncated or corrupted";
+        }
+
+        return "Unknown status";
+    }
+
+    /*
+    ** The tables referenced by the dynamic section are given as virtual
+    ** addresses. A copy of the dynamic section is kept, with these
+    ** addresses translated to where the file is mapped, so that ElfImage
+    ** can search it as if the object was loaded.
+    */
+    ElfFile::Status ElfFile::parse() noexcept {
+        ElfW(Ehdr) const *ehdr = at<ElfW(Ehdr)>(0);
+        ElfW(Ehdr) const *host = hostHeader();
+
+        if (ehdr == nullptr || std::memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0)
+            return Status::NotElf;
+        if (host != nullptr && ehdr->e_ident[EI_CLASS] != host->e_ident[EI_CLASS])
+            return Status::WrongClass;
+        if (host != nullptr && ehdr->e_ident[EI_DATA] != host->e_ident[EI_DATA])
+            return Status::WrongByteOrder;
+        if (host != nullptr && ehdr->e_machine != host->e_machine)
+            return Status::WrongMachine;
+        if (ehdr->e_type != ET_DYN)
+            return Status::NotShared;
+
+        ElfW(Phdr) const *phdrs = at<ElfW(Phdr)>(ehdr->e_phoff, ehdr->e_phnum);
+        ElfW(Phdr) const *dynamic = nullptr;
+
+        if (phdrs == nullptr || ehdr->e_phentsize != sizeof(ElfW(Phdr)))
+            return Status::NoDynamic;
+
+        for (ElfW(Half) i = 0; i < ehdr->e_phnum; ++i) {
+            if (phdrs[i].p_type == PT_LOAD)
+                _loads.push_back(phdrs[i]);
+            else if (phdrs[i].p_type == PT_DYNAMIC)
+                dynamic = phdrs + i;
+        }
+
+        if (dynamic == nullptr)
+            return Status::NoDynamic;
+
+        std::size_t count = dynamic->p_filesz / sizeof(ElfW(Dyn));
+        ElfW(Dyn) const *dyn = at<ElfW(Dyn)>(dynamic->p_offset, count);
+
+        if (dyn == nullptr)
+            return Status::NoDynamic;
+
+        for (std::size_t i = 0; i < count && dyn[i].d_tag != DT_NULL; ++i) {
+            ElfW(Dyn) entry = dyn[i];
+
+            switch (entry.d_tag) {
+                case DT_SYMTAB: case DT_STRTAB: case DT_VERSYM: case DT_GNU_HASH: case DT_HASH:
+                    entry.d_un.d_ptr = toAddress(entry.d_un.d_ptr);
+                    if (entry.d_un.d_ptr == 0)
+                        continue;
+                    break;
+                case DT_FLAGS_1:
+                    if ((entry.d_un.d_val & DF_1_PIE) != 0)
+                        return Status::NotShared;
+                    break;
+                default:
+                    break;
+            }
+
+            _dynamic.push_back(entry);
+        }
+
+        ElfW(Dyn) end;
+        end.d_tag = DT_NULL;
+        end.d_un.d_val = 0;
+        _dynamic.push_back(end);
+
+        _image = ElfImage(reinterpret_cast<ElfW(Addr)>(_map), _dynamic.data());
+
+        if (!_image.isValid())
+            return Status::NoDynamic;
+        if (!_image.fitsIn(_map, _size)) {
+            _image = ElfImage();
+            return Status::BadTables;
+        }
+
+        return Status::Ok;
+    }
+
+    void ElfFile::unmap() noexcept {
+        if (_map != nullptr)
+            munmap(const_cast<unsigned char *>(_map), _size);
+        _map = nullptr;
+        _size = 0;
+    }
+
+    template <typename T>
+    T const *ElfFile::at(ElfW(Off) offset, std::size_t count) const noexcept {
+        if (offset > _size || count > (_size - offset) / sizeof(T))
+            return nullptr;
+
+        return reinterpret_cast<T const *>(_map + offset);
+    }
+
+    ElfW(Addr) ElfFile::toAddress(ElfW(Addr) vaddr) const noexcept {
+        for (auto const &load : _loads) {
+            if (vaddr < load.p_vaddr || vaddr - load.p_vaddr >= load.p_filesz)
+                continue;
+
+            ElfW(Off) offset = load.p_offset + (vaddr - load.p_vaddr);
+
+            return offset < _size ? reinterpret_cast<ElfW(Addr)>(_map + offset) : 0;
+        }
+
+        return 0;
+    }
+}
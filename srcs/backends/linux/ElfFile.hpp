@@ -0,0 +1,96 @@
+/**
+** \file ElfFile.hpp
+** Validation of an ELF shared object on disk, without loading it.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 18:10
+** \date Last update: 2026-10-16 23:10
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef ElfFile_hpp_
+#define ElfFile_hpp_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <elf.h>
+#include <link.h>
+
+#include "utils/ZStringView.hpp"
+
+#include "./ElfImage.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class ElfFile
+    ** \brief Read-only view on an ELF shared object file.
+    **
+    ** The file is mapped, not loaded: only the pages holding the headers,
+    ** the dynamic section, and the symbol tables that are actually searched
+    ** are read. Nothing is relocated, and no constructor is run.
+    **
+    ** The file is checked against the running process: it must be an ELF
+    ** shared object of the same class, byte order and machine, with a
+    ** dynamic section. Its symbol, string and hash tables must lie in the
+    ** file, as well as every index and string they refer to. Its exported
+    ** symbols can then be searched with exports().
+    */
+    class ElfFile {
+        public:
+            /**
+            ** \brief Outcome of the validation of the file.
+            */
+            enum struct Status {
+                Ok,
+                Unreadable,
+                NotElf,
+                WrongClass,
+                WrongByteOrder,
+                WrongMachine,
+                NotShared,
+                NoDynamic,
+                BadTables
+            };
+
+            explicit ElfFile(std::string const &path) noexcept;
+            ElfFile(ElfFile const &) = delete;
+            ElfFile(ElfFile &&oth) noexcept;
+
+            ~ElfFile();
+
+            ElfFile &operator=(ElfFile const &) = delete;
+            ElfFile &operator=(ElfFile &&rhs) noexcept;
+
+            [[nodiscard]]
+            Status getStatus() const noexcept;
+            [[nodiscard]]
+            bool isValid() const noexcept;
+
+            [[nodiscard]]
+            bool exports(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            ElfImage const &getImage() const noexcept;
+
+            static char const *describe(Status status) noexcept;
+
+        private:
+            Status parse() noexcept;
+            void unmap() noexcept;
+
+            template <typename T>
+            T const *at(ElfW(Off) offset, std::size_t count = 1) const noexcept;
+            ElfW(Addr) toAddress(ElfW(Addr) vaddr) const noexcept;
+
+        private:
+            unsigned char const *_map;
+            std::size_t _size;
+            Status _status;
+            std::vector<ElfW(Phdr)> _loads;
+            std::vector<ElfW(Dyn)> _dynamic;
+            ElfImage _image;
+    };
+}
+
+#endif
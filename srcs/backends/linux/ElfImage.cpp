@@ -0,0 +1,378 @@
+/**
+** \file ElfImage.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 13:05
+** \date Last update: 2026-10-16 23:10
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "./ElfImage.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    namespace {
+        /*
+        ** Whether bytes bytes starting at ptr lie in [begin, begin + size).
+        */
+        bool holds(void const *begin, std::size_t size, void const *ptr, std::uint64_t bytes) noexcept {
+            auto first = reinterpret_cast<std::uintptr_t>(begin);
+            auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+
+            return addr >= first && addr - first <= size && bytes <= size - (addr - first);
+        }
+    }
+
+    ElfImage::ElfImage() noexcept
+    : _base(0), _dynamic(nullptr), _symtab(nullptr), _strtab(nullptr),
+    _versym(nullptr), _soname(nullptr), _gnu_hash(nullptr), _gnu_nbuckets(0),
+    _gnu_symoffset(0), _gnu_bloom_size(0), _gnu_bloom_shift(0),
+    _gnu_bloom(nullptr), _gnu_buckets(nullptr), _gnu_chain(nullptr),
+    _sysv_hash(nullptr) {}
+
+    ElfImage::ElfImage(ElfW(Addr) base, ElfW(Dyn) const *dynamic) noexcept
+    : ElfImage() {
+        ElfW(Addr) soname = 0;
+        bool has_soname = false;
+
+        _base = base;
+        _dynamic = dynamic;
+
+        for (ElfW(Dyn) const *dyn = dynamic; dyn != nullptr && dyn->d_tag != DT_NULL; ++dyn) {
+            switch (dyn->d_tag) {
+                case DT_SYMTAB: _symtab = relocate<Sym>(dyn->d_un.d_ptr); break;
+                case DT_STRTAB: _strtab = relocate<char>(dyn->d_un.d_ptr); break;
+                case DT_VERSYM: _versym = relocate<ElfW(Half)>(dyn->d_un.d_ptr); break;
+                case DT_GNU_HASH: _gnu_hash = relocate<std::uint32_t>(dyn->d_un.d_ptr); break;
+                case DT_HASH: _sysv_hash = relocate<std::uint32_t>(dyn->d_un.d_ptr); break;
+                case DT_SONAME: soname = dyn->d_un.d_val; has_soname = true; break;
+                default: break;
+            }
+        }
+
+        if (_strtab != nullptr && has_soname)
+            _soname = _strtab + soname;
+
+        if (_gnu_hash != nullptr) {
+            _gnu_nbuckets = _gnu_hash[0];
+            _gnu_symoffset = _gnu_hash[1];
+            _gnu_bloom_size = _gnu_hash[2];
+            _gnu_bloom_shift = _gnu_hash[3];
+            _gnu_bloom = reinterpret_cast<ElfW(Addr) const *>(_gnu_hash + 4);
+            _gnu_buckets = reinterpret_cast<std::uint32_t const *>(_gnu_bloom + _gnu_bloom_size);
+            _gnu_chain = _gnu_buckets + _gnu_nbuckets;
+        }
+    }
+
+    bool ElfImage::isValid() const noexcept {
+        return _symtab != nullptr && _strtab != nullptr
+            && ((_gnu_hash != nullptr && _gnu_nbuckets != 0 && _gnu_bloom_size != 0) || _sysv_hash != nullptr);
+    }
+
+    /*
+    ** Checks every table, every symbol index found in the hash tables, and
+    ** every string referenced by a symbol or by the dynamic section, against
+    ** the mapping. .dynstr must end with a null byte, so that any offset in
+    ** it is a terminated string. The number of symbols is the highest one
+    ** reached by any of the hash tables.
+    */
+    bool ElfImage::fitsIn(void const *begin, std::size_t size) const noexcept {
+        ElfW(Xword) strsz = 0;
+        std::uint32_t count = 0;
+
+        if (!isValid())
+            return false;
+
+        for (ElfW(Dyn) const *dyn = _dynamic; dyn->d_tag != DT_NULL; ++dyn)
+            if (dyn->d_tag == DT_STRSZ)
+                strsz = dyn->d_un.d_val;
+
+        if (strsz == 0 || !holds(begin, size, _strtab, strsz) || _strtab[strsz - 1] != '\0')
+            return false;
+        if (_gnu_hash != nullptr && !checkGnu(begin, size, count))
+            return false;
+        if (_sysv_hash != nullptr && !checkSysv(begin, size, count))
+            return false;
+
+        if (!holds(begin, size, _symtab, std::uint64_t(count) * sizeof(Sym)))
+            return false;
+        if (_versym != nullptr && !holds(begin, size, _versym, std::uint64_t(count) * sizeof(ElfW(Half))))
+            return false;
+        for (std::uint32_t i = 0; i < count; ++i)
+            if (_symtab[i].st_name >= strsz)
+                return false;
+
+        if (_soname != nullptr && static_cast<ElfW(Xword)>(_soname - _strtab) >= strsz)
+            return false;
+        for (ElfW(Dyn) const *dyn = _dynamic; dyn->d_tag != DT_NULL; ++dyn)
+            if (dyn->d_tag == DT_NEEDED && dyn->d_un.d_val >= strsz)
+                return false;
+
+        return true;
+    }
+
+    /*
+    ** Check the GNU hash bloom filter. A false result means the object
+    ** does not define the symbol. Objects without a GNU hash table can't
+    ** tell, and always return true.
+    */
+    bool ElfImage::mayContain(std::uint32_t gnu_hash) const noexcept {
+        constexpr std::uint32_t bits = sizeof(ElfW(Addr)) * 8;
+
+        if (!isValid())
+            return false;
+        if (_gnu_hash == nullptr)
+            return true;
+
+        ElfW(Addr) word = _gnu_bloom[(gnu_hash / bits) % _gnu_bloom_size];
+        ElfW(Addr) mask = (ElfW(Addr)(1) << (gnu_hash % bits))
+            | (ElfW(Addr)(1) << ((gnu_hash >> _gnu_bloom_shift) % bits));
+
+        return (word & mask) == mask;
+    }
+
+    ElfImage::Sym const *ElfImage::findSymbol(char const *name) const noexcept {
+        return findSymbol(name, gnuHash(name), sysvHash(name));
+    }
+
+    ElfImage::Sym const *ElfImage::findSymbol(char const *name, std::uint32_t gnu_hash, std::uint32_t sysv_hash) const noexcept {
+        if (!isValid())
+            return nullptr;
+
+        if (_gnu_hash != nullptr)
+            return findGnu(name, gnu_hash);
+
+        return findSysv(name, sysv_hash);
+    }
+
+    /*
+    ** The number of entries in .dynsym is not stored anywhere in the dynamic
+    ** section. The SysV hash table has one chain entry per symbol. In the GNU
+    ** hash table, the last symbol is the end of the chain starting at the
+    ** highest bucket.
+    */
+    std::uint32_t ElfImage::getSymbolCount() const noexcept {
+        if (!isValid())
+            return 0;
+
+        if (_sysv_hash != nullptr)
+            return _sysv_hash[1];
+
+        std::uint32_t last = 0;
+        for (std::uint32_t i = 0; i < _gnu_nbuckets; ++i)
+            if (_gnu_buckets[i] > last)
+                last = _gnu_buckets[i];
+
+        if (last < _gnu_symoffset)
+            return _gnu_symoffset;
+
+        while ((_gnu_chain[last - _gnu_symoffset] & 1) == 0)
+            ++last;
+
+        return last + 1;
+    }
+
+    ElfImage::Sym const *ElfImage::getSymbol(std::uint32_t idx) const noexcept {
+        return _symtab + idx;
+    }
+
+    bool ElfImage::isHidden(std::uint32_t idx) const noexcept {
+        return _versym != nullptr && (_versym[idx] & 0x8000) != 0;
+    }
+
+    void *ElfImage::getAddress(Sym const *sym) const noexcept {
+        return reinterpret_cast<void *>(_base + sym->st_value);
+    }
+
+    char const *ElfImage::getName(Sym const *sym) const noexcept {
+        return _strtab + sym->st_name;
+    }
+
+    char const *ElfImage::getString(ElfW(Xword) offset) const noexcept {
+        return _strtab + offset;
+    }
+
+    char const *ElfImage::getSoname() const noexcept {
+        return _soname;
+    }
+
+    ElfW(Addr) ElfImage::getBase() const noexcept {
+        return _base;
+    }
+
+    ElfW(Dyn) const *ElfImage::getDynamic() const noexcept {
+        return _dynamic;
+    }
+
+    bool ElfImage::hasGnuHash() const noexcept {
+        return _gnu_hash != nullptr;
+    }
+
+    std::uint32_t ElfImage::gnuHash(char const *name) noexcept {
+        std::uint32_t h = 5381;
+
+        for (unsigned char const *c = reinterpret_cast<unsigned char const *>(name); *c != '\0'; ++c)
+            h = (h << 5) + h + *c;
+
+        return h;
+    }
+
+    std::uint32_t ElfImage::sysvHash(char const *name) noexcept {
+        std::uint32_t h = 0;
+
+        for (unsigned char const *c = reinterpret_cast<unsigned char const *>(name); *c != '\0'; ++c) {
+            h = (h << 4) + *c;
+
+            std::uint32_t g = h & 0xf0000000;
+            if (g != 0)
+                h ^= g >> 24;
+            h &= ~g;
+        }
+
+        return h;
+    }
+
+    bool ElfImage::isDefined(Sym const *sym) noexcept {
+        unsigned char bind = symbolBind(sym);
+        unsigned char type = symbolType(sym);
+
+        if (sym->st_shndx == SHN_UNDEF)
+            return false;
+        if (bind != STB_GLOBAL && bind != STB_WEAK && bind != STB_GNU_UNIQUE)
+            return false;
+        if (sym->st_value == 0 && type != STT_TLS)
+            return false;
+
+        return type == STT_NOTYPE || type == STT_OBJECT || type == STT_FUNC
+            || type == STT_COMMON || type == STT_TLS || type == STT_GNU_IFUNC;
+    }
+
+    unsigned char ElfImage::symbolType(Sym const *sym) noexcept {
+        return sym->st_info & 0xf;
+    }
+
+    unsigned char ElfImage::symbolBind(Sym const *sym) noexcept {
+        return sym->st_info >> 4;
+    }
+
+    /*
+    ** Depending on the architecture, the dynamic linker may or may not
+    ** relocate the pointers of the dynamic section in place. As an object is
+    ** never mapped below it's load base, a pointer below the base can only
+    ** be an unrelocated one.
+    */
+    template <typename T>
+    T const *ElfImage::relocate(ElfW(Addr) ptr) const noexcept {
+        return reinterpret_cast<T const *>(ptr < _base ? ptr + _base : ptr);
+    }
+
+    bool ElfImage::matches(std::uint32_t idx, char const *name) const noexcept {
+        Sym const *sym = _symtab + idx;
+
+        if (!isDefined(sym) || isHidden(idx))
+            return false;
+
+        return std::strcmp(_strtab + sym->st_name, name) == 0;
+    }
+
+    ElfImage::Sym const *ElfImage::findGnu(char const *name, std::uint32_t hash) const noexcept {
+        if (!mayContain(hash))
+            return nullptr;
+
+        std::uint32_t idx = _gnu_buckets[hash % _gnu_nbuckets];
+        if (idx < _gnu_symoffset)
+            return nullptr;
+
+        for (;; ++idx) {
+            std::uint32_t chain_hash = _gnu_chain[idx - _gnu_symoffset];
+
+            if ((chain_hash | 1) == (hash | 1) && matches(idx, name))
+                return _symtab + idx;
+            if ((chain_hash & 1) != 0)
+                break;
+        }
+
+        return nullptr;
+    }
+
+    /*
+    ** A chain can't be longer than the number of symbols, which stops the
+    ** walk on a corrupted, looping chain.
+    */
+    ElfImage::Sym const *ElfImage::findSysv(char const *name, std::uint32_t hash) const noexcept {
+        std::uint32_t nbucket = _sysv_hash[0];
+        std::uint32_t nchain = _sysv_hash[1];
+        std::uint32_t const *bucket = _sysv_hash + 2;
+        std::uint32_t const *chain = bucket + nbucket;
+
+        if (nbucket == 0)
+            return nullptr;
+
+        std::uint32_t idx = bucket[hash % nbucket];
+
+        for (std::uint32_t steps = 0; idx != STN_UNDEF && steps < nchain; idx = chain[idx], ++steps)
+            if (matches(idx, name))
+                return _symtab + idx;
+
+        return nullptr;
+    }
+
+    /*
+    ** Chains are stored one after the other, so every chain ends in the
+    ** mapping if the one starting at the highest bucket does.
+    */
+    bool ElfImage::checkGnu(void const *begin, std::size_t size, std::uint32_t &count) const noexcept {
+        if (!holds(begin, size, _gnu_hash, 4 * sizeof(std::uint32_t))
+                || !holds(begin, size, _gnu_bloom, std::uint64_t(_gnu_bloom_size) * sizeof(ElfW(Addr)))
+                || !holds(begin, size, _gnu_buckets, std::uint64_t(_gnu_nbuckets) * sizeof(std::uint32_t)))
+            return false;
+
+        std::uint64_t last = 0;
+        bool chained = false;
+
+        for (std::uint32_t b = 0; b < _gnu_nbuckets; ++b) {
+            if (_gnu_buckets[b] >= _gnu_symoffset) {
+                last = std::max<std::uint64_t>(last, _gnu_buckets[b]);
+                chained = true;
+            }
+        }
+
+        if (!chained) {
+            count = std::max(count, _gnu_symoffset);
+            return true;
+        }
+
+        for (;; ++last) {
+            std::uint32_t const *chain = _gnu_chain + (last - _gnu_symoffset);
+
+            if (last >= UINT32_MAX || !holds(begin, size, chain, sizeof(std::uint32_t)))
+                return false;
+            if ((*chain & 1) != 0)
+                break;
+        }
+
+        count = std::max(count, static_cast<std::uint32_t>(last + 1));
+        return true;
+    }
+
+    bool ElfImage::checkSysv(void const *begin, std::size_t size, std::uint32_t &count) const noexcept {
+        if (!holds(begin, size, _sysv_hash, 2 * sizeof(std::uint32_t)))
+            return false;
+
+        std::uint32_t nbucket = _sysv_hash[0];
+        std::uint32_t nchain = _sysv_hash[1];
+        std::uint32_t const *table = _sysv_hash + 2;
+
+        if (!holds(begin, size, table, (std::uint64_t(nbucket) + nchain) * sizeof(std::uint32_t)))
+            return false;
+
+        for (std::uint64_t i = 0; i < std::uint64_t(nbucket) + nchain; ++i)
+            if (table[i] >= nchain)
+                return false;
+
+        count = std::max(count, nchain);
+        return true;
+    }
+}
@@ -0,0 +1,115 @@
+/**
+** \file ElfImage.hpp
+** Read-only view on the dynamic symbol table of a loaded ELF object.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 13:05
+** \date Last update: 2026-10-16 23:10
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef ElfImage_hpp_
+#define ElfImage_hpp_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <elf.h>
+#include <link.h>
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class ElfImage
+    ** \brief Symbol lookup over the tables of a mapped ELF object.
+    **
+    ** This class parses the dynamic section of an object, and keeps pointers
+    ** on it's .dynsym, .dynstr, .gnu.version, .gnu.hash and .hash tables.
+    ** Lookups only read these tables, which are never modified once the
+    ** object is mapped, so they don't need any lock, and never call into
+    ** libdl.
+    **
+    ** The object must stay mapped as long as the ElfImage is used. Objects
+    ** mapped by the dynamic linker are trusted. For others, fitsIn() checks
+    ** that the tables can be searched without reading outside the mapping.
+    */
+    class ElfImage {
+        public:
+            using Sym = ElfW(Sym);
+
+            ElfImage() noexcept;
+            ElfImage(ElfW(Addr) base, ElfW(Dyn) const *dynamic) noexcept;
+
+            [[nodiscard]]
+            bool isValid() const noexcept;
+            [[nodiscard]]
+            bool fitsIn(void const *begin, std::size_t size) const noexcept;
+
+            [[nodiscard]]
+            bool mayContain(std::uint32_t gnu_hash) const noexcept;
+            [[nodiscard]]
+            Sym const *findSymbol(char const *name) const noexcept;
+            [[nodiscard]]
+            Sym const *findSymbol(char const *name, std::uint32_t gnu_hash, std::uint32_t sysv_hash) const noexcept;
+
+            [[nodiscard]]
+            std::uint32_t getSymbolCount() const noexcept;
+            [[nodiscard]]
+            Sym const *getSymbol(std::uint32_t idx) const noexcept;
+            [[nodiscard]]
+            bool isHidden(std::uint32_t idx) const noexcept;
+
+            [[nodiscard]]
+            void *getAddress(Sym const *sym) const noexcept;
+            [[nodiscard]]
+            char const *getName(Sym const *sym) const noexcept;
+
+            [[nodiscard]]
+            char const *getString(ElfW(Xword) offset) const noexcept;
+            [[nodiscard]]
+            char const *getSoname() const noexcept;
+            [[nodiscard]]
+            ElfW(Addr) getBase() const noexcept;
+            [[nodiscard]]
+            ElfW(Dyn) const *getDynamic() const noexcept;
+            [[nodiscard]]
+            bool hasGnuHash() const noexcept;
+
+            static std::uint32_t gnuHash(char const *name) noexcept;
+            static std::uint32_t sysvHash(char const *name) noexcept;
+            static bool isDefined(Sym const *sym) noexcept;
+            static unsigned char symbolType(Sym const *sym) noexcept;
+            static unsigned char symbolBind(Sym const *sym) noexcept;
+
+        private:
+            template <typename T>
+            T const *relocate(ElfW(Addr) ptr) const noexcept;
+
+            bool matches(std::uint32_t idx, char const *name) const noexcept;
+            bool checkGnu(void const *begin, std::size_t size, std::uint32_t &count) const noexcept;
+            bool checkSysv(void const *begin, std::size_t size, std::uint32_t &count) const noexcept;
+            Sym const *findGnu(char const *name, std::uint32_t hash) const noexcept;
+            Sym const *findSysv(char const *name, std::uint32_t hash) const noexcept;
+
+        private:
+            ElfW(Addr) _base;
+            ElfW(Dyn) const *_dynamic;
+
+            Sym const *_symtab;
+            char const *_strtab;
+            ElfW(Half) const *_versym;
+            char const *_soname;
+
+            std::uint32_t const *_gnu_hash;
+            std::uint32_t _gnu_nbuckets;
+            std::uint32_t _gnu_symoffset;
+            std::uint32_t _gnu_bloom_size;
+            std::uint32_t _gnu_bloom_shift;
+            ElfW(Addr) const *_gnu_bloom;
+            std::uint32_t const *_gnu_buckets;
+            std::uint32_t const *_gnu_chain;
+
+            std::uint32_t const *_sysv_hash;
+    };
+}
+
+#endif
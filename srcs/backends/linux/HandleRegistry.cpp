@@ -0,0 +1,172 @@
+/**
+** \file HandleRegistry.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 17:30
+** \date Last update: 2026-10-16 23:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <iterator>
+
+#include <link.h>
+#include <sys/stat.h>
+
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
+#include "audit/LoadProfile.hpp"
+
+#include "./HandleRegistry.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /*
+    ** The registry is never destroyed: backends living in static objects
+    ** may still be released after exit() has started destroying statics.
+    */
+    HandleRegistry &HandleRegistry::instance() {
+        static HandleRegistry *registry = new HandleRegistry();
+
+        return *registry;
+    }
+
+    HandleRegistry::Shared HandleRegistry::open(std::string const &path, OpenFlags f) {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        auto known = _paths.find(path);
+        if (known != _paths.end()) {
+            if (Shared backend = known->second.lock()) {
+                promote(path, f);
+                return backend;
+            }
+            _paths.erase(known);
+        }
+
+        int flags = static_cast<int>(f);
+        void *hndl = nullptr;
+
+        {
+            utils::Trace::Span span(utils::Trace::Kind::Load, path);
+            utils::Metrics::Timer timer(utils::Metrics::Latency::Dlopen);
+
+            (void)dlerror();
+            hndl = dlopen(path.c_str(), flags | RTLD_NOLOAD);
+
+            if (hndl == nullptr && (flags & RTLD_NOLOAD) == 0) {
+                audit::LoadProfile::opening();
+                hndl = dlopen(path.c_str(), flags);
+                if (hndl != nullptr)
+                    audit::LoadProfile::opened();
+            }
+        }
+
+        if (hndl == nullptr) {
+            char *str = dlerror();
+
+            return failure(path, str != nullptr ? str : "Library is not loaded");
+        }
+
+        utils::Metrics::add(utils::Metrics::Counter::Opens);
+        return adopt(path, hndl);
+    }
+
+    std::size_t HandleRegistry::size() const {
+        std::lock_guard<std::mutex> lock(_lock);
+        std::size_t live = 0;
+
+        for (auto const &file : _files)
+            live += !file.second.expired();
+
+        return live;
+    }
+
+    /*
+    ** dlopen already returns the same handle for a given file, but every
+    ** call takes a reference on it. The extra one is dropped when the file
+    ** is already owned by a registered backend.
+    */
+    HandleRegistry::Shared HandleRegistry::adopt(std::string const &path, void *hndl) {
+        FileId id = {0, 0};
+        bool identified = identify(hndl, id);
+
+        if (identified) {
+            auto known = _files.find(id);
+
+            if (known != _files.end()) {
+                if (Shared backend = known->second.lock()) {
+                    dlclose(hndl);
+                    _paths[path] = backend;
+                    return backend;
+                }
+            }
+        }
+
+        Shared backend(new LinuxBackend(path, hndl), [](LinuxBackend const *b) {
+            HandleRegistry::instance().release(b);
+            delete b;
+        });
+
+        if (identified)
+            _files[id] = backend;
+        _paths[path] = backend;
+
+        return backend;
+    }
+
+    /*
+    ** By the time this is called, the weak references on the backend have
+    ** expired. Another thread may already have registered a new backend
+    ** for the same file, so only expired entries are dropped.
+    */
+    void HandleRegistry::release(LinuxBackend const *) noexcept {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        for (auto it = _files.begin(); it != _files.end();)
+            it = it->second.expired() ? _files.erase(it) : std::next(it);
+
+        for (auto it = _paths.begin(); it != _paths.end();)
+            it = it->second.expired() ? _paths.erase(it) : std::next(it);
+    }
+
+    HandleRegistry::Shared HandleRegistry::failure(std::string const &path, char const *error) {
+        auto backend = std::shared_ptr<LinuxBackend>(new LinuxBackend(path, nullptr));
+
+        backend->_has_error = true;
+        backend->_err_str = error;
+
+        return backend;
+    }
+
+    bool HandleRegistry::identify(void *hndl, FileId &id) noexcept {
+        struct link_map *lm = nullptr;
+        struct stat st;
+
+        if (dlinfo(hndl, RTLD_DI_LINKMAP, &lm) != 0 || lm == nullptr) {
+            (void)dlerror();
+            return false;
+        }
+
+        if (lm->l_name == nullptr || lm->l_name[0] == '\0' || stat(lm->l_name, &st) != 0)
+            return false;
+
+        id = {st.st_dev, st.st_ino};
+        return true;
+    }
+
+    /*
+    ** A repeat open may ask for a wider visibility than the first one. The
+    ** dynamic linker applies it to the resident object, so the handle
+    ** taken here can be dropped right away.
+    */
+    void HandleRegistry::promote(std::string const &path, OpenFlags f) noexcept {
+        int flags = static_cast<int>(f);
+
+        if ((flags & (RTLD_GLOBAL | RTLD_NODELETE)) == 0)
+            return;
+
+        void *hndl = dlopen(path.c_str(), flags | RTLD_NOLOAD);
+        if (hndl != nullptr)
+            dlclose(hndl);
+        else
+            (void)dlerror();
+    }
+}
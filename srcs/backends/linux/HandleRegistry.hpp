@@ -0,0 +1,89 @@
+/**
+** \file HandleRegistry.hpp
+** Process wide registry of shared library handles.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 17:30
+** \date Last update: 2026-10-16 17:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef HandleRegistry_hpp_
+#define HandleRegistry_hpp_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <sys/types.h>
+
+#include "./OpenFlags.hpp"
+#include "./LinuxBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class HandleRegistry
+    ** \brief Hands out shared LinuxBackend, one per loaded file.
+    **
+    ** Libraries are identified by the device and inode of the file the
+    ** dynamic linker mapped, so that every path leading to the same file,
+    ** such as a soname and its absolute path, share the same backend. The
+    ** path given to open() is also remembered, so repeat opens of that path
+    ** are answered without calling dlopen at all.
+    **
+    ** Before really loading a library, the registry probes it with
+    ** RTLD_NOLOAD, adopting it if the process already has it resident.
+    **
+    ** The registry only keeps weak references. A library is closed once
+    ** the last shared_ptr on its backend is dropped, and is then forgotten
+    ** by the registry.
+    **
+    ** Every member function is thread safe.
+    */
+    class HandleRegistry {
+        public:
+            /**
+            ** \brief Identity of a file on disk.
+            */
+            struct FileId {
+                dev_t dev;
+                ino_t ino;
+
+                constexpr bool operator<(FileId const &rhs) const noexcept {
+                    return dev < rhs.dev || (dev == rhs.dev && ino < rhs.ino);
+                }
+            };
+
+            using Shared = std::shared_ptr<LinuxBackend const>;
+
+            static HandleRegistry &instance();
+
+            HandleRegistry(HandleRegistry const &) = delete;
+            HandleRegistry &operator=(HandleRegistry const &) = delete;
+
+            [[nodiscard]]
+            Shared open(std::string const &path, OpenFlags f = OpenFlags::Default);
+
+            [[nodiscard]]
+            std::size_t size() const;
+
+        private:
+            HandleRegistry() = default;
+
+            Shared adopt(std::string const &path, void *hndl);
+            void release(LinuxBackend const *backend) noexcept;
+
+            static Shared failure(std::string const &path, char const *error);
+            static bool identify(void *hndl, FileId &id) noexcept;
+            static void promote(std::string const &path, OpenFlags f) noexcept;
+
+        private:
+            mutable std::mutex _lock;
+            std::map<FileId, std::weak_ptr<LinuxBackend const>> _files;
+            std::unordered_map<std::string, std::weak_ptr<LinuxBackend const>> _paths;
+    };
+}
+
+#endif
@@ -3,30 +3,122 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2020-04-28 16:36
-** \date Last update: 2020-04-28 16:36
+** \date Last update: 2026-10-16 23:30
 ** \copyright GNU Lesser Public Licence v3
 */
 
+#include <cstring>
+#include <deque>
+
+#include <fcntl.h>
+#include <link.h>
+#include <unistd.h>
+
+#include "utils/Epoch.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
+#include "audit/LoadProfile.hpp"
+
 #include "./LinuxBackend.hpp"
 
 namespace clonixin::dynamicloader::backends::_linux {
-    LinuxBackend::LinuxBackend() noexcept {}
+    namespace {
+        struct LoadedObject {
+            ElfW(Addr) base;
+            ElfW(Dyn) const *dynamic;
+            char const *name;
+        };
+
+        struct NamespaceWalk {
+            struct link_map const *origin;
+            std::vector<LoadedObject> *objects;
+        };
+
+        /*
+        ** dl_iterate_phdr holds the loader write lock while calling us, which
+        ** prevents any object from being added to or removed from the link
+        ** map lists, so the namespace of origin can be walked safely.
+        */
+        int walkNamespace(struct dl_phdr_info *, std::size_t, void *data) {
+            NamespaceWalk *walk = static_cast<NamespaceWalk *>(data);
+            struct link_map const *lm = walk->origin;
+
+            while (lm->l_prev != nullptr)
+                lm = lm->l_prev;
+
+            for (; lm != nullptr; lm = lm->l_next)
+                walk->objects->push_back({lm->l_addr, lm->l_ld, lm->l_name});
+
+            return 1;
+        }
+
+        char const *baseName(char const *path) {
+            char const *slash = std::strrchr(path, '/');
+
+            return slash == nullptr ? path : slash + 1;
+        }
+
+        /*
+        ** The name is only looked up when tracing, and copied by the span
+        ** before dlclose frees it.
+        */
+        void closeHandle(void *hndl) {
+            struct link_map *lm = nullptr;
+
+            if (utils::Trace::isEnabled() && dlinfo(hndl, RTLD_DI_LINKMAP, &lm) != 0)
+                lm = nullptr;
+
+            utils::Trace::Span span(utils::Trace::Kind::Close, lm != nullptr ? lm->l_name : "");
+            utils::Metrics::Timer timer(utils::Metrics::Latency::Dlclose);
+
+            dlclose(hndl);
+            utils::Metrics::add(utils::Metrics::Counter::Closes);
+        }
+
+        void *timedOpen(char const *path, int flags) {
+            utils::Trace::Span span(utils::Trace::Kind::Load, path);
+            utils::Metrics::Timer timer(utils::Metrics::Latency::Dlopen);
+
+            audit::LoadProfile::opening();
+            void *hndl = dlopen(path, flags);
+
+            if (hndl != nullptr) {
+                audit::LoadProfile::opened();
+                utils::Metrics::add(utils::Metrics::Counter::Opens);
+            }
+
+            return hndl;
+        }
+
+        void *timedSym(void *hndl, char const *name) {
+            utils::Trace::Span span(utils::Trace::Kind::Resolve, name);
+            utils::Metrics::Timer timer(utils::Metrics::Latency::Dlsym);
+
+            return dlsym(hndl, name);
+        }
+    }
+
+    LinuxBackend::LinuxBackend() noexcept
+    : _hndl(nullptr), _has_error(false), _index(nullptr), _lookup_scope(nullptr) {}
 
     LinuxBackend::LinuxBackend(std::string const &path, void *hndl) noexcept
-    : _path(path), _hndl(hndl), _has_error(false), _err_str()
+    : _path(path), _hndl(hndl), _has_error(false), _err_str(),
+    _index(nullptr), _lookup_scope(nullptr)
     {}
 
     LinuxBackend::LinuxBackend(std::string const &path, OpenFlags f) noexcept
-    : _path(path) {
+    : _path(path), _index(nullptr), _lookup_scope(nullptr) {
         resetError();
-        _hndl = dlopen(path.c_str(), static_cast<int>(f));
+        _hndl = timedOpen(path.c_str(), static_cast<int>(f));
 
         symbolError();
     }
 
     LinuxBackend::LinuxBackend(LinuxBackend &&oth) noexcept :
     _path(std::move(oth._path)), _hndl(oth._hndl),
-    _has_error(oth._has_error), _err_str(std::move(oth._err_str)) {
+    _has_error(oth._has_error), _err_str(std::move(oth._err_str)),
+    _index(oth._index.exchange(nullptr)),
+    _lookup_scope(oth._lookup_scope.exchange(nullptr)) {
         oth._hndl = nullptr;
         oth._has_error = false;
         oth._err_str.clear();
@@ -34,12 +126,19 @@ namespace clonixin::dynamicloader::backends::_linux {
     }
 
     LinuxBackend::~LinuxBackend() {
-       if ( _hndl != nullptr and _hndl != GlobHndl && _hndl != NextHndl)
-           dlclose(_hndl);
+       dropDerived();
+       retireHandle(_hndl);
     }
 
+    /*
+    ** The previous handle is retired, as the destructor does, along with
+    ** everything derived from it.
+    */
     LinuxBackend &LinuxBackend::operator=(LinuxBackend &&rhs) noexcept {
         if (!(this == std::addressof(rhs))) {
+            dropDerived();
+            retireHandle(_hndl);
+
             _path = std::move(rhs._path);
 
             _hndl = rhs._hndl;
@@ -50,6 +149,9 @@ namespace clonixin::dynamicloader::backends::_linux {
 
             _err_str = std::move(rhs._err_str);
             rhs._err_str.clear();
+
+            _index.store(rhs._index.exchange(nullptr));
+            _lookup_scope.store(rhs._lookup_scope.exchange(nullptr));
         }
 
         return *this;
@@ -58,35 +160,102 @@ namespace clonixin::dynamicloader::backends::_linux {
     bool LinuxBackend::reset(std::string const &path, OpenFlags f) noexcept {
         resetError();
 
-        void *new_hndl = dlopen(path.c_str(), static_cast<int>(f));
+        void *new_hndl = timedOpen(path.c_str(), static_cast<int>(f));
 
         symbolError();
-        if (!_has_error) {
-            dlclose(_hndl);
-            _hndl = new_hndl;
-        }
+        if (!_has_error)
+            adoptHandle(new_hndl, path);
 
         return !_has_error;
     }
 
+    /*
+    ** dlopen maps and relocates libraries while holding a process wide
+    ** lock. Asking the kernel to read the file ahead, before taking it,
+    ** lets the disk I/O of a library overlap with the relocation of
+    ** another one. Bare sonames are searched by the dynamic linker, and
+    ** are left alone.
+    */
+    void LinuxBackend::prefetch(std::string const &path) noexcept {
+        if (path.find('/') == std::string::npos)
+            return;
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        ::close(fd);
+    }
+
     std::string LinuxBackend::getPath() const noexcept {
         return _path;
     }
 
-    bool LinuxBackend::hasSymbol(std::string const &name) noexcept {
+    bool LinuxBackend::hasSymbol(utils::ZStringView name) noexcept {
+        if (!mayContainSymbol(name)) {
+            _has_error = true;
+            _err_str.clear();
+            return false;
+        }
+
         (void)getSymbol(name);
 
         return !_has_error;
     }
 
-    LinuxBackend::SymAddr LinuxBackend::getSymbol(std::string const &name) noexcept {
+    LinuxBackend::SymAddr LinuxBackend::getSymbol(utils::ZStringView name) noexcept {
         resetError();
-        void *sym = dlsym(_hndl, name.c_str());
+        void *sym = timedSym(_hndl, name.c_str());
 
         symbolError();
         return sym != NULL ? sym : nullptr;
     }
 
+    /*
+    ** dlerror() keeps it's state per thread, so checking it right after
+    ** dlsym is safe, whatever the other threads are doing.
+    */
+    LinuxBackend::Lookup LinuxBackend::lookupSymbol(utils::ZStringView name) const noexcept {
+        (void)dlerror();
+        void *sym = timedSym(_hndl, name.c_str());
+
+        if (sym == NULL) {
+            char *str = dlerror();
+
+            if (str != NULL)
+                return {nullptr, true, str};
+        }
+
+        return {sym != NULL ? sym : nullptr, false, std::string()};
+    }
+
+    bool LinuxBackend::containsSymbol(utils::ZStringView name) const noexcept {
+        if (!mayContainSymbol(name))
+            return false;
+
+        return !lookupSymbol(name).has_error;
+    }
+
+    std::size_t LinuxBackend::getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept {
+        std::size_t missing = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            (void)dlerror();
+            void *sym = timedSym(_hndl, names[i].c_str());
+            char *str = sym == NULL ? dlerror() : NULL;
+
+            failed[i] = str != NULL;
+            if (failed[i]) {
+                errors[i] = str;
+                ++missing;
+            }
+            out[i] = sym != NULL ? sym : nullptr;
+        }
+
+        return missing;
+    }
+
     bool LinuxBackend::hasError() const noexcept {
         return _has_error;
     }
@@ -95,6 +264,171 @@ namespace clonixin::dynamicloader::backends::_linux {
         return _err_str;
     }
 
+    /*
+    ** Several threads may build the index at the same time. The first one
+    ** to publish it wins, and the others drop their copy.
+    */
+    SymbolIndex const &LinuxBackend::getSymbolIndex() const {
+        SymbolIndex const *index = _index.load(std::memory_order_acquire);
+
+        if (index == nullptr) {
+            SymbolIndex const *built = new SymbolIndex(getImage());
+
+            if (_index.compare_exchange_strong(index, built, std::memory_order_acq_rel, std::memory_order_acquire))
+                index = built;
+            else
+                delete built;
+        }
+
+        return *index;
+    }
+
+    LinuxBackend::LookupScope const &LinuxBackend::getLookupScope() const noexcept {
+        LookupScope const *scope = _lookup_scope.load(std::memory_order_acquire);
+
+        if (scope == nullptr) {
+            LookupScope const *built = buildScope();
+
+            if (_lookup_scope.compare_exchange_strong(scope, built, std::memory_order_acq_rel, std::memory_order_acquire))
+                scope = built;
+            else
+                delete built;
+        }
+
+        return *scope;
+    }
+
+    /*
+    ** The scope is left empty, meaning unknown, for the first object of a
+    ** namespace, such as the program itself: its search list is the global
+    ** scope of the namespace, which also holds LD_PRELOAD objects and every
+    ** library opened with RTLD_GLOBAL since, none of them being reachable
+    ** through DT_NEEDED entries.
+    */
+    LinuxBackend::LookupScope *LinuxBackend::buildScope() const noexcept {
+        struct link_map *origin = nullptr;
+        std::vector<LoadedObject> objects;
+        LookupScope *scope = new LookupScope{{}, false};
+
+        if (_hndl == nullptr || _hndl == GlobHndl || _hndl == NextHndl || dlinfo(_hndl, RTLD_DI_LINKMAP, &origin) != 0 || origin == nullptr) {
+            (void)dlerror();
+            return scope;
+        }
+        if (origin->l_prev == nullptr)
+            return scope;
+
+        NamespaceWalk walk = {origin, &objects};
+        dl_iterate_phdr(&walkNamespace, &walk);
+
+        std::vector<ElfImage> images;
+        std::vector<bool> visited(objects.size(), false);
+        std::deque<std::size_t> queue;
+
+        images.reserve(objects.size());
+        for (auto const &obj : objects) {
+            images.emplace_back(obj.base, obj.dynamic);
+
+            if (obj.base == origin->l_addr && obj.dynamic == origin->l_ld) {
+                visited[images.size() - 1] = true;
+                queue.push_back(images.size() - 1);
+            }
+        }
+
+        while (!queue.empty()) {
+            std::size_t idx = queue.front();
+            ElfImage const &image = images[idx];
+
+            queue.pop_front();
+            if (!image.isValid())
+                continue;
+
+            scope->images.push_back(image);
+            scope->needs_sysv = scope->needs_sysv || !image.hasGnuHash();
+
+            for (ElfW(Dyn) const *dyn = image.getDynamic(); dyn->d_tag != DT_NULL; ++dyn) {
+                if (dyn->d_tag != DT_NEEDED)
+                    continue;
+
+                char const *needed = image.getString(dyn->d_un.d_val);
+
+                for (std::size_t dep = 0; dep < images.size(); ++dep) {
+                    char const *soname = images[dep].getSoname();
+                    bool same = soname != nullptr ? std::strcmp(soname, needed) == 0
+                        : std::strcmp(baseName(objects[dep].name), baseName(needed)) == 0;
+
+                    if (same) {
+                        if (!visited[dep]) {
+                            visited[dep] = true;
+                            queue.push_back(dep);
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        return scope;
+    }
+
+    /*
+    ** A name rejected by the GNU hash bloom filter of every object of the
+    ** lookup scope can't be found by dlsym. With an unknown scope, every
+    ** name may be found. Callers don't build any error message in that
+    ** case, to keep the negative path free of any allocation.
+    */
+    bool LinuxBackend::mayContainSymbol(utils::ZStringView name) const noexcept {
+        LookupScope const &scope = getLookupScope();
+
+        if (scope.images.empty())
+            return true;
+
+        std::uint32_t hash = ElfImage::gnuHash(name.c_str());
+
+        for (ElfImage const &image : scope.images)
+            if (image.mayContain(hash))
+                return true;
+
+        return false;
+    }
+
+    ElfImage LinuxBackend::getImage() const noexcept {
+        struct link_map *lm = nullptr;
+
+        if (_hndl == nullptr || _hndl == GlobHndl || _hndl == NextHndl
+                || dlinfo(_hndl, RTLD_DI_LINKMAP, &lm) != 0 || lm == nullptr) {
+            (void)dlerror();
+            return ElfImage();
+        }
+
+        return ElfImage(lm->l_addr, lm->l_ld);
+    }
+
+    void LinuxBackend::dropDerived() noexcept {
+        delete _index.exchange(nullptr);
+        delete _lookup_scope.exchange(nullptr);
+    }
+
+    /*
+    ** Other threads may still be running code of the library, or reading
+    ** its data. The handle is only closed once every thread pinned in the
+    ** epoch at this point has unpinned.
+    */
+    void LinuxBackend::retireHandle(void *hndl) noexcept {
+        if (hndl != nullptr && hndl != GlobHndl && hndl != NextHndl)
+            utils::Epoch::retire(&closeHandle, hndl);
+    }
+
+    /*
+    ** Replaces the handle by one opened by the caller, retiring the
+    ** previous one, along with everything derived from it.
+    */
+    void LinuxBackend::adoptHandle(void *hndl, std::string const &path) noexcept {
+        dropDerived();
+        retireHandle(_hndl);
+        _hndl = hndl;
+        _path = path;
+    }
+
     void LinuxBackend::resetError() {
         _has_error = false;
         _err_str.clear();
@@ -104,7 +438,11 @@ namespace clonixin::dynamicloader::backends::_linux {
 
     void LinuxBackend::symbolError() {
         char *str = dlerror();
-        _err_str = (str == NULL ? std::string() : str);
+
+        if (str == NULL)
+            _err_str.clear();
+        else
+            _err_str.assign(str);
         _has_error = !_err_str.empty();
     }
 
@@ -4,22 +4,50 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2020-04-28 16:36
-** \date Last update: 2020-04-29 02:23
+** \date Last update: 2026-10-16 23:40
 ** \copyright GNU Lesser Public Licence v3
 */
 
 #ifndef LinuxBackend_hpp_
 #define LinuxBackend_hpp_
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <dlfcn.h>
 
+#include "utils/ZStringView.hpp"
+
 #include "./OpenFlags.hpp"
+#include "./ElfImage.hpp"
+#include "./SymbolIndex.hpp"
 
 namespace clonixin::dynamicloader::backends::_linux {
     using namespace std::string_literals;
 
+    class HandleRegistry;
+
+    /**
+    ** \class LinuxBackend
+    ** \brief Default linux backend, using dlopen and dlsym.
+    **
+    ** Besides the stateful getSymbol() and hasSymbol() functions, which
+    ** store their error in the backend, this backend provides
+    ** lookupSymbol() and containsSymbol(), which are const, return their
+    ** error by value, and can be called concurrently from any number of
+    ** threads, as can getSymbols() and getSymbolIndex().
+    **
+    ** Data derived from the handle, that is the lookup scope used by
+    ** containsSymbol() and the symbol index, is built on first use, and
+    ** published atomically, so const member functions never modify any
+    ** state visible to other threads.
+    **
+    ** The destructor and reset() don't close the handle right away, but
+    ** retire it through utils::Epoch: threads calling into the library
+    ** within an utils::EpochGuard keep it loaded until they leave.
+    */
     class LinuxBackend {
         inline static const std::string InternalPath = "Program Internal"s;
 #ifdef __USE_GNU
@@ -37,6 +65,15 @@ namespace clonixin::dynamicloader::backends::_linux {
         public:
 
             using SymAddr = void *;
+
+            /**
+            ** \brief Result of a lookup, returned by lookupSymbol().
+            */
+            struct Lookup {
+                SymAddr sym;
+                bool has_error;
+                std::string error;
+            };
         public:
             LinuxBackend(std::string const &path, OpenFlags f = OpenFlags::Default) noexcept;
             LinuxBackend(LinuxBackend const &) = delete;
@@ -49,32 +86,65 @@ namespace clonixin::dynamicloader::backends::_linux {
 
             bool reset(std::string const &path, OpenFlags f = OpenFlags::Default) noexcept;
 
+            static void prefetch(std::string const &path) noexcept;
+
             [[nodiscard]]
             std::string getPath() const noexcept;
 
             [[nodiscard]]
-            bool hasSymbol(std::string const &name) noexcept;
+            bool hasSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            SymAddr getSymbol(utils::ZStringView name) noexcept;
             [[nodiscard]]
-            SymAddr getSymbol(std::string const &name) noexcept;
+            Lookup lookupSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool containsSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool mayContainSymbol(utils::ZStringView name) const noexcept;
+            std::size_t getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept;
 
             [[nodiscard]]
             bool hasError() const noexcept;
             std::string getLastError() const noexcept;
 
+            [[nodiscard]]
+            SymbolIndex const &getSymbolIndex() const;
+
         protected:
+            /**
+            ** \brief Objects searched by dlsym for the handle, in order.
+            */
+            struct LookupScope {
+                std::vector<ElfImage> images;
+                bool needs_sysv;
+            };
+
             LinuxBackend() noexcept;
             void resetError();
             void symbolError();
+            void adoptHandle(void *hndl, std::string const &path) noexcept;
+            void retireHandle(void *hndl) noexcept;
+            ElfImage getImage() const noexcept;
+            LookupScope const &getLookupScope() const noexcept;
 
         private:
             LinuxBackend(std::string const &path, void *hndl) noexcept;
 
+            LookupScope *buildScope() const noexcept;
+            void dropDerived() noexcept;
+
         protected:
             std::string _path;
 
             void * _hndl;
             bool _has_error;
             std::string _err_str;
+
+        private:
+            mutable std::atomic<SymbolIndex const *> _index;
+            mutable std::atomic<LookupScope const *> _lookup_scope;
+
+            friend HandleRegistry;
     };
 }
 
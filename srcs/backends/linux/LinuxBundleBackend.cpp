@@ -0,0 +1,117 @@
+/**
+** \file LinuxBundleBackend.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:50
+** \date Last update: 2026-10-16 22:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include "./LinuxBundleBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    LinuxBundleBackend::LinuxBundleBackend(std::string const &name, Bundle const &bundle, OpenFlags f) noexcept
+    : _bundle(&bundle) {
+        _path = "memfd:" + name;
+        (void)reset(name, f);
+    }
+
+    LinuxBundleBackend::LinuxBundleBackend(LinuxBundleBackend &&oth) noexcept
+    : LinuxMemoryBackend(std::move(oth)), _bundle(oth._bundle), _id(oth._id) {
+        oth._id = BuildId();
+    }
+
+    LinuxBundleBackend::~LinuxBundleBackend() {}
+
+    LinuxBundleBackend &LinuxBundleBackend::operator=(LinuxBundleBackend &&rhs) noexcept {
+        if (this != std::addressof(rhs)) {
+            static_cast<LinuxMemoryBackend &>(*this) = std::move(static_cast<LinuxMemoryBackend &>(rhs));
+
+            _bundle = rhs._bundle;
+            _id = rhs._id;
+            rhs._id = BuildId();
+        }
+
+        return *this;
+    }
+
+    /*
+    ** On failure, the previous plugin is kept, as LinuxBackend does.
+    */
+    bool LinuxBundleBackend::reset(std::string const &name, OpenFlags f) noexcept {
+        Bundle::Entry entry;
+        bool opened = false;
+
+        if (!_bundle->find(name, entry)) {
+            _has_error = true;
+            try {
+                _err_str = _bundle->getPath() + ": no plugin named " + name;
+            } catch (...) {
+                _err_str.clear();
+            }
+            return false;
+        }
+
+        if (entry.compression == Bundle::Compression::None) {
+            opened = LinuxMemoryBackend::reset(_bundle->getFd(), static_cast<off_t>(entry.offset), entry.size, name, f);
+        } else {
+            Bundle const *bundle = _bundle;
+
+            opened = LinuxMemoryBackend::reset(entry.size, [bundle, &entry](unsigned char *out) {
+                return bundle->extract(entry, out);
+            }, name, f);
+        }
+
+        if (opened)
+            _id = entry.id;
+
+        return opened;
+    }
+
+    std::string LinuxBundleBackend::getPath() const noexcept {
+        return LinuxMemoryBackend::getPath();
+    }
+
+    bool LinuxBundleBackend::hasSymbol(utils::ZStringView name) noexcept {
+        return LinuxMemoryBackend::hasSymbol(name);
+    }
+
+    LinuxBundleBackend::SymAddr LinuxBundleBackend::getSymbol(utils::ZStringView name) noexcept {
+        return LinuxMemoryBackend::getSymbol(name);
+    }
+
+    LinuxBundleBackend::Lookup LinuxBundleBackend::lookupSymbol(utils::ZStringView name) const noexcept {
+        return LinuxMemoryBackend::lookupSymbol(name);
+    }
+
+    bool LinuxBundleBackend::containsSymbol(utils::ZStringView name) const noexcept {
+        return LinuxMemoryBackend::containsSymbol(name);
+    }
+
+    bool LinuxBundleBackend::mayContainSymbol(utils::ZStringView name) const noexcept {
+        return LinuxMemoryBackend::mayContainSymbol(name);
+    }
+
+    std::size_t LinuxBundleBackend::getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept {
+        return LinuxMemoryBackend::getSymbols(names, count, out, failed, errors);
+    }
+
+    bool LinuxBundleBackend::hasError() const noexcept {
+        return LinuxMemoryBackend::hasError();
+    }
+
+    std::string LinuxBundleBackend::getLastError() const noexcept {
+        return LinuxMemoryBackend::getLastError();
+    }
+
+    SymbolIndex const &LinuxBundleBackend::getSymbolIndex() const {
+        return LinuxMemoryBackend::getSymbolIndex();
+    }
+
+    /*
+    ** The build-id recorded in the index for the opened plugin.
+    */
+    BuildId const &LinuxBundleBackend::getBuildId() const noexcept {
+        return _id;
+    }
+}
@@ -0,0 +1,86 @@
+/**
+** \file LinuxBundleBackend.hpp
+** Linux backend opening the plugins of a bundle.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:50
+** \date Last update: 2026-10-16 23:35
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef LinuxBundleBackend_hpp_
+#define LinuxBundleBackend_hpp_
+
+#include <string>
+
+#include "./OpenFlags.hpp"
+#include "./Bundle.hpp"
+#include "./LinuxMemoryBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class LinuxBundleBackend
+    ** \brief Backend opening a plugin of a Bundle, by name.
+    **
+    ** The image of the plugin is put in a sealed memory file, then opened,
+    ** as LinuxMemoryBackend does: a stored image is copied by the kernel
+    ** from the bundle file, a compressed one is decompressed straight into
+    ** the memory file. Only the pages of the bundle holding the plugin are
+    ** read.
+    **
+    ** The backend keeps a pointer to the bundle, used by reset() to open
+    ** another plugin: the bundle must outlive the backend.
+    **
+    ** \warning Loads are never shared. Opening the same plugin twice, from
+    ** the same bundle or not, maps two independent copies of it, each with
+    ** its own globals and running its own initializers. To use a single
+    ** copy, open the plugin once, and share the backend.
+    */
+    class LinuxBundleBackend : protected LinuxMemoryBackend {
+        public:
+            using SymAddr = LinuxMemoryBackend::SymAddr;
+            using Lookup = LinuxMemoryBackend::Lookup;
+
+            LinuxBundleBackend(std::string const &name, Bundle const &bundle, OpenFlags f = OpenFlags::Default) noexcept;
+            LinuxBundleBackend(LinuxBundleBackend const &) = delete;
+            LinuxBundleBackend(LinuxBundleBackend &&oth) noexcept;
+
+            virtual ~LinuxBundleBackend();
+
+            LinuxBundleBackend &operator=(LinuxBundleBackend const &) = delete;
+            LinuxBundleBackend &operator=(LinuxBundleBackend &&rhs) noexcept;
+
+            bool reset(std::string const &name, OpenFlags f = OpenFlags::Default) noexcept;
+
+            [[nodiscard]]
+            std::string getPath() const noexcept;
+
+            [[nodiscard]]
+            bool hasSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            SymAddr getSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            Lookup lookupSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool containsSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool mayContainSymbol(utils::ZStringView name) const noexcept;
+            std::size_t getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept;
+
+            [[nodiscard]]
+            bool hasError() const noexcept;
+            std::string getLastError() const noexcept;
+
+            [[nodiscard]]
+            SymbolIndex const &getSymbolIndex() const;
+
+            [[nodiscard]]
+            BuildId const &getBuildId() const noexcept;
+
+        private:
+            Bundle const *_bundle;
+            BuildId _id;
+    };
+}
+
+#endif
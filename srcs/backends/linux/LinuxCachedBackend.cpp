@@ -0,0 +1,168 @@
+/**
+** \file LinuxCachedBackend.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:10
+** \date Last update: 2026-10-16 22:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include "./LinuxCachedBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    LinuxCachedBackend::LinuxCachedBackend(std::string const &path, OffsetCache &cache, OpenFlags f) noexcept
+    : LinuxBackend(path, f), _cache(&cache) {
+        if (!_has_error)
+            attach();
+    }
+
+    LinuxCachedBackend::LinuxCachedBackend(LinuxCachedBackend &&oth) noexcept
+    : LinuxBackend(std::move(oth)), _cache(oth._cache), _id(oth._id), _image(oth._image), _view(oth._view) {
+        oth._id = BuildId();
+        oth._image = ElfImage();
+        oth._view = OffsetCache::View();
+    }
+
+    LinuxCachedBackend::~LinuxCachedBackend() {}
+
+    LinuxCachedBackend &LinuxCachedBackend::operator=(LinuxCachedBackend &&rhs) noexcept {
+        if (this != std::addressof(rhs)) {
+            static_cast<LinuxBackend &>(*this) = std::move(static_cast<LinuxBackend &>(rhs));
+
+            _cache = rhs._cache;
+            _id = rhs._id;
+            _image = rhs._image;
+            _view = rhs._view;
+            rhs._id = BuildId();
+            rhs._image = ElfImage();
+            rhs._view = OffsetCache::View();
+        }
+
+        return *this;
+    }
+
+    bool LinuxCachedBackend::reset(std::string const &path, OpenFlags f) noexcept {
+        if (!LinuxBackend::reset(path, f))
+            return false;
+
+        attach();
+        return true;
+    }
+
+    std::string LinuxCachedBackend::getPath() const noexcept {
+        return LinuxBackend::getPath();
+    }
+
+    bool LinuxCachedBackend::hasSymbol(utils::ZStringView name) noexcept {
+        if (!mayContainSymbol(name)) {
+            _has_error = true;
+            _err_str.clear();
+            return false;
+        }
+
+        (void)getSymbol(name);
+
+        return !_has_error;
+    }
+
+    LinuxCachedBackend::SymAddr LinuxCachedBackend::getSymbol(utils::ZStringView name) noexcept {
+        _has_error = false;
+        _err_str.clear();
+
+        SymAddr sym = lookup(name, &_err_str);
+        _has_error = !_err_str.empty();
+
+        return sym;
+    }
+
+    LinuxCachedBackend::Lookup LinuxCachedBackend::lookupSymbol(utils::ZStringView name) const noexcept {
+        Lookup result{nullptr, false, std::string()};
+
+        result.sym = lookup(name, &result.error);
+        result.has_error = !result.error.empty();
+
+        return result;
+    }
+
+    bool LinuxCachedBackend::containsSymbol(utils::ZStringView name) const noexcept {
+        if (!mayContainSymbol(name))
+            return false;
+
+        return !lookupSymbol(name).has_error;
+    }
+
+    bool LinuxCachedBackend::mayContainSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::mayContainSymbol(name);
+    }
+
+    std::size_t LinuxCachedBackend::getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept {
+        std::size_t missing = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lookup(names[i], errors + i);
+            failed[i] = !errors[i].empty();
+            missing += failed[i];
+        }
+
+        return missing;
+    }
+
+    bool LinuxCachedBackend::hasError() const noexcept {
+        return LinuxBackend::hasError();
+    }
+
+    std::string LinuxCachedBackend::getLastError() const noexcept {
+        return LinuxBackend::getLastError();
+    }
+
+    SymbolIndex const &LinuxCachedBackend::getSymbolIndex() const {
+        return LinuxBackend::getSymbolIndex();
+    }
+
+    BuildId const &LinuxCachedBackend::getBuildId() const noexcept {
+        return _id;
+    }
+
+    /*
+    ** Called whenever the handle changes. A cached entry is only used if
+    ** both the build-id and the extent of the object match.
+    */
+    void LinuxCachedBackend::attach() noexcept {
+        std::uint64_t extent = 0;
+
+        _id = OffsetCache::readBuildId(_hndl, &extent);
+        _image = _id.isValid() ? getImage() : ElfImage();
+        if (!_image.isValid())
+            _id = BuildId();
+
+        _view = _cache->attach(_id, _path, extent);
+    }
+
+    /*
+    ** A symbol resolved by dlsym is only recorded if the library's own
+    ** table defines it at the very address dlsym returned.
+    */
+    LinuxCachedBackend::SymAddr LinuxCachedBackend::lookup(utils::ZStringView name, std::string *error) const noexcept {
+        std::uint64_t offset = 0;
+
+        if (_cache->find(_view, name, offset))
+            return reinterpret_cast<SymAddr>(_image.getBase() + offset);
+
+        Lookup result = LinuxBackend::lookupSymbol(name);
+
+        if (result.has_error) {
+            *error = std::move(result.error);
+            return nullptr;
+        }
+
+        if (_id.isValid() && result.sym != nullptr) {
+            ElfImage::Sym const *sym = _image.findSymbol(name.c_str());
+
+            if (sym != nullptr && ElfImage::symbolType(sym) != STT_TLS && ElfImage::symbolType(sym) != STT_GNU_IFUNC
+                    && _image.getAddress(sym) == result.sym)
+                _cache->record(_id, name, sym->st_value);
+        }
+
+        return result.sym;
+    }
+}
@@ -0,0 +1,94 @@
+/**
+** \file LinuxCachedBackend.hpp
+** Linux backend serving symbols from a persistent offset cache.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:10
+** \date Last update: 2026-10-16 22:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef LinuxCachedBackend_hpp_
+#define LinuxCachedBackend_hpp_
+
+#include <string>
+
+#include "./OpenFlags.hpp"
+#include "./LinuxBackend.hpp"
+#include "./ElfImage.hpp"
+#include "./OffsetCache.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class LinuxCachedBackend
+    ** \brief Backend resolving the symbols found by previous runs without
+    ** calling dlsym.
+    **
+    ** The library is opened with dlopen, like LinuxBackend does, and its
+    ** build-id is read from its NT_GNU_BUILD_ID note. Symbols the
+    ** OffsetCache holds for this build-id are served as the load base of
+    ** the library plus their offset. Other symbols go through dlsym, and
+    ** are recorded in the cache when they are defined by the library
+    ** itself, so that OffsetCache::save() persists them for the next run.
+    **
+    ** Symbols defined by a dependency, thread local (STT_TLS) and indirect
+    ** (STT_GNU_IFUNC) symbols are never recorded, as their address doesn't
+    ** only depend on the library's content and base. Neither are symbols
+    ** of a library without build-id.
+    **
+    ** The cache must outlive the backend.
+    */
+    class LinuxCachedBackend : protected LinuxBackend {
+        public:
+            using SymAddr = LinuxBackend::SymAddr;
+            using Lookup = LinuxBackend::Lookup;
+
+            LinuxCachedBackend(std::string const &path, OffsetCache &cache, OpenFlags f = OpenFlags::Default) noexcept;
+            LinuxCachedBackend(LinuxCachedBackend const &) = delete;
+            LinuxCachedBackend(LinuxCachedBackend &&oth) noexcept;
+
+            virtual ~LinuxCachedBackend();
+
+            LinuxCachedBackend &operator=(LinuxCachedBackend const &) = delete;
+            LinuxCachedBackend &operator=(LinuxCachedBackend &&rhs) noexcept;
+
+            bool reset(std::string const &path, OpenFlags f = OpenFlags::Default) noexcept;
+
+            [[nodiscard]]
+            std::string getPath() const noexcept;
+
+            [[nodiscard]]
+            bool hasSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            SymAddr getSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            Lookup lookupSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool containsSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool mayContainSymbol(utils::ZStringView name) const noexcept;
+            std::size_t getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept;
+
+            [[nodiscard]]
+            bool hasError() const noexcept;
+            std::string getLastError() const noexcept;
+
+            [[nodiscard]]
+            SymbolIndex const &getSymbolIndex() const;
+
+            [[nodiscard]]
+            BuildId const &getBuildId() const noexcept;
+
+        private:
+            void attach() noexcept;
+            SymAddr lookup(utils::ZStringView name, std::string *error) const noexcept;
+
+        private:
+            OffsetCache *_cache;
+            BuildId _id;
+            ElfImage _image;
+            OffsetCache::View _view;
+    };
+}
+
+#endif
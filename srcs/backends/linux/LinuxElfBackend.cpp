@@ -0,0 +1,155 @@
+/**
+** \file LinuxElfBackend.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 13:05
+** \date Last update: 2026-10-16 22:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include "./LinuxElfBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    LinuxElfBackend::LinuxElfBackend(std::string const &path, OpenFlags f) noexcept
+    : LinuxBackend(path, f) {
+        if (!_has_error)
+            (void)getLookupScope();
+    }
+
+    LinuxElfBackend::LinuxElfBackend(LinuxElfBackend &&oth) noexcept
+    : LinuxBackend(std::move(oth)) {}
+
+    LinuxElfBackend::~LinuxElfBackend() {}
+
+    LinuxElfBackend &LinuxElfBackend::operator=(LinuxElfBackend &&rhs) noexcept {
+        if (this != std::addressof(rhs)) {
+            static_cast<LinuxBackend &>(*this) = std::move(static_cast<LinuxBackend &>(rhs));
+        }
+
+        return *this;
+    }
+
+    bool LinuxElfBackend::reset(std::string const &path, OpenFlags f) noexcept {
+        if (!LinuxBackend::reset(path, f))
+            return false;
+
+        (void)getLookupScope();
+        return true;
+    }
+
+    std::string LinuxElfBackend::getPath() const noexcept {
+        return LinuxBackend::getPath();
+    }
+
+    bool LinuxElfBackend::hasSymbol(utils::ZStringView name) noexcept {
+        if (!mayContainSymbol(name)) {
+            _has_error = true;
+            _err_str.clear();
+            return false;
+        }
+
+        (void)getSymbol(name);
+
+        return !_has_error;
+    }
+
+    LinuxElfBackend::SymAddr LinuxElfBackend::getSymbol(utils::ZStringView name) noexcept {
+        _has_error = false;
+        _err_str.clear();
+
+        SymAddr sym = lookup(name, &_err_str);
+        _has_error = !_err_str.empty();
+
+        return sym;
+    }
+
+    LinuxElfBackend::Lookup LinuxElfBackend::lookupSymbol(utils::ZStringView name) const noexcept {
+        Lookup result{nullptr, false, std::string()};
+
+        result.sym = lookup(name, &result.error);
+        result.has_error = !result.error.empty();
+
+        return result;
+    }
+
+    bool LinuxElfBackend::containsSymbol(utils::ZStringView name) const noexcept {
+        if (!mayContainSymbol(name))
+            return false;
+
+        return !lookupSymbol(name).has_error;
+    }
+
+    bool LinuxElfBackend::mayContainSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::mayContainSymbol(name);
+    }
+
+    std::size_t LinuxElfBackend::getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept {
+        std::size_t missing = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = lookup(names[i], errors + i);
+            failed[i] = !errors[i].empty();
+            missing += failed[i];
+        }
+
+        return missing;
+    }
+
+    bool LinuxElfBackend::hasError() const noexcept {
+        return LinuxBackend::hasError();
+    }
+
+    std::string LinuxElfBackend::getLastError() const noexcept {
+        return LinuxBackend::getLastError();
+    }
+
+    SymbolIndex const &LinuxElfBackend::getSymbolIndex() const {
+        return LinuxBackend::getSymbolIndex();
+    }
+
+    std::vector<ElfImage> const &LinuxElfBackend::getScope() const noexcept {
+        return getLookupScope().images;
+    }
+
+    ElfImage::Sym const *LinuxElfBackend::findSymbol(LookupScope const &scope, char const *name, ElfImage const *&owner) const noexcept {
+        std::uint32_t gnu_hash = ElfImage::gnuHash(name);
+        std::uint32_t sysv_hash = scope.needs_sysv ? ElfImage::sysvHash(name) : 0;
+
+        for (ElfImage const &image : scope.images) {
+            if (ElfImage::Sym const *sym = image.findSymbol(name, gnu_hash, sysv_hash)) {
+                owner = &image;
+                return sym;
+            }
+        }
+
+        return nullptr;
+    }
+
+    LinuxElfBackend::SymAddr LinuxElfBackend::lookup(utils::ZStringView name, std::string *error) const noexcept {
+        LookupScope const &scope = getLookupScope();
+        bool empty = scope.images.empty();
+        ElfImage const *owner = nullptr;
+        ElfImage::Sym const *sym = empty ? nullptr : findSymbol(scope, name.c_str(), owner);
+
+        if (empty || (sym != nullptr && (ElfImage::symbolType(sym) == STT_TLS
+                        || ElfImage::symbolType(sym) == STT_GNU_IFUNC))) {
+            (void)dlerror();
+            void *addr = dlsym(_hndl, name.c_str());
+
+            if (addr == NULL) {
+                char *str = dlerror();
+                if (str != NULL)
+                    *error = str;
+            }
+
+            return addr != NULL ? addr : nullptr;
+        }
+
+        if (sym == nullptr) {
+            *error = (_path + ": undefined symbol: ").append(name.view());
+            return nullptr;
+        }
+
+        return owner->getAddress(sym);
+    }
+}
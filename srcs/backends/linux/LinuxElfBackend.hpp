@@ -0,0 +1,89 @@
+/**
+** \file LinuxElfBackend.hpp
+** Linux backend resolving symbols from the ELF tables of loaded objects.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 13:05
+** \date Last update: 2026-10-16 23:00
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef LinuxElfBackend_hpp_
+#define LinuxElfBackend_hpp_
+
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "./OpenFlags.hpp"
+#include "./LinuxBackend.hpp"
+#include "./ElfImage.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class LinuxElfBackend
+    ** \brief Backend looking symbols up without calling dlsym.
+    **
+    ** The library is opened with dlopen, like LinuxBackend does. The backend
+    ** then builds the lookup scope dlsym would use for the handle, that is
+    ** the object itself followed by it's dependencies, in breadth-first
+    ** order, and keeps an ElfImage for each of them.
+    **
+    ** Lookups walk these images' hash tables, which are read-only, instead
+    ** of calling dlsym, so they never take the dynamic loader lock, and
+    ** don't stall behind concurrent dlopen or dlclose calls.
+    **
+    ** Thread local (STT_TLS) and indirect (STT_GNU_IFUNC) symbols still go
+    ** through dlsym, as their address depends on the calling thread or on
+    ** the resolver. If the scope could not be built, every lookup does, as
+    ** for the program itself, whose scope is the global one.
+    */
+    class LinuxElfBackend : protected LinuxBackend {
+        public:
+            using SymAddr = LinuxBackend::SymAddr;
+            using Lookup = LinuxBackend::Lookup;
+
+            LinuxElfBackend(std::string const &path, OpenFlags f = OpenFlags::Default) noexcept;
+            LinuxElfBackend(LinuxElfBackend const &) = delete;
+            LinuxElfBackend(LinuxElfBackend &&oth) noexcept;
+
+            virtual ~LinuxElfBackend();
+
+            LinuxElfBackend &operator=(LinuxElfBackend const &) = delete;
+            LinuxElfBackend &operator=(LinuxElfBackend &&rhs) noexcept;
+
+            bool reset(std::string const &path, OpenFlags f = OpenFlags::Default) noexcept;
+
+            [[nodiscard]]
+            std::string getPath() const noexcept;
+
+            [[nodiscard]]
+            bool hasSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            SymAddr getSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            Lookup lookupSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool containsSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool mayContainSymbol(utils::ZStringView name) const noexcept;
+            std::size_t getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept;
+
+            [[nodiscard]]
+            bool hasError() const noexcept;
+            std::string getLastError() const noexcept;
+
+            [[nodiscard]]
+            SymbolIndex const &getSymbolIndex() const;
+
+            [[nodiscard]]
+            std::vector<ElfImage> const &getScope() const noexcept;
+
+        private:
+            ElfImage::Sym const *findSymbol(LookupScope const &scope, char const *name, ElfImage const *&owner) const noexcept;
+            SymAddr lookup(utils::ZStringView name, std::string *error) const noexcept;
+    };
+}
+
+#endif
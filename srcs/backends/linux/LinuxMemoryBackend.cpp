@@ -0,0 +1,283 @@
+/**
+** \file LinuxMemoryBackend.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:30
+** \date Last update: 2026-10-16 23:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./ProcPath.hpp"
+#include "./LinuxMemoryBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    namespace {
+        constexpr unsigned int seals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL;
+
+        /*
+        ** Returns the memory file, or -1 with errno set. The name is only
+        ** used for display, and doesn't need to be unique.
+        */
+        int createMemfd(std::string const &name) noexcept {
+            return memfd_create(name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        }
+
+        bool writeAll(int fd, unsigned char const *data, std::size_t size) noexcept {
+            while (size != 0) {
+                ssize_t n = ::write(fd, data, size);
+
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+
+                data += n;
+                size -= static_cast<std::size_t>(n);
+            }
+
+            return true;
+        }
+
+        /*
+        ** sendfile() copies between two files without going through user
+        ** space. Some files don't support it, in which case the span is
+        ** copied through a buffer.
+        */
+        bool copySpan(int out, int in, off_t offset, std::size_t size) noexcept {
+            while (size != 0) {
+                ssize_t n = sendfile(out, in, &offset, size);
+
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n < 0 && (errno == EINVAL || errno == ENOSYS))
+                    break;
+                if (n == 0)
+                    errno = EINVAL;
+                if (n <= 0)
+                    return false;
+
+                size -= static_cast<std::size_t>(n);
+            }
+
+            unsigned char buffer[16384];
+
+            while (size != 0) {
+                ssize_t n = pread(in, buffer, size < sizeof(buffer) ? size : sizeof(buffer), offset);
+
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n == 0)
+                    errno = EINVAL;
+                if (n <= 0 || !writeAll(out, buffer, static_cast<std::size_t>(n)))
+                    return false;
+
+                offset += n;
+                size -= static_cast<std::size_t>(n);
+            }
+
+            return true;
+        }
+    }
+
+    LinuxMemoryBackend::LinuxMemoryBackend(void const *data, std::size_t size, std::string const &name, OpenFlags f) noexcept {
+        _path = "memfd:" + name;
+        (void)reset(data, size, name, f);
+    }
+
+    LinuxMemoryBackend::LinuxMemoryBackend(int fd, off_t offset, std::size_t size, std::string const &name, OpenFlags f) noexcept {
+        _path = "memfd:" + name;
+        (void)reset(fd, offset, size, name, f);
+    }
+
+    LinuxMemoryBackend::LinuxMemoryBackend() noexcept {}
+
+    LinuxMemoryBackend::LinuxMemoryBackend(LinuxMemoryBackend &&oth) noexcept
+    : LinuxBackend(std::move(oth)) {}
+
+    LinuxMemoryBackend::~LinuxMemoryBackend() {}
+
+    LinuxMemoryBackend &LinuxMemoryBackend::operator=(LinuxMemoryBackend &&rhs) noexcept {
+        if (this != std::addressof(rhs)) {
+            static_cast<LinuxBackend &>(*this) = std::move(static_cast<LinuxBackend &>(rhs));
+        }
+
+        return *this;
+    }
+
+    bool LinuxMemoryBackend::reset(void const *data, std::size_t size, std::string const &name, OpenFlags f) noexcept {
+        int memfd = createMemfd(name);
+
+        if (memfd < 0)
+            return fail(name, errno);
+
+        if (!writeAll(memfd, static_cast<unsigned char const *>(data), size) || fcntl(memfd, F_ADD_SEALS, seals) != 0) {
+            int err = errno;
+
+            ::close(memfd);
+            return fail(name, err);
+        }
+
+        bool opened = openFd(memfd, name, f);
+
+        ::close(memfd);
+        return opened;
+    }
+
+    /*
+    ** A size of zero stands for the rest of the file. The file is opened
+    ** directly when the span is the whole regular file.
+    */
+    bool LinuxMemoryBackend::reset(int fd, off_t offset, std::size_t size, std::string const &name, OpenFlags f) noexcept {
+        struct stat st;
+
+        if (fstat(fd, &st) != 0)
+            return fail(name, errno);
+
+        if (S_ISREG(st.st_mode)) {
+            if (offset < 0 || offset > st.st_size)
+                return fail(name, EINVAL);
+            if (size == 0)
+                size = static_cast<std::size_t>(st.st_size - offset);
+            if (offset == 0 && static_cast<off_t>(size) == st.st_size)
+                return openFd(fd, name, f);
+        }
+
+        int memfd = createMemfd(name);
+
+        if (memfd < 0)
+            return fail(name, errno);
+
+        if (!copySpan(memfd, fd, offset, size) || fcntl(memfd, F_ADD_SEALS, seals) != 0) {
+            int err = errno;
+
+            ::close(memfd);
+            return fail(name, err);
+        }
+
+        bool opened = openFd(memfd, name, f);
+
+        ::close(memfd);
+        return opened;
+    }
+
+    /*
+    ** The memory file is sized, then mapped, so that fill() writes the
+    ** library in place, without any intermediate buffer. A fill() that
+    ** fails reports malformed content.
+    */
+    bool LinuxMemoryBackend::reset(std::size_t size, Fill const &fill, std::string const &name, OpenFlags f) noexcept {
+        int memfd = createMemfd(name);
+
+        if (memfd < 0)
+            return fail(name, errno);
+
+        int err = 0;
+
+        if (ftruncate(memfd, static_cast<off_t>(size)) != 0) {
+            err = errno;
+        } else if (size != 0) {
+            void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+
+            if (map == MAP_FAILED) {
+                err = errno;
+            } else {
+                bool filled = false;
+
+                try {
+                    filled = fill(static_cast<unsigned char *>(map));
+                } catch (...) {}
+
+                munmap(map, size);
+                if (!filled)
+                    err = EBADMSG;
+            }
+        }
+
+        if (err == 0 && fcntl(memfd, F_ADD_SEALS, seals) != 0)
+            err = errno;
+
+        if (err != 0) {
+            ::close(memfd);
+            return fail(name, err);
+        }
+
+        bool opened = openFd(memfd, name, f);
+
+        ::close(memfd);
+        return opened;
+    }
+
+    std::string LinuxMemoryBackend::getPath() const noexcept {
+        return LinuxBackend::getPath();
+    }
+
+    bool LinuxMemoryBackend::hasSymbol(utils::ZStringView name) noexcept {
+        return LinuxBackend::hasSymbol(name);
+    }
+
+    LinuxMemoryBackend::SymAddr LinuxMemoryBackend::getSymbol(utils::ZStringView name) noexcept {
+        return LinuxBackend::getSymbol(name);
+    }
+
+    LinuxMemoryBackend::Lookup LinuxMemoryBackend::lookupSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::lookupSymbol(name);
+    }
+
+    bool LinuxMemoryBackend::containsSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::containsSymbol(name);
+    }
+
+    bool LinuxMemoryBackend::mayContainSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::mayContainSymbol(name);
+    }
+
+    std::size_t LinuxMemoryBackend::getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept {
+        return LinuxBackend::getSymbols(names, count, out, failed, errors);
+    }
+
+    bool LinuxMemoryBackend::hasError() const noexcept {
+        return LinuxBackend::hasError();
+    }
+
+    std::string LinuxMemoryBackend::getLastError() const noexcept {
+        return LinuxBackend::getLastError();
+    }
+
+    SymbolIndex const &LinuxMemoryBackend::getSymbolIndex() const {
+        return LinuxBackend::getSymbolIndex();
+    }
+
+    /*
+    ** On success, the path LinuxBackend::reset() stored is replaced by a
+    ** stable name: the /proc path is only valid until the descriptor is
+    ** closed. On failure, the previous library is kept, as LinuxBackend
+    ** does.
+    */
+    bool LinuxMemoryBackend::openFd(int fd, std::string const &name, OpenFlags f) noexcept {
+        try {
+            if (!LinuxBackend::reset(procPath(fd), f))
+                return false;
+        } catch (...) {
+            return fail(name, ENOMEM);
+        }
+
+        _path = "memfd:" + name;
+        return true;
+    }
+
+    bool LinuxMemoryBackend::fail(std::string const &name, int err) noexcept {
+        _has_error = true;
+        _err_str = "memfd:" + name + ": " + std::strerror(err);
+
+        return false;
+    }
+}
@@ -0,0 +1,105 @@
+/**
+** \file LinuxMemoryBackend.hpp
+** Linux backend loading libraries from memory, or from a part of a file.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:30
+** \date Last update: 2026-10-16 23:35
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef LinuxMemoryBackend_hpp_
+#define LinuxMemoryBackend_hpp_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <sys/types.h>
+
+#include "./OpenFlags.hpp"
+#include "./LinuxBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class LinuxMemoryBackend
+    ** \brief Backend opening a library that isn't a file of its own.
+    **
+    ** The library is either a span of bytes, or a span of an open file,
+    ** such as a plugin embedded in a larger archive. Its content is put in
+    ** an anonymous memory file created by memfd_create(), sealed against
+    ** any further change, and opened through its /proc/self/fd path. The
+    ** library never touches the filesystem.
+    **
+    ** Bytes in memory are copied once, into the memory file. A span of a
+    ** file is copied by the kernel, with sendfile(), unless it covers the
+    ** whole file, in which case the file is opened as is, without any
+    ** copy. The descriptor given by the caller is never closed.
+    **
+    ** The memory file is closed once the library is opened: the mapping
+    ** of the library keeps it alive until the library is unloaded.
+    ** getPath() returns "memfd:" followed by the name given to the
+    ** backend, which also names the memory file in /proc/<pid>/maps.
+    **
+    ** \warning Loads are never shared. Every backend opened from bytes,
+    ** or from a span of a file, maps its own copy of the library, with its
+    ** own globals and its own initializers, even when the same image was
+    ** already opened, by this backend or any other. Only a span covering
+    ** a whole file, which is opened as is, is shared by the dynamic linker
+    ** with the other loads of that file. To use a single copy, open it
+    ** once, and share the backend.
+    */
+    class LinuxMemoryBackend : protected LinuxBackend {
+        public:
+            using SymAddr = LinuxBackend::SymAddr;
+            using Lookup = LinuxBackend::Lookup;
+
+            LinuxMemoryBackend(void const *data, std::size_t size, std::string const &name, OpenFlags f = OpenFlags::Default) noexcept;
+            LinuxMemoryBackend(int fd, off_t offset, std::size_t size, std::string const &name, OpenFlags f = OpenFlags::Default) noexcept;
+            LinuxMemoryBackend(LinuxMemoryBackend const &) = delete;
+            LinuxMemoryBackend(LinuxMemoryBackend &&oth) noexcept;
+
+            virtual ~LinuxMemoryBackend();
+
+            LinuxMemoryBackend &operator=(LinuxMemoryBackend const &) = delete;
+            LinuxMemoryBackend &operator=(LinuxMemoryBackend &&rhs) noexcept;
+
+            bool reset(void const *data, std::size_t size, std::string const &name, OpenFlags f = OpenFlags::Default) noexcept;
+            bool reset(int fd, off_t offset, std::size_t size, std::string const &name, OpenFlags f = OpenFlags::Default) noexcept;
+
+            [[nodiscard]]
+            std::string getPath() const noexcept;
+
+            [[nodiscard]]
+            bool hasSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            SymAddr getSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            Lookup lookupSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool containsSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool mayContainSymbol(utils::ZStringView name) const noexcept;
+            std::size_t getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept;
+
+            [[nodiscard]]
+            bool hasError() const noexcept;
+            std::string getLastError() const noexcept;
+
+            [[nodiscard]]
+            SymbolIndex const &getSymbolIndex() const;
+
+        protected:
+            using Fill = std::function<bool (unsigned char *out)>;
+
+            LinuxMemoryBackend() noexcept;
+
+            bool reset(std::size_t size, Fill const &fill, std::string const &name, OpenFlags f = OpenFlags::Default) noexcept;
+
+        private:
+            bool openFd(int fd, std::string const &name, OpenFlags f) noexcept;
+            bool fail(std::string const &name, int err) noexcept;
+    };
+}
+
+#endif
@@ -3,79 +3,139 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2020-04-28 16:37
-** \date Last update: 2020-04-28 16:37
+** \date Last update: 2026-10-16 23:40
 ** \copyright GNU Lesser Public Licence v3
 */
 
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
+#include "audit/LoadProfile.hpp"
+
+#include "./NamespacePool.hpp"
 #include "./LinuxScopedBackend.hpp"
 
 namespace clonixin::dynamicloader::backends::_linux {
     LinuxScopedBackend::LinuxScopedBackend(std::string const &path, LinuxScopedBackend::Scope s, OpenFlags f)
-    : _scope(s) {
+    : _scope(s), _pool(nullptr) {
         LinuxBackend::resetError();
 
         _path = path;
-        _hndl = dlmopen(_scope.get(), path.c_str(), static_cast<int>(f));
-
-        LinuxBackend::symbolError();
+        _hndl = open(path, s, f, _scope);
+    }
 
-        if (!_has_error && NewScope == _scope) {
-            Lmid_t id;
+    LinuxScopedBackend::LinuxScopedBackend(std::string const &path, NamespacePool &pool, OpenFlags f)
+    : _scope(BaseScope), _pool(nullptr) {
+        LinuxBackend::resetError();
 
-            if (0 != dlinfo(_hndl, RTLD_DI_LMID, &id))
-                symbolError();
-            else
-                _scope = id;
+        _path = path;
+        if (!pool.acquire(path, _scope, _err_str)) {
+            _has_error = true;
+            return;
         }
+
+        Scope lease = _scope;
+
+        _hndl = open(path, lease, f, _scope);
+        if (_has_error)
+            pool.release(lease, path);
+        else
+            _pool = &pool;
     }
 
     LinuxScopedBackend::LinuxScopedBackend(LinuxScopedBackend &&oth) noexcept
-        : LinuxBackend(std::move(oth)), _scope(std::move(oth._scope)) {}
+        : LinuxBackend(std::move(oth)), _scope(std::move(oth._scope)), _pool(oth._pool) {
+        oth._pool = nullptr;
+    }
 
-    LinuxScopedBackend::~LinuxScopedBackend() {}
+    LinuxScopedBackend::~LinuxScopedBackend() {
+        releaseLease();
+    }
 
     LinuxScopedBackend & LinuxScopedBackend::operator =(LinuxScopedBackend &&rhs) noexcept {
         if (this != std::addressof(rhs)) {
+            releaseLease();
             _scope = std::move(rhs._scope);
+            _pool = rhs._pool;
+            rhs._pool = nullptr;
             reinterpret_cast<LinuxBackend &>(*this) = std::move(reinterpret_cast<LinuxBackend &&>(rhs));
         }
 
         return *this;
     }
 
+    /*
+    ** On failure, the previous library, and its namespace, are kept.
+    */
     bool LinuxScopedBackend::reset(std::string const &path, Scope s, OpenFlags f) noexcept {
         LinuxBackend::resetError();
 
-        void *new_hndl = dlmopen(s.get(), path.c_str(), static_cast<int>(f));
-        LinuxBackend::symbolError();
+        Scope opened = s;
+        void *new_hndl = open(path, s, f, opened);
+
+        if (_has_error)
+            return false;
+
+        releaseLease();
+        adoptHandle(new_hndl, path);
+        _scope = opened;
 
-        if (!_has_error) {
-            if  (NewScope == s) {
-                Lmid_t id;
+        return true;
+    }
+
+    bool LinuxScopedBackend::reset(std::string const &path, NamespacePool &pool, OpenFlags f) noexcept {
+        LinuxBackend::resetError();
 
-                if (0 != dlinfo(_hndl, RTLD_DI_LMID, &id))
-                    symbolError();
-                else
-                    _scope = id;
-            } else
-                _scope = s;
+        Scope lease = BaseScope;
+
+        if (!pool.acquire(path, lease, _err_str)) {
+            _has_error = true;
+            return false;
         }
 
-        return !_has_error;
+        Scope opened = lease;
+        void *new_hndl = open(path, lease, f, opened);
+
+        if (_has_error) {
+            pool.release(lease, path);
+            return false;
+        }
+
+        releaseLease();
+        adoptHandle(new_hndl, path);
+        _scope = opened;
+        _pool = &pool;
+
+        return true;
     }
 
     std::string LinuxScopedBackend::getPath() const noexcept {
         return LinuxBackend::getPath();
     }
 
-    bool LinuxScopedBackend::hasSymbol(std::string const &name) noexcept {
+    bool LinuxScopedBackend::hasSymbol(utils::ZStringView name) noexcept {
         return LinuxBackend::hasSymbol(name);
     }
 
-    LinuxScopedBackend::SymAddr LinuxScopedBackend::getSymbol(std::string const &name) noexcept {
+    LinuxScopedBackend::SymAddr LinuxScopedBackend::getSymbol(utils::ZStringView name) noexcept {
         return LinuxBackend::getSymbol(name);
     }
 
+    LinuxScopedBackend::Lookup LinuxScopedBackend::lookupSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::lookupSymbol(name);
+    }
+
+    bool LinuxScopedBackend::containsSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::containsSymbol(name);
+    }
+
+    bool LinuxScopedBackend::mayContainSymbol(utils::ZStringView name) const noexcept {
+        return LinuxBackend::mayContainSymbol(name);
+    }
+
+    std::size_t LinuxScopedBackend::getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept {
+        return LinuxBackend::getSymbols(names, count, out, failed, errors);
+    }
+
     bool LinuxScopedBackend::hasError() const noexcept {
         return LinuxBackend::hasError();
     }
@@ -84,7 +144,59 @@ namespace clonixin::dynamicloader::backends::_linux {
         return LinuxBackend::getLastError();
     }
 
+    SymbolIndex const &LinuxScopedBackend::getSymbolIndex() const {
+        return LinuxBackend::getSymbolIndex();
+    }
+
     LinuxScopedBackend::Scope LinuxScopedBackend::getScope() const noexcept {
         return _scope;
     }
+
+    /*
+    ** Returns the new handle, or null with the error set. opened is set to
+    ** the namespace the library ended up in, which dlmopen creates when s
+    ** is NewScope.
+    */
+    void *LinuxScopedBackend::open(std::string const &path, Scope s, OpenFlags f, Scope &opened) noexcept {
+        void *hndl = nullptr;
+        {
+            utils::Trace::Span span(utils::Trace::Kind::Load, path);
+            utils::Metrics::Timer timer(utils::Metrics::Latency::Dlopen);
+
+            audit::LoadProfile::opening();
+            hndl = dlmopen(s.get(), path.c_str(), static_cast<int>(f));
+            if (hndl != nullptr)
+                audit::LoadProfile::opened();
+        }
+        LinuxBackend::symbolError();
+
+        if (_has_error)
+            return nullptr;
+
+        utils::Metrics::add(utils::Metrics::Counter::Opens);
+
+        if (NewScope == s) {
+            Lmid_t id;
+
+            if (0 != dlinfo(hndl, RTLD_DI_LMID, &id)) {
+                symbolError();
+                retireHandle(hndl);
+                return nullptr;
+            }
+            opened = id;
+        } else
+            opened = s;
+
+        return hndl;
+    }
+
+    /*
+    ** The library is still loaded when its namespace is given back: the
+    ** pool doesn't lease a namespace in which the path is still loaded.
+    */
+    void LinuxScopedBackend::releaseLease() noexcept {
+        if (_pool != nullptr)
+            _pool->release(_scope, _path);
+        _pool = nullptr;
+    }
 }
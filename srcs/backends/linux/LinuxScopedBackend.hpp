@@ -3,7 +3,7 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2020-04-28 16:37
-** \date Last update: 2020-04-28 16:37
+** \date Last update: 2026-10-16 22:55
 ** \copyright GNU Lesser Public Licence v3
 */
 
@@ -21,6 +21,7 @@ namespace clonixin::dynamicloader::backends::_linux {
     using namespace std::string_literals;
 
     class LinuxScopedBackend;
+    class NamespacePool;
 
     namespace _internals {
         class Scope {
@@ -49,18 +50,30 @@ namespace clonixin::dynamicloader::backends::_linux {
             constexpr Lmid_t get() const { return _id; }
 
             friend LinuxScopedBackend;
+            friend NamespacePool;
         };
     }
 
 
+    /**
+    ** \class LinuxScopedBackend
+    ** \brief Backend opening libraries in a link-map namespace, with
+    ** dlmopen.
+    **
+    ** A library is opened either in a given scope, or in a namespace
+    ** leased from a NamespacePool, which is given back when the library is
+    ** replaced, or the backend destroyed.
+    */
     class LinuxScopedBackend : protected LinuxBackend {
         public:
             using Scope = _internals::Scope;
             using SymAddr = LinuxBackend::SymAddr;
+            using Lookup = LinuxBackend::Lookup;
             static constexpr Scope BaseScope = LM_ID_BASE;
             static constexpr Scope NewScope = LM_ID_NEWLM;
 
             LinuxScopedBackend(std::string const &path, Scope s, OpenFlags f = OpenFlags::Default);
+            LinuxScopedBackend(std::string const &path, NamespacePool &pool, OpenFlags f = OpenFlags::Default);
             LinuxScopedBackend(LinuxScopedBackend const &) = delete;
             LinuxScopedBackend(LinuxScopedBackend &&oth) noexcept;
 
@@ -70,22 +83,38 @@ namespace clonixin::dynamicloader::backends::_linux {
             LinuxScopedBackend &operator=(LinuxScopedBackend &&rhs) noexcept;
 
             bool reset(std::string const &path, Scope s, OpenFlags f = OpenFlags::Default) noexcept;
+            bool reset(std::string const &path, NamespacePool &pool, OpenFlags f = OpenFlags::Default) noexcept;
 
             [[nodiscard]]
             std::string getPath() const noexcept;
 
             [[nodiscard]]
-            bool hasSymbol(std::string const &name) noexcept;
+            bool hasSymbol(utils::ZStringView name) noexcept;
             [[nodiscard]]
-            SymAddr getSymbol(std::string const &name) noexcept;
+            SymAddr getSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            Lookup lookupSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool containsSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool mayContainSymbol(utils::ZStringView name) const noexcept;
+            std::size_t getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept;
 
             [[nodiscard]]
             bool hasError() const noexcept;
             std::string getLastError() const noexcept;
 
+            [[nodiscard]]
+            SymbolIndex const &getSymbolIndex() const;
+
             Scope getScope() const noexcept;
+        private:
+            void *open(std::string const &path, Scope s, OpenFlags f, Scope &opened) noexcept;
+            void releaseLease() noexcept;
+
         private:
             Scope _scope;
+            NamespacePool *_pool;
     };
 }
 
@@ -0,0 +1,120 @@
+/**
+** \file LinuxSharedBackend.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 17:30
+** \date Last update: 2026-10-16 22:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <exception>
+
+#include "./LinuxSharedBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    LinuxSharedBackend::LinuxSharedBackend(std::string const &path, OpenFlags f)
+    : _shared(HandleRegistry::instance().open(path, f)),
+    _has_error(_shared->hasError()), _err_str(_shared->getLastError()) {}
+
+    LinuxSharedBackend::LinuxSharedBackend(LinuxSharedBackend &&oth) noexcept
+    : _shared(std::move(oth._shared)), _has_error(oth._has_error),
+    _err_str(std::move(oth._err_str)) {
+        oth._has_error = false;
+        oth._err_str.clear();
+    }
+
+    LinuxSharedBackend::~LinuxSharedBackend() {}
+
+    LinuxSharedBackend &LinuxSharedBackend::operator=(LinuxSharedBackend &&rhs) noexcept {
+        if (this != std::addressof(rhs)) {
+            _shared = std::move(rhs._shared);
+
+            _has_error = rhs._has_error;
+            rhs._has_error = false;
+
+            _err_str = std::move(rhs._err_str);
+            rhs._err_str.clear();
+        }
+
+        return *this;
+    }
+
+    /*
+    ** A failed open gives back a backend holding the error, which is never
+    ** registered. It's only used to report the error, and dropped.
+    */
+    bool LinuxSharedBackend::reset(std::string const &path, OpenFlags f) noexcept {
+        HandleRegistry::Shared shared;
+
+        try {
+            shared = HandleRegistry::instance().open(path, f);
+        } catch (std::exception const &e) {
+            _has_error = true;
+            _err_str = e.what();
+            return false;
+        }
+
+        _has_error = shared->hasError();
+        _err_str = shared->getLastError();
+        if (!_has_error)
+            _shared = std::move(shared);
+
+        return !_has_error;
+    }
+
+    void LinuxSharedBackend::prefetch(std::string const &path) noexcept {
+        LinuxBackend::prefetch(path);
+    }
+
+    std::string LinuxSharedBackend::getPath() const noexcept {
+        return _shared != nullptr ? _shared->getPath() : std::string();
+    }
+
+    bool LinuxSharedBackend::hasSymbol(utils::ZStringView name) noexcept {
+        bool found = containsSymbol(name);
+
+        _has_error = !found;
+        _err_str.clear();
+        return found;
+    }
+
+    LinuxSharedBackend::SymAddr LinuxSharedBackend::getSymbol(utils::ZStringView name) noexcept {
+        Lookup res = lookupSymbol(name);
+
+        _has_error = res.has_error;
+        _err_str = std::move(res.error);
+        return res.sym;
+    }
+
+    LinuxSharedBackend::Lookup LinuxSharedBackend::lookupSymbol(utils::ZStringView name) const noexcept {
+        return _shared->lookupSymbol(name);
+    }
+
+    bool LinuxSharedBackend::containsSymbol(utils::ZStringView name) const noexcept {
+        return _shared->containsSymbol(name);
+    }
+
+    bool LinuxSharedBackend::mayContainSymbol(utils::ZStringView name) const noexcept {
+        return _shared->mayContainSymbol(name);
+    }
+
+    std::size_t LinuxSharedBackend::getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept {
+        return _shared->getSymbols(names, count, out, failed, errors);
+    }
+
+    bool LinuxSharedBackend::hasError() const noexcept {
+        return _has_error;
+    }
+
+    std::string LinuxSharedBackend::getLastError() const noexcept {
+        return _err_str;
+    }
+
+    SymbolIndex const &LinuxSharedBackend::getSymbolIndex() const {
+        return _shared->getSymbolIndex();
+    }
+
+    HandleRegistry::Shared const &LinuxSharedBackend::getShared() const noexcept {
+        return _shared;
+    }
+}
@@ -0,0 +1,85 @@
+/**
+** \file LinuxSharedBackend.hpp
+** Linux backend sharing its handle through the HandleRegistry.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 17:30
+** \date Last update: 2026-10-16 22:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef LinuxSharedBackend_hpp_
+#define LinuxSharedBackend_hpp_
+
+#include <memory>
+#include <string>
+
+#include "utils/ZStringView.hpp"
+
+#include "./OpenFlags.hpp"
+#include "./LinuxBackend.hpp"
+#include "./HandleRegistry.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class LinuxSharedBackend
+    ** \brief Backend using a LinuxBackend shared with every other user of
+    ** the same library.
+    **
+    ** The handle is obtained from HandleRegistry::instance(), so opening a
+    ** library that another LinuxSharedBackend already holds neither calls
+    ** dlopen, nor allocates a new handle. Only the const, stateless,
+    ** functions of the shared LinuxBackend are used. The stateful
+    ** getSymbol() and hasSymbol() keep their error in this object.
+    */
+    class LinuxSharedBackend {
+        public:
+            using SymAddr = LinuxBackend::SymAddr;
+            using Lookup = LinuxBackend::Lookup;
+
+            LinuxSharedBackend(std::string const &path, OpenFlags f = OpenFlags::Default);
+            LinuxSharedBackend(LinuxSharedBackend const &) = delete;
+            LinuxSharedBackend(LinuxSharedBackend &&oth) noexcept;
+
+            ~LinuxSharedBackend();
+
+            LinuxSharedBackend &operator=(LinuxSharedBackend const &) = delete;
+            LinuxSharedBackend &operator=(LinuxSharedBackend &&rhs) noexcept;
+
+            bool reset(std::string const &path, OpenFlags f = OpenFlags::Default) noexcept;
+
+            static void prefetch(std::string const &path) noexcept;
+
+            [[nodiscard]]
+            std::string getPath() const noexcept;
+
+            [[nodiscard]]
+            bool hasSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            SymAddr getSymbol(utils::ZStringView name) noexcept;
+            [[nodiscard]]
+            Lookup lookupSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool containsSymbol(utils::ZStringView name) const noexcept;
+            [[nodiscard]]
+            bool mayContainSymbol(utils::ZStringView name) const noexcept;
+            std::size_t getSymbols(utils::ZStringView const *names, std::size_t count, SymAddr *out, bool *failed, std::string *errors) const noexcept;
+
+            [[nodiscard]]
+            bool hasError() const noexcept;
+            std::string getLastError() const noexcept;
+
+            [[nodiscard]]
+            SymbolIndex const &getSymbolIndex() const;
+
+            [[nodiscard]]
+            HandleRegistry::Shared const &getShared() const noexcept;
+
+        private:
+            HandleRegistry::Shared _shared;
+            bool _has_error;
+            std::string _err_str;
+    };
+}
+
+#endif
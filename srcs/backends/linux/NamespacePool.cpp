@@ -0,0 +1,202 @@
+/**
+** \file NamespacePool.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 22:10
+** \date Last update: 2026-10-16 22:10
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+
+#include <gnu/lib-names.h>
+
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
+
+#include "./NamespacePool.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    NamespacePool::NamespacePool(std::size_t capacity, std::size_t per_namespace) noexcept
+    : _capacity(capacity), _per_namespace(std::max<std::size_t>(per_namespace, 1)) {}
+
+    NamespacePool::~NamespacePool() {
+        for (Namespace const &ns : _namespaces)
+            dlclose(ns.anchor);
+    }
+
+    /*
+    ** Creates namespaces until count of them exist, or capacity is
+    ** reached.
+    */
+    bool NamespacePool::prepare(std::size_t count) noexcept {
+        std::lock_guard<std::mutex> lock(_lock);
+        std::string error;
+
+        count = std::min(count, _capacity);
+        while (_namespaces.size() < count)
+            if (!create(error))
+                return false;
+
+        return true;
+    }
+
+    /*
+    ** Closes namespaces without any leased library, keeping keep of them.
+    ** glibc frees a namespace once its last object is unloaded.
+    */
+    std::size_t NamespacePool::trim(std::size_t keep) noexcept {
+        std::lock_guard<std::mutex> lock(_lock);
+        std::size_t spare = 0;
+        std::size_t closed = 0;
+
+        for (auto ns = _namespaces.begin(); ns != _namespaces.end();) {
+            if (!ns->libraries.empty() || spare++ < keep) {
+                ++ns;
+                continue;
+            }
+
+            dlclose(ns->anchor);
+            ns = _namespaces.erase(ns);
+            ++closed;
+        }
+
+        return closed;
+    }
+
+    std::size_t NamespacePool::getCapacity() const noexcept {
+        return _capacity;
+    }
+
+    std::size_t NamespacePool::size() const noexcept {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        return _namespaces.size();
+    }
+
+    std::size_t NamespacePool::getLeased() const noexcept {
+        std::lock_guard<std::mutex> lock(_lock);
+        std::size_t leased = 0;
+
+        for (Namespace const &ns : _namespaces)
+            leased += ns.libraries.size();
+
+        return leased;
+    }
+
+    std::vector<std::string> NamespacePool::getLibraries(Scope scope) const {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        for (Namespace const &ns : _namespaces)
+            if (ns.id == scope.get())
+                return ns.libraries;
+
+        return std::vector<std::string>();
+    }
+
+    /*
+    ** Namespaces are searched in creation order, so that libraries are
+    ** packed in the oldest ones, and trim() can close the others.
+    */
+    bool NamespacePool::acquire(std::string const &path, Scope &scope, std::string &error) noexcept {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        try {
+            auto ns = std::find_if(_namespaces.begin(), _namespaces.end(), [&](Namespace const &ns) {
+                return accepts(ns, path);
+            });
+
+            if (ns == _namespaces.end()) {
+                if (_namespaces.size() >= _capacity) {
+                    error = path + ": no free namespace in the pool";
+                    return false;
+                }
+                if (!create(error))
+                    return false;
+                ns = std::prev(_namespaces.end());
+            }
+
+            ns->libraries.push_back(path);
+            scope = Scope(ns->id);
+        } catch (...) {
+            error = path + ": cannot allocate memory";
+            return false;
+        }
+
+        return true;
+    }
+
+    void NamespacePool::release(Scope scope, std::string const &path) noexcept {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        for (Namespace &ns : _namespaces) {
+            if (ns.id != scope.get())
+                continue;
+
+            auto lib = std::find(ns.libraries.begin(), ns.libraries.end(), path);
+
+            if (lib != ns.libraries.end())
+                ns.libraries.erase(lib);
+            return;
+        }
+    }
+
+    /*
+    ** Called with the lock held. The new namespace is the one libc gets
+    ** loaded in.
+    */
+    bool NamespacePool::create(std::string &error) noexcept {
+        void *anchor = nullptr;
+        Lmid_t id;
+
+        (void)dlerror();
+        {
+            utils::Trace::Span span(utils::Trace::Kind::Load, LIBC_SO);
+            utils::Metrics::Timer timer(utils::Metrics::Latency::Dlopen);
+
+            anchor = dlmopen(LM_ID_NEWLM, LIBC_SO, RTLD_LAZY | RTLD_LOCAL);
+        }
+
+        if (anchor == nullptr || dlinfo(anchor, RTLD_DI_LMID, &id) != 0) {
+            char const *str = dlerror();
+
+            if (anchor != nullptr)
+                dlclose(anchor);
+
+            try {
+                error = str != nullptr ? str : "cannot create a namespace";
+            } catch (...) {}
+            return false;
+        }
+
+        try {
+            _namespaces.push_back(Namespace{id, anchor, {}});
+        } catch (...) {
+            dlclose(anchor);
+            return false;
+        }
+
+        return true;
+    }
+
+    /*
+    ** A library still loaded in the namespace, because a backend hasn't
+    ** closed it yet, or as a dependency of another one, would be shared
+    ** with it instead of being opened anew.
+    */
+    bool NamespacePool::accepts(Namespace const &ns, std::string const &path) const noexcept {
+        if (ns.libraries.size() >= _per_namespace
+                || std::find(ns.libraries.begin(), ns.libraries.end(), path) != ns.libraries.end())
+            return false;
+
+        void *loaded = dlmopen(ns.id, path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+
+        if (loaded == nullptr) {
+            (void)dlerror();
+            return true;
+        }
+
+        dlclose(loaded);
+        return false;
+    }
+}
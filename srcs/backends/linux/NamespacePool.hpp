@@ -0,0 +1,99 @@
+/**
+** \file NamespacePool.hpp
+** Pool of dlmopen link-map namespaces shared by LinuxScopedBackend.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 22:10
+** \date Last update: 2026-10-16 22:10
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef NamespacePool_hpp_
+#define NamespacePool_hpp_
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "./LinuxScopedBackend.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \class NamespacePool
+    ** \brief Link-map namespaces created ahead of time, and handed out to
+    ** LinuxScopedBackend.
+    **
+    ** glibc supports a handful of namespaces per process, and each new one
+    ** maps and initializes a private copy of libc. Opening every isolated
+    ** plugin with LinuxScopedBackend::NewScope quickly runs out of them,
+    ** and pays for libc every time.
+    **
+    ** A namespace of the pool is created by opening libc in it. That
+    ** handle is kept by the pool, so that the namespace, and its libc,
+    ** outlive the plugins opened in it. Namespaces are created up to
+    ** capacity, either by prepare() or on demand.
+    **
+    ** The pool tracks the libraries leased in each namespace. A library is
+    ** placed in the first namespace holding fewer than per_namespace
+    ** libraries, none of them with the same path, and in which the path
+    ** isn't loaded anymore, so that every lease gets its own instance. A
+    ** per_namespace of one isolates every library. A namespace whose
+    ** libraries were all released is reused as is, or closed by trim().
+    **
+    ** The pool can be used from any number of threads. It must outlive
+    ** the backends it leases namespaces to.
+    */
+    class NamespacePool {
+        public:
+            using Scope = LinuxScopedBackend::Scope;
+
+            explicit NamespacePool(std::size_t capacity, std::size_t per_namespace = 1) noexcept;
+            NamespacePool(NamespacePool const &) = delete;
+
+            ~NamespacePool();
+
+            NamespacePool &operator=(NamespacePool const &) = delete;
+
+            bool prepare(std::size_t count) noexcept;
+            std::size_t trim(std::size_t keep = 0) noexcept;
+
+            [[nodiscard]]
+            std::size_t getCapacity() const noexcept;
+            [[nodiscard]]
+            std::size_t size() const noexcept;
+            [[nodiscard]]
+            std::size_t getLeased() const noexcept;
+            [[nodiscard]]
+            std::vector<std::string> getLibraries(Scope scope) const;
+
+            [[nodiscard]]
+            bool acquire(std::string const &path, Scope &scope, std::string &error) noexcept;
+            void release(Scope scope, std::string const &path) noexcept;
+
+        private:
+            /**
+            ** \brief A namespace, and the paths of the libraries leased in
+            ** it.
+            */
+            struct Namespace {
+                Lmid_t id;
+                void *anchor;
+                std::vector<std::string> libraries;
+            };
+
+            bool create(std::string &error) noexcept;
+            bool accepts(Namespace const &ns, std::string const &path) const noexcept;
+
+        private:
+            std::size_t _capacity;
+            std::size_t _per_namespace;
+
+            mutable std::mutex _lock;
+            std::vector<Namespace> _namespaces;
+    };
+}
+
+#endif
@@ -0,0 +1,475 @@
+/**
+** \file OffsetCache.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:10
+** \date Last update: 2026-10-16 21:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./ElfImage.hpp"
+#include "./OffsetCache.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    namespace {
+        constexpr char file_magic[8] = {'D', 'L', 'O', 'F', 'F', 'S', 'E', 'T'};
+        constexpr std::uint32_t file_version = 1;
+
+        /*
+        ** Every offset is relative to the start of the file. Symbols of a
+        ** library are sorted by GNU hash, then by name.
+        */
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t library_count;
+            std::uint64_t size;
+            std::uint64_t checksum;
+        };
+
+        struct LibraryRecord {
+            std::uint8_t id[BuildId::max_size];
+            std::uint32_t id_size;
+            std::uint32_t symbol_count;
+            std::uint64_t symbols;
+            std::uint64_t extent;
+            std::uint64_t object;
+            std::uint32_t object_size;
+            std::uint32_t padding;
+        };
+
+        struct SymbolRecord {
+            std::uint32_t hash;
+            std::uint32_t name_size;
+            std::uint64_t name;
+            std::uint64_t offset;
+        };
+
+        std::uint64_t checksum(unsigned char const *data, std::size_t size) noexcept {
+            std::uint64_t hash = 0xcbf29ce484222325;
+
+            for (std::size_t i = 0; i < size; ++i) {
+                hash ^= data[i];
+                hash *= 0x100000001b3;
+            }
+
+            return hash;
+        }
+
+        BuildId idOf(LibraryRecord const &lib) noexcept {
+            BuildId id;
+
+            std::memcpy(id.bytes.data(), lib.id, BuildId::max_size);
+            id.size = lib.id_size;
+            return id;
+        }
+
+        bool fits(std::uint64_t offset, std::uint64_t size, std::size_t total) noexcept {
+            return offset <= total && size <= total - offset;
+        }
+
+        struct PhdrSearch {
+            struct link_map const *target;
+            BuildId id;
+            std::uint64_t extent;
+        };
+
+        int findBuildId(struct dl_phdr_info *info, std::size_t, void *data) {
+            PhdrSearch *search = static_cast<PhdrSearch *>(data);
+            bool found = false;
+
+            if (info->dlpi_addr != search->target->l_addr)
+                return 0;
+
+            for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+                ElfW(Phdr) const &phdr = info->dlpi_phdr[i];
+
+                if (phdr.p_type == PT_DYNAMIC)
+                    found = info->dlpi_addr + phdr.p_vaddr == reinterpret_cast<ElfW(Addr)>(search->target->l_ld);
+            }
+            if (!found)
+                return 0;
+
+            for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+                ElfW(Phdr) const &phdr = info->dlpi_phdr[i];
+
+                if (phdr.p_type == PT_LOAD)
+                    search->extent = std::max<std::uint64_t>(search->extent, phdr.p_vaddr + phdr.p_memsz);
+                else if (phdr.p_type == PT_NOTE && !search->id.isValid())
+                    search->id = BuildId::fromNotes(reinterpret_cast<void const *>(info->dlpi_addr + phdr.p_vaddr), phdr.p_memsz);
+            }
+
+            return 1;
+        }
+    }
+
+    /*
+    ** Reads the build-id among the notes of a PT_NOTE segment, mapped or
+    ** read from a file.
+    */
+    BuildId BuildId::fromNotes(void const *notes, std::size_t size) noexcept {
+        BuildId id;
+        ElfW(Addr) start = reinterpret_cast<ElfW(Addr)>(notes);
+        ElfW(Addr) end = start + size;
+
+        while (start + sizeof(ElfW(Nhdr)) <= end) {
+            ElfW(Nhdr) const *note = reinterpret_cast<ElfW(Nhdr) const *>(start);
+            ElfW(Addr) name = start + sizeof(ElfW(Nhdr));
+            ElfW(Addr) desc = name + ((note->n_namesz + 3) & ~3u);
+
+            if (desc + note->n_descsz > end)
+                break;
+
+            if (note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4
+                    && std::memcmp(reinterpret_cast<void const *>(name), "GNU", 4) == 0) {
+                if (note->n_descsz != 0 && note->n_descsz <= BuildId::max_size) {
+                    std::memcpy(id.bytes.data(), reinterpret_cast<void const *>(desc), note->n_descsz);
+                    id.size = note->n_descsz;
+                }
+                break;
+            }
+
+            start = desc + ((note->n_descsz + 3) & ~3u);
+        }
+
+        return id;
+    }
+
+    bool BuildId::operator<(BuildId const &rhs) const noexcept {
+        if (size != rhs.size)
+            return size < rhs.size;
+        return std::memcmp(bytes.data(), rhs.bytes.data(), size) < 0;
+    }
+
+    bool BuildId::operator==(BuildId const &rhs) const noexcept {
+        return size == rhs.size && std::memcmp(bytes.data(), rhs.bytes.data(), size) == 0;
+    }
+
+    OffsetCache::OffsetCache(std::string const &path) noexcept
+    : _path(path), _map(nullptr), _size(0) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st;
+
+        if (fd < 0)
+            return;
+
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && static_cast<std::size_t>(st.st_size) >= sizeof(FileHeader)) {
+            void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (map != MAP_FAILED) {
+                _map = static_cast<unsigned char const *>(map);
+                _size = st.st_size;
+            }
+        }
+        ::close(fd);
+
+        if (_map != nullptr && !validate())
+            unmap();
+    }
+
+    OffsetCache::~OffsetCache() {
+        unmap();
+    }
+
+    std::string const &OffsetCache::getPath() const noexcept {
+        return _path;
+    }
+
+    bool OffsetCache::isLoaded() const noexcept {
+        return _map != nullptr;
+    }
+
+    /*
+    ** Number of symbols in the mapped file, whatever their object.
+    */
+    std::size_t OffsetCache::size() const noexcept {
+        if (_map == nullptr)
+            return 0;
+
+        FileHeader const *header = reinterpret_cast<FileHeader const *>(_map);
+        LibraryRecord const *libs = reinterpret_cast<LibraryRecord const *>(_map + sizeof(FileHeader));
+        std::size_t count = 0;
+
+        for (std::uint32_t i = 0; i < header->library_count; ++i)
+            count += libs[i].symbol_count;
+
+        return count;
+    }
+
+    /*
+    ** Registers an object opened in this run, so that save() knows which
+    ** entries of the file are outdated, and returns its cached symbols. An
+    ** entry whose extent differs from the object's is not trusted.
+    */
+    OffsetCache::View OffsetCache::attach(BuildId const &id, std::string const &object, std::uint64_t extent) noexcept {
+        if (!id.isValid())
+            return View();
+
+        try {
+            std::lock_guard<std::mutex> lock(_lock);
+            Pending &pending = _pending[id];
+
+            pending.object = object;
+            pending.extent = extent;
+        } catch (...) {
+            return View();
+        }
+
+        if (_map == nullptr)
+            return View();
+
+        FileHeader const *header = reinterpret_cast<FileHeader const *>(_map);
+        LibraryRecord const *first = reinterpret_cast<LibraryRecord const *>(_map + sizeof(FileHeader));
+        LibraryRecord const *last = first + header->library_count;
+        LibraryRecord const *lib = std::lower_bound(first, last, id, [](LibraryRecord const &rec, BuildId const &key) {
+            return idOf(rec) < key;
+        });
+
+        if (lib == last || !(idOf(*lib) == id) || lib->extent != extent)
+            return View();
+
+        return View{lib};
+    }
+
+    bool OffsetCache::find(View view, utils::ZStringView name, std::uint64_t &offset) const noexcept {
+        if (view.empty())
+            return false;
+
+        LibraryRecord const *lib = static_cast<LibraryRecord const *>(view.library);
+        SymbolRecord const *first = reinterpret_cast<SymbolRecord const *>(_map + lib->symbols);
+        SymbolRecord const *last = first + lib->symbol_count;
+        std::uint32_t hash = ElfImage::gnuHash(name.c_str());
+
+        first = std::lower_bound(first, last, hash, [](SymbolRecord const &rec, std::uint32_t key) {
+            return rec.hash < key;
+        });
+
+        for (; first != last && first->hash == hash; ++first) {
+            if (first->name_size == name.size() && std::memcmp(_map + first->name, name.data(), name.size()) == 0) {
+                offset = first->offset;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*
+    ** Only objects attached in this run are recorded, as their extent is
+    ** needed to save them.
+    */
+    void OffsetCache::record(BuildId const &id, utils::ZStringView name, std::uint64_t offset) noexcept {
+        try {
+            std::lock_guard<std::mutex> lock(_lock);
+            auto pending = _pending.find(id);
+
+            if (pending != _pending.end())
+                pending->second.symbols.emplace(name.str(), offset);
+        } catch (...) {}
+    }
+
+    /*
+    ** The file is written next to the old one, then renamed over it, so
+    ** that a process mapping it at the same time sees either version, and
+    ** a crash never leaves a partial file behind.
+    */
+    bool OffsetCache::save() const noexcept {
+        struct Library {
+            std::string object;
+            std::uint64_t extent;
+            std::map<std::string, std::uint64_t> symbols;
+        };
+
+        try {
+            std::map<BuildId, Library> merged;
+
+            std::lock_guard<std::mutex> lock(_lock);
+
+            if (_map != nullptr) {
+                FileHeader const *header = reinterpret_cast<FileHeader const *>(_map);
+                LibraryRecord const *libs = reinterpret_cast<LibraryRecord const *>(_map + sizeof(FileHeader));
+
+                for (std::uint32_t i = 0; i < header->library_count; ++i) {
+                    LibraryRecord const &rec = libs[i];
+                    BuildId id = idOf(rec);
+                    std::string object(reinterpret_cast<char const *>(_map + rec.object), rec.object_size);
+                    bool outdated = std::any_of(_pending.begin(), _pending.end(), [&](auto const &p) {
+                        return p.second.object == object && !(p.first == id);
+                    });
+
+                    if (outdated)
+                        continue;
+
+                    Library &lib = merged[id];
+                    SymbolRecord const *syms = reinterpret_cast<SymbolRecord const *>(_map + rec.symbols);
+
+                    lib.object = object;
+                    lib.extent = rec.extent;
+                    for (std::uint32_t s = 0; s < rec.symbol_count; ++s)
+                        lib.symbols.emplace(std::string(reinterpret_cast<char const *>(_map + syms[s].name), syms[s].name_size), syms[s].offset);
+                }
+            }
+
+            for (auto const &[id, pending] : _pending) {
+                if (pending.symbols.empty())
+                    continue;
+
+                Library &lib = merged[id];
+
+                lib.object = pending.object;
+                lib.extent = pending.extent;
+                for (auto const &[name, offset] : pending.symbols)
+                    lib.symbols[name] = offset;
+            }
+
+            std::size_t symbol_count = 0;
+            for (auto const &entry : merged)
+                symbol_count += entry.second.symbols.size();
+
+            std::size_t tables = sizeof(FileHeader) + merged.size() * sizeof(LibraryRecord);
+            std::vector<unsigned char> out(tables + symbol_count * sizeof(SymbolRecord));
+            std::size_t sym_at = tables;
+            std::size_t lib_at = sizeof(FileHeader);
+
+            for (auto const &[id, lib] : merged) {
+                LibraryRecord rec{};
+                std::vector<SymbolRecord> syms;
+
+                std::memcpy(rec.id, id.bytes.data(), BuildId::max_size);
+                rec.id_size = id.size;
+                rec.symbol_count = static_cast<std::uint32_t>(lib.symbols.size());
+                rec.symbols = sym_at;
+                rec.extent = lib.extent;
+                rec.object = out.size();
+                rec.object_size = static_cast<std::uint32_t>(lib.object.size());
+                out.insert(out.end(), lib.object.begin(), lib.object.end());
+
+                for (auto const &[name, offset] : lib.symbols) {
+                    syms.push_back({ElfImage::gnuHash(name.c_str()), static_cast<std::uint32_t>(name.size()), out.size(), offset});
+                    out.insert(out.end(), name.begin(), name.end());
+                }
+
+                std::stable_sort(syms.begin(), syms.end(), [](SymbolRecord const &lhs, SymbolRecord const &rhs) {
+                    return lhs.hash < rhs.hash;
+                });
+
+                std::memcpy(out.data() + lib_at, &rec, sizeof(rec));
+                std::memcpy(out.data() + sym_at, syms.data(), syms.size() * sizeof(SymbolRecord));
+                lib_at += sizeof(LibraryRecord);
+                sym_at += syms.size() * sizeof(SymbolRecord);
+            }
+
+            FileHeader header{};
+
+            std::memcpy(header.magic, file_magic, sizeof(file_magic));
+            header.version = file_version;
+            header.library_count = static_cast<std::uint32_t>(merged.size());
+            header.size = out.size();
+            header.checksum = checksum(out.data() + sizeof(FileHeader), out.size() - sizeof(FileHeader));
+            std::memcpy(out.data(), &header, sizeof(header));
+
+            std::string tmp = _path + ".XXXXXX";
+            int fd = mkstemp(tmp.data());
+
+            if (fd < 0)
+                return false;
+
+            std::size_t written = 0;
+            while (written < out.size()) {
+                ssize_t n = ::write(fd, out.data() + written, out.size() - written);
+
+                if (n <= 0)
+                    break;
+                written += static_cast<std::size_t>(n);
+            }
+
+            bool ok = written == out.size() && fchmod(fd, 0644) == 0;
+
+            ok = ::close(fd) == 0 && ok;
+            if (ok)
+                ok = std::rename(tmp.c_str(), _path.c_str()) == 0;
+            if (!ok)
+                (void)::unlink(tmp.c_str());
+
+            return ok;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    /*
+    ** The object is found among the loaded ones by its base address and
+    ** dynamic section, as buildScope() does. Its extent is the end of its
+    ** highest PT_LOAD segment, relative to its base.
+    */
+    BuildId OffsetCache::readBuildId(void *hndl, std::uint64_t *extent) noexcept {
+        struct link_map *lm = nullptr;
+
+        if (hndl == nullptr || dlinfo(hndl, RTLD_DI_LINKMAP, &lm) != 0 || lm == nullptr) {
+            (void)dlerror();
+            return BuildId();
+        }
+
+        PhdrSearch search{lm, BuildId(), 0};
+
+        dl_iterate_phdr(&findBuildId, &search);
+        if (extent != nullptr)
+            *extent = search.extent;
+
+        return search.id;
+    }
+
+    /*
+    ** Everything the lookups rely on is checked once, here: the checksum,
+    ** the order of the library table, and that every record points inside
+    ** the file, and every offset inside its object.
+    */
+    bool OffsetCache::validate() const noexcept {
+        FileHeader const *header = reinterpret_cast<FileHeader const *>(_map);
+
+        if (std::memcmp(header->magic, file_magic, sizeof(file_magic)) != 0 || header->version != file_version
+                || header->size != _size
+                || !fits(sizeof(FileHeader), std::uint64_t(header->library_count) * sizeof(LibraryRecord), _size)
+                || header->checksum != checksum(_map + sizeof(FileHeader), _size - sizeof(FileHeader)))
+            return false;
+
+        LibraryRecord const *libs = reinterpret_cast<LibraryRecord const *>(_map + sizeof(FileHeader));
+
+        for (std::uint32_t i = 0; i < header->library_count; ++i) {
+            LibraryRecord const &lib = libs[i];
+
+            if (lib.id_size == 0 || lib.id_size > BuildId::max_size || (i != 0 && !(idOf(libs[i - 1]) < idOf(lib)))
+                    || lib.symbols % alignof(SymbolRecord) != 0
+                    || !fits(lib.symbols, std::uint64_t(lib.symbol_count) * sizeof(SymbolRecord), _size)
+                    || !fits(lib.object, lib.object_size, _size))
+                return false;
+
+            SymbolRecord const *syms = reinterpret_cast<SymbolRecord const *>(_map + lib.symbols);
+
+            for (std::uint32_t s = 0; s < lib.symbol_count; ++s)
+                if (!fits(syms[s].name, syms[s].name_size, _size) || syms[s].offset >= lib.extent)
+                    return false;
+        }
+
+        return true;
+    }
+
+    void OffsetCache::unmap() noexcept {
+        if (_map != nullptr)
+            munmap(const_cast<unsigned char *>(_map), _size);
+        _map = nullptr;
+        _size = 0;
+    }
+}
@@ -0,0 +1,130 @@
+/**
+** \file OffsetCache.hpp
+** Persistent cache of symbol offsets, keyed by the build-id of the objects
+** they were resolved in.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 21:10
+** \date Last update: 2026-10-16 21:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef OffsetCache_hpp_
+#define OffsetCache_hpp_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "utils/ZStringView.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \brief Content of the NT_GNU_BUILD_ID note of an object.
+    **
+    ** A size of zero means the object has no build-id, or one longer than
+    ** max_size bytes, and can't be cached.
+    */
+    struct BuildId {
+        static constexpr std::size_t max_size = 32;
+
+        std::array<std::uint8_t, max_size> bytes{};
+        std::uint32_t size = 0;
+
+        [[nodiscard]]
+        bool isValid() const noexcept { return size != 0; }
+
+        static BuildId fromNotes(void const *notes, std::size_t size) noexcept;
+
+        bool operator<(BuildId const &rhs) const noexcept;
+        bool operator==(BuildId const &rhs) const noexcept;
+    };
+
+    /**
+    ** \class OffsetCache
+    ** \brief Offsets of resolved symbols, saved across runs.
+    **
+    ** The cache file is mapped read-only when the cache is built. It holds,
+    ** for each object build-id, the offset from the object's load base of
+    ** every symbol looked up in it by a LinuxCachedBackend. A backend
+    ** opening an object whose build-id is in the file serves these symbols
+    ** as base + offset, without calling dlsym.
+    **
+    ** A build-id identifies the exact content of an object: when a library
+    ** is rebuilt, its new build-id matches nothing, and its old entries are
+    ** dropped by the next save(). Objects without a build-id are never
+    ** cached. The file is checksummed and bounds checked when mapped, and
+    ** ignored as a whole if anything is off.
+    **
+    ** Symbols resolved through dlsym are recorded in memory, and only
+    ** written by save(), which replaces the file atomically. The mapped
+    ** file isn't reloaded: new entries are only used by the next run.
+    **
+    ** The cache must outlive the backends using it. It can be shared by
+    ** any number of them, from any number of threads.
+    */
+    class OffsetCache {
+        public:
+            /**
+            ** \brief The cached symbols of one object, in the mapped file.
+            **
+            ** An empty view has no symbol.
+            */
+            struct View {
+                void const *library = nullptr;
+
+                [[nodiscard]]
+                bool empty() const noexcept { return library == nullptr; }
+            };
+
+            explicit OffsetCache(std::string const &path) noexcept;
+            OffsetCache(OffsetCache const &) = delete;
+
+            ~OffsetCache();
+
+            OffsetCache &operator=(OffsetCache const &) = delete;
+
+            [[nodiscard]]
+            std::string const &getPath() const noexcept;
+            [[nodiscard]]
+            bool isLoaded() const noexcept;
+            [[nodiscard]]
+            std::size_t size() const noexcept;
+
+            View attach(BuildId const &id, std::string const &object, std::uint64_t extent) noexcept;
+            [[nodiscard]]
+            bool find(View view, utils::ZStringView name, std::uint64_t &offset) const noexcept;
+            void record(BuildId const &id, utils::ZStringView name, std::uint64_t offset) noexcept;
+
+            bool save() const noexcept;
+
+            static BuildId readBuildId(void *hndl, std::uint64_t *extent = nullptr) noexcept;
+
+        private:
+            /**
+            ** \brief What is known about an object seen in this run.
+            */
+            struct Pending {
+                std::string object;
+                std::uint64_t extent;
+                std::unordered_map<std::string, std::uint64_t> symbols;
+            };
+
+            bool validate() const noexcept;
+            void unmap() noexcept;
+
+        private:
+            std::string _path;
+            unsigned char const *_map;
+            std::size_t _size;
+
+            mutable std::mutex _lock;
+            std::map<BuildId, Pending> _pending;
+    };
+}
+
+#endif
@@ -0,0 +1,31 @@
+/**
+** \file ProcPath.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 23:50
+** \date Last update: 2026-10-16 23:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <atomic>
+#include <cstdint>
+
+#include "./ProcPath.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /*
+    ** The bits of a process wide counter are spelled as "//" or "/.",
+    ** which the kernel resolves to the /proc/self/fd directory all the
+    ** same.
+    */
+    std::string procPath(int fd) {
+        static std::atomic<std::uint64_t> loads{0};
+        std::uint64_t n = loads.fetch_add(1, std::memory_order_relaxed);
+        std::string path = "/proc/self/fd/.";
+
+        for (; n != 0; n >>= 1)
+            path += (n & 1) != 0 ? "/." : "//";
+
+        return path + "/" + std::to_string(fd);
+    }
+}
@@ -0,0 +1,33 @@
+/**
+** \file ProcPath.hpp
+** Unique /proc/self/fd paths, to dlopen() an opened descriptor.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 23:50
+** \date Last update: 2026-10-16 23:50
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef ProcPath_hpp_
+#define ProcPath_hpp_
+
+#include <string>
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \brief Get a path to an opened descriptor, never returned before.
+    **
+    ** dlopen() returns the object already loaded under the same name
+    ** without looking at the file, and descriptor numbers are reused, so
+    ** that "/proc/self/fd/N" may name a library opened through an older
+    ** descriptor, still loaded. Every call gives a different spelling of
+    ** that path instead.
+    **
+    ** \param fd The descriptor.
+    **
+    ** \throw std::bad_alloc if the path can't be allocated.
+    */
+    std::string procPath(int fd);
+}
+
+#endif
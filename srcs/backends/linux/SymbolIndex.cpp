@@ -0,0 +1,88 @@
+/**
+** \file SymbolIndex.cpp
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 14:20
+** \date Last update: 2026-10-16 17:20
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "./SymbolIndex.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    namespace {
+        bool nameLess(SymbolInfo const &lhs, SymbolInfo const &rhs) {
+            return std::strcmp(lhs.name, rhs.name) < 0;
+        }
+    }
+
+    SymbolIndex::SymbolIndex() noexcept : _symbols() {}
+
+    SymbolIndex::SymbolIndex(ElfImage const &image) : _symbols() {
+        std::uint32_t count = image.getSymbolCount();
+
+        _symbols.reserve(count);
+        for (std::uint32_t idx = 0; idx < count; ++idx) {
+            ElfImage::Sym const *sym = image.getSymbol(idx);
+
+            if (!ElfImage::isDefined(sym) || image.isHidden(idx))
+                continue;
+
+            unsigned char type = ElfImage::symbolType(sym);
+
+            _symbols.push_back({
+                image.getName(sym),
+                type == STT_TLS ? nullptr : image.getAddress(sym),
+                static_cast<std::size_t>(sym->st_size),
+                type,
+                ElfImage::symbolBind(sym)
+            });
+        }
+
+        std::sort(_symbols.begin(), _symbols.end(), &nameLess);
+    }
+
+    SymbolIndex::const_iterator SymbolIndex::begin() const noexcept {
+        return _symbols.begin();
+    }
+
+    SymbolIndex::const_iterator SymbolIndex::end() const noexcept {
+        return _symbols.end();
+    }
+
+    std::size_t SymbolIndex::size() const noexcept {
+        return _symbols.size();
+    }
+
+    bool SymbolIndex::empty() const noexcept {
+        return _symbols.empty();
+    }
+
+    SymbolInfo const *SymbolIndex::find(std::string_view name) const noexcept {
+        auto it = std::lower_bound(_symbols.begin(), _symbols.end(), name,
+            [](SymbolInfo const &info, std::string_view n) {
+                return std::string_view(info.name) < n;
+            });
+
+        if (it == _symbols.end() || name != it->name)
+            return nullptr;
+
+        return &*it;
+    }
+
+    SymbolIndex::Range SymbolIndex::withPrefix(std::string_view prefix) const noexcept {
+        auto first = std::lower_bound(_symbols.begin(), _symbols.end(), prefix,
+            [](SymbolInfo const &info, std::string_view p) {
+                return std::string_view(info.name).substr(0, p.size()) < p;
+            });
+        auto last = std::upper_bound(first, _symbols.end(), prefix,
+            [](std::string_view p, SymbolInfo const &info) {
+                return p < std::string_view(info.name).substr(0, p.size());
+            });
+
+        return {first, last};
+    }
+}
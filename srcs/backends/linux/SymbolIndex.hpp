@@ -0,0 +1,86 @@
+/**
+** \file SymbolIndex.hpp
+** Sorted index of the symbols exported by a loaded ELF object.
+**
+** \author Phantomas <phantomas@phantomas.xyz>
+** \date Created on: 2026-10-16 14:20
+** \date Last update: 2026-10-16 17:20
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef SymbolIndex_hpp_
+#define SymbolIndex_hpp_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "./ElfImage.hpp"
+
+namespace clonixin::dynamicloader::backends::_linux {
+    /**
+    ** \brief Description of an exported symbol.
+    **
+    ** name points in the string table of the object, and stays valid as long
+    ** as the object is loaded. For STT_TLS symbols, address is null, as their
+    ** address depends on the calling thread. For STT_GNU_IFUNC symbols,
+    ** address is the one of the resolver.
+    */
+    struct SymbolInfo {
+        char const *name;
+        void *address;
+        std::size_t size;
+        unsigned char type;
+        unsigned char binding;
+    };
+
+    /**
+    ** \class SymbolIndex
+    ** \brief Every defined dynamic symbols of an object, sorted by name.
+    **
+    ** The index is built once from the .dynsym table of an object, without
+    ** any dlsym call. Iterating over it enumerates every exported symbols,
+    ** and prefix queries, such as every symbols starting with "codec_", are
+    ** answered with two binary searches.
+    */
+    class SymbolIndex {
+        public:
+            using const_iterator = std::vector<SymbolInfo>::const_iterator;
+
+            /**
+            ** \brief A range of symbols, usable in range-based for loops.
+            */
+            struct Range {
+                const_iterator first;
+                const_iterator last;
+
+                const_iterator begin() const noexcept { return first; }
+                const_iterator end() const noexcept { return last; }
+                std::size_t size() const noexcept { return static_cast<std::size_t>(last - first); }
+                bool empty() const noexcept { return first == last; }
+            };
+
+            SymbolIndex() noexcept;
+            explicit SymbolIndex(ElfImage const &image);
+
+            [[nodiscard]]
+            const_iterator begin() const noexcept;
+            [[nodiscard]]
+            const_iterator end() const noexcept;
+            [[nodiscard]]
+            std::size_t size() const noexcept;
+            [[nodiscard]]
+            bool empty() const noexcept;
+
+            [[nodiscard]]
+            SymbolInfo const *find(std::string_view name) const noexcept;
+            [[nodiscard]]
+            Range withPrefix(std::string_view prefix) const noexcept;
+
+        private:
+            std::vector<SymbolInfo> _symbols;
+    };
+}
+
+#endif
@@ -4,7 +4,7 @@
 **
 ** \author Phantomas <phantomas@phantomas.xyz>
 ** \date Created on: 2020-04-27 17:37
-** \date Last update: 2020-05-08 15:39
+** \date Last update: 2026-10-16 22:10
 ** \copyright GNU Lesser Public Licence v3
 */
 
@@ -12,16 +12,32 @@
 #define backends_linux_hpp_
 
     #include "./LinuxBackend.hpp"
+    #include "./HandleRegistry.hpp"
+    #include "./LinuxSharedBackend.hpp"
+    #include "./SymbolIndex.hpp"
+    #include "./ElfFile.hpp"
 
     #ifdef _GNU_SOURCE
         #include "./LinuxScopedBackend.hpp"
+        #include "./NamespacePool.hpp"
+        #include "./LinuxElfBackend.hpp"
+        #include "./OffsetCache.hpp"
+        #include "./LinuxCachedBackend.hpp"
+        #include "./LinuxMemoryBackend.hpp"
+        #include "./Bundle.hpp"
+        #include "./LinuxBundleBackend.hpp"
     #endif
 
 namespace clonixin::dynamicloader::backends {
     using DefaultBackend = _linux::LinuxBackend;
+    using SharedBackend = _linux::LinuxSharedBackend;
 
     #ifdef _GNU_SOURCE
         using ScopedBackend = _linux::LinuxScopedBackend;
+        using ElfBackend = _linux::LinuxElfBackend;
+        using CachedBackend = _linux::LinuxCachedBackend;
+        using MemoryBackend = _linux::LinuxMemoryBackend;
+        using BundleBackend = _linux::LinuxBundleBackend;
     #endif
 
     /**
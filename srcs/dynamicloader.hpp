@@ -7,7 +7,7 @@
 **
 ** \author phantomas <phantomas@phantomas.xyz>
 ** \date Creation: 2020-04-19 02:15
-** \date Last update: 2020-04-29 02:23
+** \date Last update: 2026-10-16 22:30
 ** \copyright GNU Lesser Public Licence v3
 */
 
@@ -15,19 +15,31 @@
 #define dynamicloader_hpp_
 
 #include "BasicLoader/BasicLoader.hpp"
+#include "BasicLoader/AsyncOpener.hpp"
+#include "BasicLoader/LazySymbol.hpp"
 #include "exceptions/exceptions.hpp"
 
 #include "backends/backends.hpp"
 
+#ifdef __linux__
+#include "PluginDirectory/PluginDirectory.hpp"
+#include "HotReloader/HotReloader.hpp"
+#include "ShardedLoader/ShardedLoader.hpp"
+#include "audit/LoadProfile.hpp"
+#endif
+
 /**
 ** \namespace clonixin::dynamicloader
 ** \brief Main namespace for Clonixin's dynamicloader library.
 **
 ** This namespace contains all classes used in the library, the main wrapper,
 ** and an alias on the default backend, depending on the target platform.
+** SharedLoader uses a backend whose handles are shared, process wide, with
+** every other SharedLoader opening the same library.
 */
 namespace clonixin::dynamicloader {
-    using DefaultLoader = BasicLoader<DefaultBackend>;
+    using DefaultLoader = BasicLoader<backends::DefaultBackend>;
+    using SharedLoader = BasicLoader<backends::SharedBackend>;
 }
 
 #endif
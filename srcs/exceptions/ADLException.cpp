@@ -4,10 +4,13 @@
 **
 ** \author phantomas <phantomas@phantomas.xyz>
 ** \date Creation: 2020-04-19 19:31
-** \date Last Update: 2020-04-19 20:20
+** \date Last Update: 2026-10-16 20:30
 ** \copyright GNU Lesser Public Licence v3
 */
 
+#include "utils/Metrics.hpp"
+#include "utils/Trace.hpp"
+
 #include "./ADLException.hpp"
 
 namespace clonixin::dynamicloader::exceptions {
@@ -19,7 +22,10 @@ namespace clonixin::dynamicloader::exceptions {
     ** \param what Human-ish readable string, describing the error.
     */
     ADLException::ADLException(std::string name, std::string what)
-        : std::runtime_error(what), _name(name) {}
+        : std::runtime_error(what), _name(name) {
+        utils::Metrics::add(utils::Metrics::Counter::Exceptions);
+        utils::Trace::instant(utils::Trace::Kind::Error, _name);
+    }
 
     /**
     ** \brief C-style string based constructor.
@@ -29,7 +35,10 @@ namespace clonixin::dynamicloader::exceptions {
     ** \param what Human-ish readable string, describing the error.
     */
     ADLException::ADLException(char const *name, char const * what)
-        : std::runtime_error(what), _name(name) {}
+        : std::runtime_error(what), _name(name) {
+        utils::Metrics::add(utils::Metrics::Counter::Exceptions);
+        utils::Trace::instant(utils::Trace::Kind::Error, _name);
+    }
 
     /**
     ** \brief Get the name of the symbol of file that caused the exception.
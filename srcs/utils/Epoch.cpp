@@ -0,0 +1,216 @@
+/**
+** \file utils/Epoch.cpp
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:05
+** \date Last update: 2026-10-16 23:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "utils/Epoch.hpp"
+
+namespace clonixin::dynamicloader::utils {
+    namespace {
+        /*
+        ** Epoch announced by a thread, 0 when it's not pinned. Records are
+        ** never freed: a record released by an exiting thread is reused by
+        ** the next new one.
+        */
+        struct alignas(64) Record {
+            std::atomic<std::uint64_t> epoch{0};
+            std::atomic<bool> used{true};
+            Record *next = nullptr;
+        };
+
+        struct Retired {
+            std::uint64_t tag;
+            Epoch::Release release;
+            void *resource;
+        };
+
+        /*
+        ** The state is never destroyed, as threads may still pin, and
+        ** backends may still be destroyed, while exit() destroys statics.
+        */
+        struct State {
+            std::atomic<std::uint64_t> global{1};
+            std::atomic<Record *> records{nullptr};
+            std::mutex lock;
+            std::vector<Retired> retired;
+        };
+
+        State &state() noexcept {
+            static State *s = new State();
+
+            return *s;
+        }
+
+        Record *acquireRecord() {
+            State &s = state();
+
+            for (Record *rec = s.records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next) {
+                bool expected = false;
+
+                if (rec->used.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                    return rec;
+            }
+
+            Record *rec = new Record();
+            Record *head = s.records.load(std::memory_order_relaxed);
+
+            do {
+                rec->next = head;
+            } while (!s.records.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+
+            return rec;
+        }
+
+        struct Participant {
+            Participant() : record(acquireRecord()), nesting(0) {}
+            ~Participant() {
+                record->epoch.store(0, std::memory_order_release);
+                record->used.store(false, std::memory_order_release);
+            }
+
+            Record *record;
+            unsigned nesting;
+        };
+
+        Participant &self() {
+            thread_local Participant participant;
+
+            return participant;
+        }
+    }
+
+    /*
+    ** The fence orders the announcement of the epoch before any load made
+    ** while pinned. It pairs with the one in collect(): either collect()
+    ** sees this thread pinned, or this thread sees the resource already
+    ** unlinked.
+    */
+    void Epoch::pin() noexcept {
+        Participant &p = self();
+
+        if (p.nesting++ == 0) {
+            p.record->epoch.store(state().global.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void Epoch::unpin() noexcept {
+        Participant &p = self();
+
+        if (p.nesting != 0 && --p.nesting == 0)
+            p.record->epoch.store(0, std::memory_order_release);
+    }
+
+    bool Epoch::isPinned() noexcept {
+        return self().nesting != 0;
+    }
+
+    /*
+    ** The resource must already be unreachable. It's tagged with the
+    ** current epoch, which is then advanced: threads pinning from now on
+    ** announce a greater epoch, and can't reach the resource.
+    **
+    ** If it can't be queued, the resource is released after waiting for
+    ** the other threads, or leaked if the caller is pinned, as waiting
+    ** would then never end.
+    */
+    void Epoch::retire(Release release, void *resource) noexcept {
+        State &s = state();
+        std::uint64_t tag = s.global.fetch_add(1, std::memory_order_seq_cst);
+
+        try {
+            std::lock_guard<std::mutex> lock(s.lock);
+
+            s.retired.push_back({tag, release, resource});
+        } catch (...) {
+            if (isPinned())
+                return;
+
+            synchronize();
+            release(resource);
+            return;
+        }
+
+        (void)collect();
+    }
+
+    /*
+    ** Release functions are called without holding the lock, as they may
+    ** run library destructors, which may retire resources themselves.
+    */
+    std::size_t Epoch::collect() noexcept {
+        State &s = state();
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        std::vector<Retired> ready;
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for (Record *rec = s.records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next) {
+            std::uint64_t epoch = rec->epoch.load(std::memory_order_acquire);
+
+            if (epoch != 0 && epoch < oldest)
+                oldest = epoch;
+        }
+
+        try {
+            std::lock_guard<std::mutex> lock(s.lock);
+            auto keep = s.retired.begin();
+
+            for (auto it = s.retired.begin(); it != s.retired.end(); ++it) {
+                if (it->tag < oldest)
+                    ready.push_back(*it);
+                else
+                    *keep++ = *it;
+            }
+            s.retired.erase(keep, s.retired.end());
+        } catch (...) {
+            return 0;
+        }
+
+        for (auto const &item : ready)
+            item.release(item.resource);
+
+        return ready.size();
+    }
+
+    /*
+    ** Waits for every thread pinned before the call. Must not be called
+    ** while pinned, as it would wait for itself.
+    */
+    void Epoch::synchronize() noexcept {
+        State &s = state();
+        std::uint64_t target = s.global.fetch_add(1, std::memory_order_seq_cst);
+
+        for (;;) {
+            bool pinned = false;
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            for (Record *rec = s.records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next) {
+                std::uint64_t epoch = rec->epoch.load(std::memory_order_acquire);
+
+                pinned = pinned || (epoch != 0 && epoch <= target);
+            }
+
+            if (!pinned)
+                break;
+            std::this_thread::yield();
+        }
+
+        (void)collect();
+    }
+
+    std::size_t Epoch::getPending() noexcept {
+        State &s = state();
+        std::lock_guard<std::mutex> lock(s.lock);
+
+        return s.retired.size();
+    }
+}
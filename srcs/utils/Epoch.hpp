@@ -0,0 +1,84 @@
+/**
+** \file utils/Epoch.hpp
+** Header defining Epoch, a process wide epoch based reclamation scheme,
+** and EpochGuard.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 19:05
+** \date Last update: 2026-10-16 23:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef utils_Epoch_hpp_
+#define utils_Epoch_hpp_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace clonixin::dynamicloader::utils {
+    /**
+    ** \class Epoch
+    ** \brief Defers the release of resources until no thread can still be
+    ** using them.
+    **
+    ** A thread pins the current epoch before using a shared resource, such
+    ** as code or data of a library, and unpins it when done. A resource
+    ** that is no longer reachable is retired, along with the function
+    ** releasing it. That function is only called once every thread that
+    ** was pinned when the resource was retired has unpinned.
+    **
+    ** pin() and unpin() only write to a cache line owned by the calling
+    ** thread, and can be nested. The only shared write is the increment of
+    ** the global epoch, done by retire(), which is expected to be rare.
+    **
+    ** Retired resources are released by retire() itself when no thread is
+    ** pinned, or by a later call to retire() or collect(). As long as no
+    ** thread ever pins, retiring a resource releases it immediately.
+    **
+    ** retire() may be called while pinned. If the resource can't be queued
+    ** for lack of memory, it's released after waiting for pinned threads,
+    ** or leaked if the calling thread is pinned itself.
+    */
+    class Epoch {
+        public:
+            /**
+            ** \brief Function releasing a retired resource.
+            */
+            using Release = void (*)(void *);
+
+            Epoch() = delete;
+
+            static void pin() noexcept;
+            static void unpin() noexcept;
+            [[nodiscard]]
+            static bool isPinned() noexcept;
+
+            static void retire(Release release, void *resource) noexcept;
+            static std::size_t collect() noexcept;
+            static void synchronize() noexcept;
+
+            [[nodiscard]]
+            static std::size_t getPending() noexcept;
+    };
+
+    /**
+    ** \class EpochGuard
+    ** \brief Keeps the epoch pinned for the lifetime of the guard.
+    **
+    **     {
+    **         utils::EpochGuard guard;
+    **         plugin_entry(args);
+    **     }
+    */
+    class EpochGuard {
+        public:
+            EpochGuard() noexcept { Epoch::pin(); }
+            EpochGuard(EpochGuard const &) = delete;
+            ~EpochGuard() { Epoch::unpin(); }
+
+            EpochGuard &operator=(EpochGuard const &) = delete;
+    };
+}
+
+#endif
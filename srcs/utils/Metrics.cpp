@@ -0,0 +1,273 @@
+/**
+** \file utils/Metrics.cpp
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:10
+** \date Last update: 2026-10-16 23:25
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <sstream>
+
+#include "utils/Metrics.hpp"
+
+namespace clonixin::dynamicloader::utils {
+    namespace {
+        using Counter = Metrics::Counter;
+        using Latency = Metrics::Latency;
+
+        struct alignas(64) Shard {
+            std::atomic<std::uint64_t> counters[Metrics::counter_count] = {};
+            std::atomic<std::uint64_t> buckets[Metrics::latency_count][Metrics::bucket_count] = {};
+            std::atomic<std::uint64_t> sums[Metrics::latency_count] = {};
+            std::atomic<bool> used{true};
+            Shard *next = nullptr;
+        };
+
+        /*
+        ** Never destroyed, as threads may still record events while exit()
+        ** destroys statics.
+        */
+        std::atomic<Shard *> &shards() noexcept {
+            static std::atomic<Shard *> *head = new std::atomic<Shard *>(nullptr);
+
+            return *head;
+        }
+
+        Shard *acquireShard() {
+            for (Shard *shard = shards().load(std::memory_order_acquire); shard != nullptr; shard = shard->next) {
+                bool expected = false;
+
+                if (shard->used.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                    return shard;
+            }
+
+            Shard *shard = new Shard();
+            Shard *head = shards().load(std::memory_order_relaxed);
+
+            do {
+                shard->next = head;
+            } while (!shards().compare_exchange_weak(head, shard, std::memory_order_release, std::memory_order_relaxed));
+
+            return shard;
+        }
+
+        struct Owner {
+            Owner() : shard(acquireShard()) {}
+            ~Owner() { shard->used.store(false, std::memory_order_release); }
+
+            Shard *shard;
+        };
+
+        Shard &local() {
+            thread_local Owner owner;
+
+            return *owner.shard;
+        }
+
+        /*
+        ** Only the owning thread writes to a shard, so a plain load and
+        ** store is enough, and avoids a locked instruction. The atomics
+        ** only make the concurrent reads of snapshot() well defined.
+        */
+        void bump(std::atomic<std::uint64_t> &value, std::uint64_t n) noexcept {
+            value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        std::size_t bucketOf(std::uint64_t ns) noexcept {
+            std::size_t bucket = 63 - __builtin_clzll(ns | 1);
+
+            return bucket < Metrics::bucket_count ? bucket : Metrics::bucket_count - 1;
+        }
+    }
+
+    /**
+    ** \brief Get the value of a counter.
+    **
+    ** \param c Counter to read.
+    **
+    ** \return Number of events.
+    */
+    std::uint64_t Metrics::Snapshot::operator[](Counter c) const noexcept {
+        return counters[static_cast<std::size_t>(c)];
+    }
+
+    /**
+    ** \brief Get the latency distribution of an operation.
+    **
+    ** \param l Operation to read.
+    **
+    ** \return The histogram of the operation.
+    */
+    Metrics::Histogram const &Metrics::Snapshot::operator[](Latency l) const noexcept {
+        return latencies[static_cast<std::size_t>(l)];
+    }
+
+    /**
+    ** \brief Get the events recorded between two snapshots.
+    **
+    ** \param since Earlier snapshot.
+    **
+    ** \return A snapshot holding the difference.
+    */
+    Metrics::Snapshot Metrics::Snapshot::operator-(Snapshot const &since) const noexcept {
+        Snapshot diff;
+
+        for (std::size_t c = 0; c < counter_count; ++c)
+            diff.counters[c] = counters[c] - since.counters[c];
+
+        for (std::size_t l = 0; l < latency_count; ++l) {
+            for (std::size_t b = 0; b < bucket_count; ++b)
+                diff.latencies[l].buckets[b] = latencies[l].buckets[b] - since.latencies[l].buckets[b];
+            diff.latencies[l].count = latencies[l].count - since.latencies[l].count;
+            diff.latencies[l].sum_ns = latencies[l].sum_ns - since.latencies[l].sum_ns;
+        }
+
+        return diff;
+    }
+
+    /**
+    ** \brief Enable or disable the recording of events.
+    **
+    ** \param enabled Whether events should be recorded.
+    */
+    void Metrics::setEnabled(bool enabled) noexcept {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+    ** \brief Count events, if metrics are enabled.
+    **
+    ** \param c Counter to increment.
+    ** \param n Number of events.
+    */
+    void Metrics::add(Counter c, std::uint64_t n) noexcept {
+        if (isEnabled())
+            bump(local().counters[static_cast<std::size_t>(c)], n);
+    }
+
+    /**
+    ** \brief Record the latency of an operation, if metrics are enabled.
+    **
+    ** \param l Operation.
+    ** \param ns Duration of the operation, in nanoseconds.
+    */
+    void Metrics::record(Latency l, std::uint64_t ns) noexcept {
+        if (!isEnabled())
+            return;
+
+        Shard &shard = local();
+
+        bump(shard.buckets[static_cast<std::size_t>(l)][bucketOf(ns)], 1);
+        bump(shard.sums[static_cast<std::size_t>(l)], ns);
+    }
+
+    /**
+    ** \brief Sum the counters of every thread.
+    **
+    ** Threads keep recording while the snapshot is taken, so the counters
+    ** are not read at a single point in time, but each of them is exact.
+    **
+    ** \return The current value of every counter and histogram.
+    */
+    Metrics::Snapshot Metrics::snapshot() {
+        Snapshot snap;
+
+        for (Shard *shard = shards().load(std::memory_order_acquire); shard != nullptr; shard = shard->next) {
+            for (std::size_t c = 0; c < counter_count; ++c)
+                snap.counters[c] += shard->counters[c].load(std::memory_order_relaxed);
+
+            for (std::size_t l = 0; l < latency_count; ++l) {
+                Histogram &h = snap.latencies[l];
+
+                for (std::size_t b = 0; b < bucket_count; ++b) {
+                    std::uint64_t n = shard->buckets[l][b].load(std::memory_order_relaxed);
+
+                    h.buckets[b] += n;
+                    h.count += n;
+                }
+                h.sum_ns += shard->sums[l].load(std::memory_order_relaxed);
+            }
+        }
+
+        return snap;
+    }
+
+    /**
+    ** \brief Format a snapshot in the Prometheus text format.
+    **
+    ** Counters are named dynamicloader_<counter>_total. Histograms are
+    ** named dynamicloader_<operation>_ns, with cumulative buckets. The
+    ** bound of a bucket is inclusive, so that of bucket b is 2^(b + 1) - 1:
+    ** an operation taking exactly 2^(b + 1) nanoseconds is counted in the
+    ** next one.
+    **
+    ** \param snap Snapshot to format.
+    **
+    ** \return The formatted snapshot.
+    */
+    std::string Metrics::toText(Snapshot const &snap) {
+        std::ostringstream out;
+
+        for (std::size_t c = 0; c < counter_count; ++c) {
+            std::string metric = std::string("dynamicloader_") + name(static_cast<Counter>(c)) + "_total";
+
+            out << "# TYPE " << metric << " counter\n";
+            out << metric << " " << snap.counters[c] << "\n";
+        }
+
+        for (std::size_t l = 0; l < latency_count; ++l) {
+            std::string metric = std::string("dynamicloader_") + name(static_cast<Latency>(l)) + "_ns";
+            Histogram const &h = snap.latencies[l];
+            std::uint64_t cumulated = 0;
+
+            out << "# TYPE " << metric << " histogram\n";
+            for (std::size_t b = 0; b + 1 < bucket_count; ++b) {
+                cumulated += h.buckets[b];
+                out << metric << "_bucket{le=\"" << (std::uint64_t(1) << (b + 1)) - 1 << "\"} " << cumulated << "\n";
+            }
+            out << metric << "_bucket{le=\"+Inf\"} " << h.count << "\n";
+            out << metric << "_sum " << h.sum_ns << "\n";
+            out << metric << "_count " << h.count << "\n";
+        }
+
+        return out.str();
+    }
+
+    /**
+    ** \brief Get the name of a counter.
+    **
+    ** \param c Counter.
+    **
+    ** \return A snake case name.
+    */
+    char const *Metrics::name(Counter c) noexcept {
+        switch (c) {
+            case Counter::Opens: return "opens";
+            case Counter::Closes: return "closes";
+            case Counter::Lookups: return "lookups";
+            case Counter::Hits: return "hits";
+            case Counter::Misses: return "misses";
+            case Counter::NotFound: return "not_found";
+            case Counter::NullSymbols: return "null_symbols";
+            case Counter::Exceptions: return "exceptions";
+            default: return "unknown";
+        }
+    }
+
+    /**
+    ** \brief Get the name of an operation.
+    **
+    ** \param l Operation.
+    **
+    ** \return A snake case name.
+    */
+    char const *Metrics::name(Latency l) noexcept {
+        switch (l) {
+            case Latency::Dlopen: return "dlopen";
+            case Latency::Dlsym: return "dlsym";
+            case Latency::Dlclose: return "dlclose";
+            default: return "unknown";
+        }
+    }
+}
@@ -0,0 +1,171 @@
+/**
+** \file utils/Metrics.hpp
+** Header defining Metrics, the optional instrumentation of loaders and
+** backends.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:10
+** \date Last update: 2026-10-16 23:25
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef utils_Metrics_hpp_
+#define utils_Metrics_hpp_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace clonixin::dynamicloader::utils {
+    /**
+    ** \class Metrics
+    ** \brief Process wide counters and latency histograms of the loaders
+    ** and backends.
+    **
+    ** Metrics are disabled by default, in which case recording an event
+    ** costs a single load of a read only flag. Once enabled, events are
+    ** recorded in a block of counters owned by the calling thread, which
+    ** no other thread ever writes, so the lookup path doesn't share any
+    ** cache line with other threads. Blocks are only summed when a
+    ** snapshot is taken. Blocks of exited threads are kept, and reused by
+    ** new threads, so no event is lost.
+    **
+    ** Counters are never reset: two snapshots can be subtracted to get the
+    ** events of a period of time.
+    **
+    ** Latencies are recorded in log2 buckets: bucket i counts the
+    ** operations that took from 2^i to 2^(i + 1) - 1 nanoseconds.
+    */
+    class Metrics {
+        public:
+            /**
+            ** \brief Counted events.
+            **
+            ** Hits and Misses refer to the symbol cache of BasicLoader: a
+            ** miss goes through the backend. NotFound and NullSymbols
+            ** count the lookups that failed, and the ones that resolved
+            ** to a null address.
+            */
+            enum class Counter : std::size_t {
+                Opens, Closes, Lookups, Hits, Misses, NotFound, NullSymbols, Exceptions,
+                Count
+            };
+
+            /**
+            ** \brief Timed operations.
+            */
+            enum class Latency : std::size_t {
+                Dlopen, Dlsym, Dlclose,
+                Count
+            };
+
+            static constexpr std::size_t counter_count = static_cast<std::size_t>(Counter::Count);
+            static constexpr std::size_t latency_count = static_cast<std::size_t>(Latency::Count);
+            static constexpr std::size_t bucket_count = 40;
+
+            /**
+            ** \brief Latency distribution of an operation.
+            */
+            struct Histogram {
+                std::array<std::uint64_t, bucket_count> buckets{};
+                std::uint64_t count = 0;
+                std::uint64_t sum_ns = 0;
+            };
+
+            /**
+            ** \brief Sum of every thread's counters, at some point in time.
+            */
+            struct Snapshot {
+                std::array<std::uint64_t, counter_count> counters{};
+                std::array<Histogram, latency_count> latencies{};
+
+                [[nodiscard]]
+                std::uint64_t operator[](Counter c) const noexcept;
+                [[nodiscard]]
+                Histogram const &operator[](Latency l) const noexcept;
+
+                [[nodiscard]]
+                Snapshot operator-(Snapshot const &since) const noexcept;
+            };
+
+            class Timer;
+
+            Metrics() = delete;
+
+            static void setEnabled(bool enabled) noexcept;
+            [[nodiscard]]
+            static bool isEnabled() noexcept;
+
+            static void add(Counter c, std::uint64_t n = 1) noexcept;
+            static void record(Latency l, std::uint64_t ns) noexcept;
+
+            [[nodiscard]]
+            static Snapshot snapshot();
+            [[nodiscard]]
+            static std::string toText(Snapshot const &snap);
+
+            [[nodiscard]]
+            static char const *name(Counter c) noexcept;
+            [[nodiscard]]
+            static char const *name(Latency l) noexcept;
+        private:
+            inline static std::atomic<bool> _enabled{false};
+    };
+
+    /**
+    ** \class Metrics::Timer
+    ** \brief Records the latency of an operation, from its construction
+    ** to its destruction.
+    **
+    ** The clock is only read if metrics are enabled when the timer is
+    ** built.
+    */
+    class Metrics::Timer {
+        public:
+            explicit Timer(Latency l) noexcept;
+            Timer(Timer const &) = delete;
+            ~Timer();
+
+            Timer &operator=(Timer const &) = delete;
+        private:
+            Latency _latency;
+            bool _started;
+            std::chrono::steady_clock::time_point _start;
+    };
+
+    /**
+    ** \brief Check whether events are recorded.
+    **
+    ** \return true if metrics are enabled.
+    */
+    inline bool Metrics::isEnabled() noexcept {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+    ** \brief Start timing an operation.
+    **
+    ** \param l Operation being timed.
+    */
+    inline Metrics::Timer::Timer(Latency l) noexcept
+    : _latency(l), _started(isEnabled()) {
+        if (_started)
+            _start = std::chrono::steady_clock::now();
+    }
+
+    /**
+    ** \brief Record the latency of the operation.
+    */
+    inline Metrics::Timer::~Timer() {
+        if (_started) {
+            auto elapsed = std::chrono::steady_clock::now() - _start;
+
+            record(_latency, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,55 @@
+/**
+** \file utils/StaticName.hpp
+** Header defining StaticName, used to handle symbol names known at compile time.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 11:02
+** \date Last update: 2026-10-16 11:02
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef utils_StaticName_hpp_
+#define utils_StaticName_hpp_
+
+#include <cstdint>
+#include <type_traits>
+
+#include "utils/SymbolCache.hpp"
+
+namespace clonixin::dynamicloader::utils {
+    /**
+    ** \brief Compile time informations on a symbol name.
+    **
+    ** Name must be a reference on a null terminated character array with
+    ** static storage duration, usually declared as a static constexpr
+    ** char array:
+    **
+    **     static constexpr char plugin_entry[] = "plugin_entry";
+    **
+    ** The length and the hash of the name are computed by the compiler.
+    **
+    ** \tparam Name Reference on a constexpr character array.
+    */
+    template <auto &Name>
+    struct StaticName {
+        static_assert(std::is_same_v<std::remove_extent_t<std::remove_reference_t<decltype(Name)>>, char const>,
+                "Symbol name must be a constexpr char array.");
+
+        /**
+        ** \brief Pointer on the first character of the name.
+        */
+        static constexpr char const *data = Name;
+
+        /**
+        ** \brief Length of the name, without the null terminator.
+        */
+        static constexpr std::size_t size = std::extent_v<std::remove_reference_t<decltype(Name)>> - 1;
+
+        /**
+        ** \brief Hash of the name, as computed by hashName().
+        */
+        static constexpr std::uint64_t hash = hashName(Name, size);
+    };
+}
+
+#endif
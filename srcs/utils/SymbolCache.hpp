@@ -0,0 +1,422 @@
+/**
+** \file utils/SymbolCache.hpp
+** Header for SymbolCache, the resolved symbols cache used by BasicLoader.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 10:12
+** \date Last update: 2026-10-16 23:55
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef utils_SymbolCache_hpp_
+#define utils_SymbolCache_hpp_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clonixin::dynamicloader::utils {
+    /**
+    ** \brief Hash a symbol name.
+    **
+    ** This is a 64 bits FNV-1a hash. It's constexpr so that names known at
+    ** compile time can be hashed by the compiler.
+    **
+    ** \param str Pointer on the first character of the name.
+    ** \param len Length of the name.
+    **
+    ** \return The hash of the name.
+    */
+    constexpr std::uint64_t hashName(char const *str, std::size_t len) noexcept {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+
+        for (std::size_t i = 0; i < len; ++i) {
+            h ^= static_cast<unsigned char>(str[i]);
+            h *= 0x100000001b3ull;
+        }
+
+        return h;
+    }
+
+    /**
+    ** \brief Get a new, process-wide unique, generation number.
+    **
+    ** Generation numbers are never reused, so a generation identifies a given
+    ** state of a given cache, and can't be mistaken for the one of another
+    ** cache. The value 0 is never returned.
+    **
+    ** \return A new generation number.
+    */
+    inline std::uint64_t nextGeneration() noexcept {
+        static std::atomic<std::uint64_t> counter{0};
+
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    /**
+    ** \class SymbolCache
+    ** \brief Cache of resolved symbols, keyed by name.
+    **
+    ** This class stores the result of a symbol lookup, be it successful or
+    ** not, so that the following lookups of the same name do not go through
+    ** the backend again.
+    **
+    ** Entries are keyed by the hash of their name, as returned by hashName(),
+    ** which is computed by the caller, and names are passed as views. Looking
+    ** up an entry only costs a hash table probe, and never allocates. The
+    ** name is only copied when a new entry is inserted.
+    **
+    ** find() and insert() can be called concurrently from any number of
+    ** threads. find() never locks: entries are immutable once published, and
+    ** are reached through atomic bucket heads. insert() is serialized by a
+    ** mutex, which is only taken after a cache miss, that is right after a
+    ** call into the backend. When the table grows, the new bucket array is
+    ** published atomically, and the previous ones are kept alive until the
+    ** next call to invalidate(), so that readers never see freed memory.
+    **
+    ** Failed lookups are cached too, but at most MaxMisses of them per
+    ** generation, so that probing for arbitrary names can't grow the cache
+    ** without bound. Past that, insert() refuses new misses, which then go
+    ** through the backend every time.
+    **
+    ** Each state of the cache is tagged by a generation number. Calling
+    ** invalidate() drops every entries and gives the cache a new generation,
+    ** so that anything holding on a previous generation can tell it's stale.
+    ** invalidate() and the move operations require exclusive access.
+    **
+    ** \note References returned by find() and insert() stay valid until the
+    ** next call to invalidate(), or until the cache is destroyed.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    class SymbolCache {
+        public:
+            /**
+            ** \brief Result of a lookup, as stored in the cache.
+            */
+            struct Entry {
+                SymAddr sym;
+                bool has_error;
+                std::string error;
+            };
+
+            SymbolCache() noexcept;
+            SymbolCache(SymbolCache const &) = delete;
+            SymbolCache(SymbolCache &&oth) noexcept;
+            ~SymbolCache() = default;
+
+            SymbolCache &operator=(SymbolCache const &) = delete;
+            SymbolCache &operator=(SymbolCache &&rhs) noexcept;
+
+            [[nodiscard]]
+            Entry const *find(std::string_view name, std::uint64_t hash) const noexcept;
+            Entry const *insert(std::string_view name, std::uint64_t hash, Entry &entry);
+
+            void invalidate() noexcept;
+
+            [[nodiscard]]
+            std::uint64_t getGeneration() const noexcept;
+            [[nodiscard]]
+            std::size_t size() const noexcept;
+            [[nodiscard]]
+            std::size_t getMisses() const noexcept;
+
+            static constexpr std::size_t MaxMisses = 1024;
+        private:
+            struct Item {
+                std::uint64_t hash;
+                std::string name;
+                Entry entry;
+            };
+
+            struct Link {
+                Item const *item;
+                Link const *next;
+            };
+
+            struct Table {
+                explicit Table(std::size_t count);
+
+                std::size_t mask;
+                std::unique_ptr<std::atomic<Link const *>[]> buckets;
+                std::deque<Link> links;
+            };
+
+            static constexpr std::size_t InitialBuckets = 64;
+
+            Entry const *find(Table const *table, std::string_view name, std::uint64_t hash) const noexcept;
+            static void link(Table &table, Item const &item);
+
+            std::atomic<Table const *> _table;
+            std::vector<std::unique_ptr<Table>> _tables;
+            std::deque<Item> _items;
+            std::atomic<std::size_t> _size;
+            std::atomic<std::size_t> _misses;
+            std::mutex _insert_lock;
+            std::uint64_t _generation;
+    };
+
+    /**
+    ** \brief Create an empty bucket array.
+    **
+    ** \param count Number of buckets, which must be a power of two.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    SymbolCache<SymAddr>::Table::Table(std::size_t count)
+    : mask(count - 1), buckets(new std::atomic<Link const *>[count]), links() {
+        for (std::size_t i = 0; i < count; ++i)
+            buckets[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    /**
+    ** \brief Default constructor.
+    **
+    ** Create an empty cache, with a fresh generation. No memory is allocated
+    ** until the first insertion.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    SymbolCache<SymAddr>::SymbolCache() noexcept
+    : _table(nullptr), _tables(), _items(), _size(0), _misses(0), _insert_lock(), _generation(nextGeneration()) {}
+
+    /**
+    ** \brief Move constructor.
+    **
+    ** The entries and the generation are transferred to the new cache. The
+    ** moved-from cache is left empty, with a fresh generation.
+    **
+    ** \param oth SymbolCache to be moved.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    SymbolCache<SymAddr>::SymbolCache(SymbolCache &&oth) noexcept
+    : _table(oth._table.load(std::memory_order_relaxed)), _tables(std::move(oth._tables)),
+    _items(std::move(oth._items)), _size(oth._size.load(std::memory_order_relaxed)),
+    _misses(oth._misses.load(std::memory_order_relaxed)), _insert_lock(), _generation(oth._generation) {
+        oth._table.store(nullptr, std::memory_order_relaxed);
+        oth.invalidate();
+    }
+
+    /**
+    ** \brief Move assignment operator.
+    **
+    ** The entries and the generation are transferred to this cache. The
+    ** moved-from cache is left empty, with a fresh generation.
+    **
+    ** \param rhs SymbolCache to be moved.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return Returns a reference on the object in the left hand side of the operator
+    */
+    template <typename SymAddr>
+    SymbolCache<SymAddr> &SymbolCache<SymAddr>::operator=(SymbolCache &&rhs) noexcept {
+        if (this != std::addressof(rhs)) {
+            _table.store(rhs._table.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _tables = std::move(rhs._tables);
+            _items = std::move(rhs._items);
+            _size.store(rhs._size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _misses.store(rhs._misses.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _generation = rhs._generation;
+
+            rhs._table.store(nullptr, std::memory_order_relaxed);
+            rhs.invalidate();
+        }
+
+        return *this;
+    }
+
+    /**
+    ** \brief Look for a cached lookup result.
+    **
+    ** This function never locks, and can be called concurrently with
+    ** insert().
+    **
+    ** \param name The name of the symbol.
+    ** \param hash The hash of the name, as returned by hashName().
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return A pointer on the cached entry, or nullptr if the name was never
+    ** looked up in the current generation.
+    */
+    template <typename SymAddr>
+    typename SymbolCache<SymAddr>::Entry const *SymbolCache<SymAddr>::find(std::string_view name, std::uint64_t hash) const noexcept {
+        return find(_table.load(std::memory_order_acquire), name, hash);
+    }
+
+    /**
+    ** \brief Store a lookup result.
+    **
+    ** If another thread stored a result for the same name in the meantime,
+    ** this one is discarded, and the existing entry is returned, so that
+    ** every callers observe the same entry.
+    **
+    ** The error message is moved from entry once the entry is stored, and
+    ** left in place otherwise, so that the caller can still report it. If
+    ** an allocation fails, the cache is left unchanged.
+    **
+    ** \param name The name of the symbol.
+    ** \param hash The hash of the name, as returned by hashName().
+    ** \param entry The result returned by the backend.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return A pointer on the cached entry, or nullptr if entry is a
+    ** failed lookup, and MaxMisses of them are already cached.
+    **
+    ** \throw std::bad_alloc if the entry can't be stored.
+    */
+    template <typename SymAddr>
+    typename SymbolCache<SymAddr>::Entry const *SymbolCache<SymAddr>::insert(std::string_view name, std::uint64_t hash, Entry &entry) {
+        std::lock_guard<std::mutex> lock(_insert_lock);
+        Table const *current = _table.load(std::memory_order_relaxed);
+
+        if (Entry const *existing = find(current, name, hash))
+            return existing;
+        if (entry.has_error && _misses.load(std::memory_order_relaxed) >= MaxMisses)
+            return nullptr;
+
+        std::size_t size = _size.load(std::memory_order_relaxed) + 1;
+        std::unique_ptr<Table> table;
+
+        /* Every allocation is made before the cache is changed. */
+        if (current == nullptr || size > (current->mask + 1) * 2) {
+            table = std::make_unique<Table>(current == nullptr ? InitialBuckets : (current->mask + 1) * 4);
+            _tables.reserve(_tables.size() + 1);
+
+            for (Item const &it : _items)
+                link(*table, it);
+        }
+
+        _items.push_back(Item{hash, std::string(name), Entry{entry.sym, entry.has_error, std::string()}});
+
+        Item &item = _items.back();
+
+        /* Readers may find the item as soon as it's linked. */
+        item.entry.error.swap(entry.error);
+        try {
+            link(table != nullptr ? *table : *_tables.back(), item);
+        } catch (...) {
+            item.entry.error.swap(entry.error);
+            _items.pop_back();
+            throw;
+        }
+
+        if (entry.has_error)
+            _misses.fetch_add(1, std::memory_order_relaxed);
+        if (table != nullptr) {
+            _tables.push_back(std::move(table));
+            _table.store(_tables.back().get(), std::memory_order_release);
+        }
+
+        _size.store(size, std::memory_order_relaxed);
+        return &item.entry;
+    }
+
+    /**
+    ** \brief Drop every entries, and start a new generation.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    void SymbolCache<SymAddr>::invalidate() noexcept {
+        _table.store(nullptr, std::memory_order_relaxed);
+        _tables.clear();
+        _items.clear();
+        _size.store(0, std::memory_order_relaxed);
+        _misses.store(0, std::memory_order_relaxed);
+        _generation = nextGeneration();
+    }
+
+    /**
+    ** \brief Get the current generation of the cache.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return The generation number of the cache content.
+    */
+    template <typename SymAddr>
+    std::uint64_t SymbolCache<SymAddr>::getGeneration() const noexcept {
+        return _generation;
+    }
+
+    /**
+    ** \brief Get the number of cached entries.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return The number of cached lookups, negative ones included.
+    */
+    template <typename SymAddr>
+    std::size_t SymbolCache<SymAddr>::size() const noexcept {
+        return _size.load(std::memory_order_relaxed);
+    }
+
+    /**
+    ** \brief Get the number of cached failed lookups.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return The number of negative entries, at most MaxMisses.
+    */
+    template <typename SymAddr>
+    std::size_t SymbolCache<SymAddr>::getMisses() const noexcept {
+        return _misses.load(std::memory_order_relaxed);
+    }
+
+    /**
+    ** \brief Walk the bucket of a given hash in a given table.
+    **
+    ** \param table Bucket array to search, may be nullptr.
+    ** \param name The name of the symbol.
+    ** \param hash The hash of the name.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    **
+    ** \return A pointer on the matching entry, or nullptr.
+    */
+    template <typename SymAddr>
+    typename SymbolCache<SymAddr>::Entry const *SymbolCache<SymAddr>::find(Table const *table, std::string_view name, std::uint64_t hash) const noexcept {
+        if (table == nullptr)
+            return nullptr;
+
+        for (Link const *l = table->buckets[hash & table->mask].load(std::memory_order_acquire); l != nullptr; l = l->next)
+            if (l->item->hash == hash && l->item->name == name)
+                return &l->item->entry;
+
+        return nullptr;
+    }
+
+    /**
+    ** \brief Publish an item in a bucket array.
+    **
+    ** The link is fully built before being stored in the bucket head with
+    ** release semantics, so a reader that sees it also sees the item.
+    **
+    ** \param table Bucket array to update.
+    ** \param item Item to publish.
+    **
+    ** \tparam SymAddr Opaque symbol type of the backend.
+    */
+    template <typename SymAddr>
+    void SymbolCache<SymAddr>::link(Table &table, Item const &item) {
+        std::atomic<Link const *> &head = table.buckets[item.hash & table.mask];
+
+        table.links.push_back(Link{&item, head.load(std::memory_order_relaxed)});
+        head.store(&table.links.back(), std::memory_order_release);
+    }
+}
+
+#endif
@@ -0,0 +1,264 @@
+/**
+** \file utils/Trace.cpp
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:30
+** \date Last update: 2026-10-16 20:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "utils/Trace.hpp"
+
+namespace clonixin::dynamicloader::utils {
+    namespace {
+        constexpr std::size_t name_words = Trace::name_size / sizeof(std::uint64_t);
+
+        /*
+        ** Every field is atomic, so that collect() can read a slot while
+        ** its owner overwrites it. The sequence number tells which event
+        ** the slot holds: 2 * index + 1 while it's written, 2 * index + 2
+        ** once it's complete.
+        */
+        struct Slot {
+            std::atomic<std::uint64_t> seq{0};
+            std::atomic<std::uint64_t> start{0};
+            std::atomic<std::uint64_t> duration{0};
+            std::atomic<std::uint64_t> meta{0};
+            std::atomic<std::uint64_t> name[name_words] = {};
+        };
+
+        struct alignas(64) Ring {
+            std::atomic<std::uint64_t> head{0};
+            std::atomic<bool> used{true};
+            Ring *next = nullptr;
+            Slot slots[Trace::ring_size];
+        };
+
+        /*
+        ** Never destroyed, as threads may still record events while exit()
+        ** destroys statics.
+        */
+        std::atomic<Ring *> &rings() noexcept {
+            static std::atomic<Ring *> *head = new std::atomic<Ring *>(nullptr);
+
+            return *head;
+        }
+
+        Ring *acquireRing() {
+            for (Ring *ring = rings().load(std::memory_order_acquire); ring != nullptr; ring = ring->next) {
+                bool expected = false;
+
+                if (ring->used.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                    return ring;
+            }
+
+            Ring *ring = new Ring();
+            Ring *head = rings().load(std::memory_order_relaxed);
+
+            do {
+                ring->next = head;
+            } while (!rings().compare_exchange_weak(head, ring, std::memory_order_release, std::memory_order_relaxed));
+
+            return ring;
+        }
+
+        struct Owner {
+            Owner() : ring(acquireRing()), tid(static_cast<std::uint32_t>(syscall(SYS_gettid))) {}
+            ~Owner() { ring->used.store(false, std::memory_order_release); }
+
+            Ring *ring;
+            std::uint32_t tid;
+        };
+
+        Owner *local() noexcept {
+            try {
+                thread_local Owner owner;
+
+                return &owner;
+            } catch (...) {
+                return nullptr;
+            }
+        }
+
+        void appendEscaped(std::string &out, std::string const &str) {
+            for (char c : str) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else
+                    out += c;
+            }
+        }
+    }
+
+    /**
+    ** \brief Enable or disable the recording of events.
+    **
+    ** \param enabled Whether events should be recorded.
+    */
+    void Trace::setEnabled(bool enabled) noexcept {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+    ** \brief Record an event in the ring of the calling thread.
+    **
+    ** \param kind Kind of the event.
+    ** \param name Name of the event.
+    ** \param start_ns Time the event started, as returned by now().
+    ** \param duration_ns Duration of the event.
+    */
+    void Trace::record(Kind kind, ZStringView name, std::uint64_t start_ns, std::uint64_t duration_ns) noexcept {
+        if (!isEnabled())
+            return;
+
+        Owner *owner = local();
+        if (owner == nullptr)
+            return;
+
+        Ring &ring = *owner->ring;
+        std::uint64_t idx = ring.head.load(std::memory_order_relaxed);
+        Slot &slot = ring.slots[idx % ring_size];
+        std::uint64_t words[name_words] = {};
+        std::size_t len = std::min(name.size(), name_size - 1);
+
+        std::memcpy(words, name.data() + name.size() - len, len);
+
+        slot.seq.store(2 * idx + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.start.store(start_ns, std::memory_order_relaxed);
+        slot.duration.store(duration_ns, std::memory_order_relaxed);
+        slot.meta.store(static_cast<std::uint64_t>(kind) | static_cast<std::uint64_t>(owner->tid) << 8, std::memory_order_relaxed);
+        for (std::size_t w = 0; w < name_words; ++w)
+            slot.name[w].store(words[w], std::memory_order_relaxed);
+
+        slot.seq.store(2 * idx + 2, std::memory_order_release);
+        ring.head.store(idx + 1, std::memory_order_release);
+    }
+
+    /**
+    ** \brief Record an event without any duration.
+    **
+    ** \param kind Kind of the event.
+    ** \param name Name of the event.
+    */
+    void Trace::instant(Kind kind, ZStringView name) noexcept {
+        if (isEnabled())
+            record(kind, name, now(), 0);
+    }
+
+    /**
+    ** \brief Gather the events of every thread.
+    **
+    ** Events overwritten while they are read are skipped.
+    **
+    ** \return Every event still held by the rings, in start order.
+    */
+    std::vector<Trace::Event> Trace::collect() {
+        std::vector<Event> events;
+
+        for (Ring *ring = rings().load(std::memory_order_acquire); ring != nullptr; ring = ring->next) {
+            std::uint64_t head = ring->head.load(std::memory_order_acquire);
+            std::uint64_t first = head > ring_size ? head - ring_size : 0;
+
+            for (std::uint64_t idx = first; idx < head; ++idx) {
+                Slot const &slot = ring->slots[idx % ring_size];
+                std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+
+                if (seq != 2 * idx + 2)
+                    continue;
+
+                std::uint64_t words[name_words];
+                std::uint64_t start = slot.start.load(std::memory_order_relaxed);
+                std::uint64_t duration = slot.duration.load(std::memory_order_relaxed);
+                std::uint64_t meta = slot.meta.load(std::memory_order_relaxed);
+
+                for (std::size_t w = 0; w < name_words; ++w)
+                    words[w] = slot.name[w].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) != seq)
+                    continue;
+
+                char const *chars = reinterpret_cast<char const *>(words);
+
+                events.push_back({static_cast<Kind>(meta & 0xff), static_cast<std::uint32_t>(meta >> 8),
+                        start, duration, std::string(chars, strnlen(chars, name_size))});
+            }
+        }
+
+        std::sort(events.begin(), events.end(), [](Event const &lhs, Event const &rhs) {
+            return lhs.start_ns < rhs.start_ns;
+        });
+
+        return events;
+    }
+
+    /**
+    ** \brief Export the events of every thread in the Chrome trace format.
+    **
+    ** Events with a duration are complete events, errors are thread scoped
+    ** instant events. Timestamps are in microseconds, with nanosecond
+    ** precision.
+    **
+    ** \param out Stream to write the JSON document to.
+    */
+    void Trace::writeChrome(std::ostream &out) {
+        std::vector<Event> events = collect();
+        long pid = static_cast<long>(getpid());
+        std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        for (std::size_t i = 0; i < events.size(); ++i) {
+            Event const &e = events[i];
+            char buf[160];
+
+            json += i == 0 ? "\n" : ",\n";
+            json += "{\"name\":\"";
+            json += name(e.kind);
+            json += ' ';
+            appendEscaped(json, e.name);
+
+            if (e.kind == Kind::Error)
+                std::snprintf(buf, sizeof(buf), "\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":%ld,\"tid\":%u}",
+                        name(e.kind), e.start_ns / 1000.0, pid, e.tid);
+            else
+                std::snprintf(buf, sizeof(buf), "\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%u}",
+                        name(e.kind), e.start_ns / 1000.0, e.duration_ns / 1000.0, pid, e.tid);
+            json += buf;
+        }
+
+        json += "\n]}\n";
+        out << json;
+    }
+
+    /**
+    ** \brief Get the name of a kind of event.
+    **
+    ** \param kind Kind of event.
+    **
+    ** \return A lower case name, also used as the category of the event.
+    */
+    char const *Trace::name(Kind kind) noexcept {
+        switch (kind) {
+            case Kind::Load: return "load";
+            case Kind::Resolve: return "resolve";
+            case Kind::Reset: return "reset";
+            case Kind::Close: return "close";
+            case Kind::Error: return "error";
+            default: return "unknown";
+        }
+    }
+}
@@ -0,0 +1,165 @@
+/**
+** \file utils/Trace.hpp
+** Header defining Trace, a per thread event recorder exported in the
+** Chrome trace format.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 20:30
+** \date Last update: 2026-10-16 20:30
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef utils_Trace_hpp_
+#define utils_Trace_hpp_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "utils/ZStringView.hpp"
+
+namespace clonixin::dynamicloader::utils {
+    /**
+    ** \class Trace
+    ** \brief Records what the loaders and backends do, and when.
+    **
+    ** Tracing is disabled by default, in which case recording an event
+    ** costs a single load of a read only flag. Once enabled, each thread
+    ** records its events in its own ring buffer, allocated on its first
+    ** event. Recording never allocates afterward, nor takes any lock: when
+    ** a ring is full, its oldest events are overwritten.
+    **
+    ** Events are timed with the monotonic clock, and can be collected at
+    ** any time, from any thread, while other threads keep recording.
+    ** writeChrome() exports them in the Chrome trace event format, which
+    ** chrome://tracing and Perfetto can open.
+    **
+    ** Names longer than name_size - 1 characters keep their end, which is
+    ** the most telling part of a path.
+    */
+    class Trace {
+        public:
+            /**
+            ** \brief Kind of event.
+            */
+            enum class Kind : std::uint8_t {
+                Load, Resolve, Reset, Close, Error
+            };
+
+            static constexpr std::size_t ring_size = 4096;
+            static constexpr std::size_t name_size = 48;
+
+            /**
+            ** \brief A recorded event.
+            **
+            ** Errors are instant events, with a null duration.
+            */
+            struct Event {
+                Kind kind;
+                std::uint32_t tid;
+                std::uint64_t start_ns;
+                std::uint64_t duration_ns;
+                std::string name;
+            };
+
+            class Span;
+
+            Trace() = delete;
+
+            static void setEnabled(bool enabled) noexcept;
+            [[nodiscard]]
+            static bool isEnabled() noexcept;
+
+            [[nodiscard]]
+            static std::uint64_t now() noexcept;
+
+            static void record(Kind kind, ZStringView name, std::uint64_t start_ns, std::uint64_t duration_ns) noexcept;
+            static void instant(Kind kind, ZStringView name) noexcept;
+
+            [[nodiscard]]
+            static std::vector<Event> collect();
+            static void writeChrome(std::ostream &out);
+
+            [[nodiscard]]
+            static char const *name(Kind kind) noexcept;
+        private:
+            inline static std::atomic<bool> _enabled{false};
+    };
+
+    /**
+    ** \class Trace::Span
+    ** \brief Records an event lasting from its construction to its
+    ** destruction.
+    **
+    ** The name is copied when the span starts, so it may be destroyed
+    ** before the span ends. Nothing is done if tracing is disabled when
+    ** the span is built.
+    */
+    class Trace::Span {
+        public:
+            Span(Kind kind, ZStringView name) noexcept;
+            Span(Span const &) = delete;
+            ~Span();
+
+            Span &operator=(Span const &) = delete;
+        private:
+            Kind _kind;
+            std::uint64_t _start;
+            char _name[name_size];
+    };
+
+    /**
+    ** \brief Check whether events are recorded.
+    **
+    ** \return true if tracing is enabled.
+    */
+    inline bool Trace::isEnabled() noexcept {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+    ** \brief Read the clock used to time events.
+    **
+    ** \return The monotonic time, in nanoseconds.
+    */
+    inline std::uint64_t Trace::now() noexcept {
+        auto since = std::chrono::steady_clock::now().time_since_epoch();
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(since).count();
+    }
+
+    /**
+    ** \brief Start an event.
+    **
+    ** \param kind Kind of the event.
+    ** \param name Name of the event, usually a path or a symbol name.
+    */
+    inline Trace::Span::Span(Kind kind, ZStringView name) noexcept
+    : _kind(kind), _start(0) {
+        if (!isEnabled())
+            return;
+
+        std::size_t len = name.size() < name_size ? name.size() : name_size - 1;
+        char const *src = name.data() + name.size() - len;
+
+        for (std::size_t i = 0; i < len; ++i)
+            _name[i] = src[i];
+        _name[len] = '\0';
+
+        _start = now();
+    }
+
+    /**
+    ** \brief End the event, and record it.
+    */
+    inline Trace::Span::~Span() {
+        if (_start != 0)
+            record(_kind, _name, _start, now() - _start);
+    }
+}
+
+#endif
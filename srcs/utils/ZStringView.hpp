@@ -0,0 +1,124 @@
+/**
+** \file utils/ZStringView.hpp
+** Header defining ZStringView, a view on a null terminated string.
+**
+** \author phantomas <phantomas@phantomas.xyz>
+** \date Creation: 2026-10-16 17:05
+** \date Last update: 2026-10-16 17:05
+** \copyright GNU Lesser Public Licence v3
+*/
+
+#ifndef utils_ZStringView_hpp_
+#define utils_ZStringView_hpp_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace clonixin::dynamicloader::utils {
+    /**
+    ** \class ZStringView
+    ** \brief Non owning view on a null terminated string.
+    **
+    ** This class is used to pass symbol names around. It can be implicitly
+    ** built from a string literal, a char const *, or a std::string,
+    ** without copying the characters, and gives access to both the length
+    ** of the string, for hashing and comparisons, and to a null terminated
+    ** pointer, which is what dlsym and the ELF tables need.
+    **
+    ** There is no conversion from std::string_view, as a string_view is not
+    ** guaranteed to be null terminated. Use a std::string, or the
+    ** (pointer, size) constructor if the view is known to be terminated.
+    **
+    ** \warning As any view, a ZStringView must not outlive the string it
+    ** refers to.
+    */
+    class ZStringView {
+        public:
+            /**
+            ** \brief View on a C string.
+            **
+            ** \param str Null terminated string.
+            */
+            constexpr ZStringView(char const *str) noexcept
+            : _data(str), _size(std::char_traits<char>::length(str)) {}
+
+            /**
+            ** \brief View on a C string of known length.
+            **
+            ** \param str Pointer on the first character.
+            ** \param size Length of the string. str[size] must be '\0'.
+            */
+            constexpr ZStringView(char const *str, std::size_t size) noexcept
+            : _data(str), _size(size) {}
+
+            /**
+            ** \brief View on a std::string.
+            **
+            ** \param str String to refer to.
+            */
+            ZStringView(std::string const &str) noexcept
+            : _data(str.c_str()), _size(str.size()) {}
+
+            /**
+            ** \brief Get a pointer on the first character.
+            **
+            ** \return The viewed string, which is null terminated.
+            */
+            [[nodiscard]]
+            constexpr char const *data() const noexcept { return _data; }
+
+            /**
+            ** \brief Get a pointer on the first character.
+            **
+            ** \return The viewed string, which is null terminated.
+            */
+            [[nodiscard]]
+            constexpr char const *c_str() const noexcept { return _data; }
+
+            /**
+            ** \brief Get the length of the string.
+            **
+            ** \return The number of characters, without the null terminator.
+            */
+            [[nodiscard]]
+            constexpr std::size_t size() const noexcept { return _size; }
+
+            /**
+            ** \brief Check whether the string is empty.
+            **
+            ** \return true if the length of the string is 0.
+            */
+            [[nodiscard]]
+            constexpr bool empty() const noexcept { return _size == 0; }
+
+            /**
+            ** \brief Get a std::string_view on the same characters.
+            **
+            ** \return A string_view, without the null terminator.
+            */
+            [[nodiscard]]
+            constexpr std::string_view view() const noexcept { return std::string_view(_data, _size); }
+
+            /**
+            ** \brief Implicit conversion to std::string_view.
+            */
+            constexpr operator std::string_view() const noexcept { return view(); }
+
+            /**
+            ** \brief Copy the viewed characters.
+            **
+            ** \return A new std::string.
+            */
+            [[nodiscard]]
+            std::string str() const { return std::string(_data, _size); }
+
+            constexpr bool operator==(ZStringView const &rhs) const noexcept { return view() == rhs.view(); }
+            constexpr bool operator!=(ZStringView const &rhs) const noexcept { return view() != rhs.view(); }
+        private:
+            char const *_data;
+            std::size_t _size;
+    };
+}
+
+#endif
@@ -4,14 +4,19 @@
 **
 ** \author phantomas <phantomas@phantomas.xyz>
 ** \date Creation: 2020-04-19 01:58
-** \date Last update: 2020-04-28 16:31
+** \date Last update: 2026-10-16 22:55
 ** \copyright GNU Lesser Public Licence v3
 */
 
 #ifndef utils_sfinae_hpp_
 #define utils_sfinae_hpp_
 
+#include <cstddef>
+#include <string>
 #include <type_traits>
+#include <utility>
+
+#include "utils/ZStringView.hpp"
 
 namespace clonixin::dynamicloader {
     /**
@@ -175,6 +180,113 @@ namespace clonixin::dynamicloader {
         */
         template <typename T>
         using refw = std::reference_wrapper<std::remove_reference_t<T>>;
+
+        /**
+        ** \brief SFINAE utility for detecting backends able to resolve
+        ** symbols in batch.
+        **
+        ** hasbatch::value is true if B has a const member function callable
+        ** as getSymbols(utils::ZStringView const *names, std::size_t count,
+        ** B::SymAddr *out, bool *failed, std::string *errors).
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B, typename = void>
+        struct hasbatch : std::false_type {};
+
+        template <typename B>
+        struct hasbatch<B, std::void_t<decltype(std::declval<B const &>().getSymbols(
+            std::declval<utils::ZStringView const *>(), std::size_t(),
+            std::declval<typename B::SymAddr *>(), std::declval<bool *>(), std::declval<std::string *>()
+        ))>> : std::true_type {};
+
+        /**
+        ** \brief SFINAE utility, true if B can resolve symbols in batch.
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B>
+        inline constexpr bool hasbatch_v = hasbatch<B>::value;
+
+        /**
+        ** \brief SFINAE utility for detecting backends with stateless
+        ** lookups.
+        **
+        ** haslookup::value is true if B has const member functions callable
+        ** as lookupSymbol(utils::ZStringView name), returning an object with
+        ** sym, has_error and error members, and as
+        ** containsSymbol(utils::ZStringView name), returning a bool.
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B, typename = void>
+        struct haslookup : std::false_type {};
+
+        template <typename B>
+        struct haslookup<B, std::void_t<
+            decltype(std::declval<B const &>().lookupSymbol(std::declval<utils::ZStringView>()).sym),
+            decltype(std::declval<B const &>().lookupSymbol(std::declval<utils::ZStringView>()).has_error),
+            decltype(std::declval<B const &>().lookupSymbol(std::declval<utils::ZStringView>()).error),
+            decltype(bool(std::declval<B const &>().containsSymbol(std::declval<utils::ZStringView>())))
+        >> : std::true_type {};
+
+        /**
+        ** \brief SFINAE utility, true if B has stateless, const, lookups.
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B>
+        inline constexpr bool haslookup_v = haslookup<B>::value;
+
+        /**
+        ** \brief SFINAE utility for detecting backends able to reject
+        ** missing symbols cheaply.
+        **
+        ** hasprobe::value is true if B has a const member function callable
+        ** as mayContainSymbol(utils::ZStringView name), returning a bool.
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B, typename = void>
+        struct hasprobe : std::false_type {};
+
+        template <typename B>
+        struct hasprobe<B, std::void_t<
+            decltype(bool(std::declval<B const &>().mayContainSymbol(std::declval<utils::ZStringView>())))
+        >> : std::true_type {};
+
+        /**
+        ** \brief SFINAE utility, true if B can reject missing symbols cheaply.
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B>
+        inline constexpr bool hasprobe_v = hasprobe<B>::value;
+
+        /**
+        ** \brief SFINAE utility for detecting backends able to warm up a
+        ** library before opening it.
+        **
+        ** hasprefetch::value is true if B has a static member function
+        ** callable as prefetch(std::string const &path).
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B, typename = void>
+        struct hasprefetch : std::false_type {};
+
+        template <typename B>
+        struct hasprefetch<B, std::void_t<
+            decltype(B::prefetch(std::declval<std::string const &>()))
+        >> : std::true_type {};
+
+        /**
+        ** \brief SFINAE utility, true if B can warm up a library.
+        **
+        ** \tparam B The backend type to check.
+        */
+        template <typename B>
+        inline constexpr bool hasprefetch_v = hasprefetch<B>::value;
     }
 }
 
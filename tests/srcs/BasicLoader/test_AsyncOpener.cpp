@@ -0,0 +1,108 @@
+#include <criterion/criterion.h>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BasicLoader/AsyncOpener.hpp"
+#include "backends/linux/backends.hpp"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace cde = clonixin::dynamicloader::exceptions;
+
+using namespace std::string_literals;
+
+/*
+** Backend recording the order in which it's opened. Opening "gate" blocks
+** until the test releases it, to keep the only worker busy while the
+** queue is filled.
+*/
+static std::mutex order_lock;
+static std::vector<std::string> order;
+static std::shared_future<void> gate;
+
+class OrderBackend {
+    public:
+        using SymAddr = void *;
+
+        OrderBackend(std::string const &path) : _path(path) {
+            if (path == "gate")
+                gate.wait();
+
+            std::lock_guard<std::mutex> lock(order_lock);
+            order.push_back(path);
+        }
+        OrderBackend(OrderBackend &&) noexcept = default;
+        OrderBackend &operator=(OrderBackend &&) noexcept = default;
+
+        bool reset(std::string const &path) noexcept { _path = path; return true; }
+        std::string getPath() const noexcept { return _path; }
+        bool hasSymbol(cd::utils::ZStringView) noexcept { return false; }
+        SymAddr getSymbol(cd::utils::ZStringView) noexcept { return nullptr; }
+        bool hasError() const noexcept { return false; }
+        std::string getLastError() const noexcept { return std::string(); }
+    private:
+        std::string _path;
+};
+
+TestSuite(AsyncOpenerTests);
+
+Test(AsyncOpenerTests, Open, .description = "Open several libraries at once. Every "
+        "loader should be usable once retrieved.") {
+    cd::AsyncOpener opener(4);
+    std::vector<cd::PendingLoader<cdb::DefaultBackend>> pending;
+    char const *paths[] = {"libm.so.6", "libdl.so.2", "libpthread.so.0", "libc.so.6"};
+
+    for (char const *path : paths)
+        pending.push_back(opener.open<cdb::DefaultBackend>(path, 0));
+
+    auto libm = pending[0].get();
+    cr_assert_not_null(libm.getSymbol<void *>("cos"));
+    cr_assert_not(pending[0].valid());
+
+    for (std::size_t i = 1; i < pending.size(); ++i) {
+        auto loader = pending[i].get();
+        cr_assert(loader.hasSymbol("malloc"), "%s should be open", paths[i]);
+    }
+}
+
+Test(AsyncOpenerTests, Failure, .description = "Open a library that does not exist. "
+        "The error should be thrown by get().") {
+    cd::AsyncOpener opener(1);
+    auto pending = opener.open<cdb::DefaultBackend>("libdoes_not_exist.so"s, 0);
+
+    cr_assert_throw((void)pending.get(), cde::DLException<cde::Type::Open>);
+}
+
+Test(AsyncOpenerTests, Priority, .description = "Queue openings with different "
+        "priorities behind a blocked one, and promote one of them. The promoted one "
+        "should run first, then the others by priority.") {
+    std::promise<void> release;
+
+    gate = release.get_future().share();
+    order.clear();
+
+    {
+        cd::AsyncOpener opener(1);
+        auto blocked = opener.open<OrderBackend>("gate"s, 100);
+
+        while (opener.getQueued() != 0)
+            std::this_thread::yield();
+
+        auto low = opener.open<OrderBackend>("low"s, 0);
+        auto high = opener.open<OrderBackend>("high"s, 10);
+        auto waited = opener.open<OrderBackend>("waited"s, -10);
+
+        cr_assert_eq(opener.getQueued(), 3);
+        cr_assert(waited.promote());
+        cr_assert_not(blocked.promote(), "A running opening can't be promoted.");
+
+        release.set_value();
+        (void)waited.get();
+    }
+
+    std::vector<std::string> expected = {"gate", "waited", "high", "low"};
+    cr_assert(order == expected);
+}
@@ -13,6 +13,7 @@
 
 namespace cd = clonixin::dynamicloader;
 namespace cde = clonixin::dynamicloader::exceptions;
+namespace cdu = clonixin::dynamicloader::utils;
 
 namespace ts = tests;
 
@@ -378,3 +379,188 @@ Test(BasicLoaderTests, MovePrecedence, .description = "Instantiate a BasicLoader
     std::optional<tr::CopyableAndMovable> cm3 = bdl.tryGetSymbol<std::remove_reference_t<decltype(cm2)>>("m"s);
 }
 /* !Testing move semantics getters */
+
+/* Testing symbol cache */
+Test(BasicLoaderTests, CachedLookup, .description = "Instantiate a BasicLoader, "
+        "then retrieve the same symbol several times. The backend should only be called once.") {
+    auto bdl = cd::BasicLoader(setup());
+
+    cr_assert(&integer == bdl.getSymbol<int *>("integer"s));
+    cr_assert(&integer == bdl.getSymbol<int *>("integer"s));
+    cr_assert(&integer == bdl.tryGetSymbol<int *>("integer"s));
+    cr_assert_eq(bdl.getSymbol<int &>("integer"s), integer);
+    cr_assert(bdl.hasSymbol("integer"s));
+    cr_assert_eq(bdl.accessBackend().getLookupCount(), 1, "Backend was called more than once.");
+}
+
+Test(BasicLoaderTests, CachedNegativeLookup, .description = "Instantiate a BasicLoader, "
+        "then look for an unknown symbol several times. The failure should be cached.") {
+    auto bdl = cd::BasicLoader(setup());
+    std::string err_out;
+    cde::Type err_type;
+
+    cr_assert_not(bdl.hasSymbol("toto"s));
+    cr_assert_throw(will_throw((void)bdl.getSymbol<int *>("toto"s)), cde::DLException<cde::Type::LoadSym>);
+    cr_assert_eq(bdl.tryGetSymbol<int *>("toto"s, err_type, err_out), std::nullopt);
+    cr_assert_eq(err_type, cde::Type::LoadSym, "err_type is not cde::Type::LoadSym");
+    cr_assert_not(err_out.empty(), "Cached error string is empty.");
+    cr_assert_eq(bdl.accessBackend().getLookupCount(), 1, "Backend was called more than once.");
+}
+
+Test(BasicLoaderTests, BoundedNegativeCache, .description = "Instantiate a BasicLoader, "
+        "then look for more unknown symbols than the cache keeps failures. The first "
+        "ones should stay cached, the others should go through the backend every time.") {
+    auto bdl = cd::BasicLoader(setup());
+    auto const &backend = bdl.accessBackend();
+    std::size_t max = cdu::SymbolCache<void *>::MaxMisses;
+
+    for (std::size_t i = 0; i < max + 10; ++i)
+        cr_assert_not(bdl.tryGetSymbol<int *>("missing_"s + std::to_string(i)));
+    cr_assert_eq(backend.getLookupCount(), max + 10);
+
+    cr_assert_not(bdl.tryGetSymbol<int *>("missing_0"s));
+    cr_assert_eq(backend.getLookupCount(), max + 10, "Cached failure went through the backend.");
+
+    std::string last = "missing_"s + std::to_string(max + 9);
+    std::string err_out;
+    cde::Type err_type;
+
+    cr_assert_eq(bdl.tryGetSymbol<int *>(last, err_type, err_out), std::nullopt);
+    cr_assert_eq(backend.getLookupCount(), max + 11, "Failure past the limit was cached.");
+    cr_assert_not(err_out.empty(), "Uncached error string is empty.");
+    cr_assert_throw(will_throw((void)bdl.getSymbol<int *>(last)), cde::DLException<cde::Type::LoadSym>);
+    cr_assert(&integer == bdl.getSymbol<int *>("integer"s));
+}
+
+Test(BasicLoaderTests, ResetInvalidatesCache, .description = "Instantiate a BasicLoader, "
+        "retrieve a symbol, then replace the backend. The cache should be invalidated.") {
+    auto bdl = cd::BasicLoader(setup());
+    std::uint64_t gen = bdl.getGeneration();
+
+    cr_assert(&integer == bdl.getSymbol<int *>("integer"s));
+
+    bdl = tmb::MockBackend("PATH"s, tmb::MockBackend::dont_fail, list_t{{"integer", &floating}});
+    cr_assert_neq(bdl.getGeneration(), gen, "Generation did not change.");
+    gen = bdl.getGeneration();
+    cr_assert(reinterpret_cast<int *>(&floating) == bdl.getSymbol<int *>("integer"s));
+
+    bdl.reset(setup());
+    cr_assert_neq(bdl.getGeneration(), gen, "Generation did not change.");
+    cr_assert(&integer == bdl.getSymbol<int *>("integer"s));
+}
+
+Test(BasicLoaderTests, MoveKeepsCache, .description = "Instantiate a BasicLoader, "
+        "retrieve a symbol, then move the loader. The cache should follow the backend.") {
+    auto bdl = cd::BasicLoader(setup());
+
+    cr_assert(&integer == bdl.getSymbol<int *>("integer"s));
+
+    std::uint64_t gen = bdl.getGeneration();
+    auto moved = std::move(bdl);
+
+    cr_assert_eq(moved.getGeneration(), gen, "Generation was not moved.");
+    cr_assert_neq(bdl.getGeneration(), gen, "Moved-from loader kept the generation.");
+    cr_assert(&integer == moved.getSymbol<int *>("integer"s));
+}
+/* !Testing symbol cache */
+
+/* Testing compile time names */
+static constexpr char integer_name[] = "integer";
+static constexpr char floating_name[] = "floating";
+static constexpr char null_name[] = "NULL";
+static constexpr char unknown_name[] = "toto";
+
+Test(BasicLoaderTests, GetStaticSymbol, .description = "Instantiate a BasicLoader, "
+        "then retrieve symbols whose names are known at compile time.") {
+    auto bdl = cd::BasicLoader(setup());
+
+    int *p1 = bdl.getSymbol<integer_name, int *>();
+    int *p2 = bdl.getSymbol<integer_name, int *>();
+    int &r = bdl.getSymbol<integer_name, int &>();
+    float f = bdl.getSymbol<floating_name, float>();
+    int *null = bdl.getSymbol<null_name, int *>();
+
+    cr_assert_eq(p1, &integer);
+    cr_assert_eq(p2, &integer);
+    cr_assert_eq(&r, &integer);
+    cr_assert_eq(f, floating);
+    cr_assert_null(null);
+    cr_assert_eq(bdl.accessBackend().getLookupCount(), 3, "Backend was called more than once per name.");
+}
+
+Test(BasicLoaderTests, GetStaticSymbolErrors, .description = "Instantiate a BasicLoader, "
+        "then retrieve invalid symbols whose names are known at compile time.") {
+    auto bdl = cd::BasicLoader(setup());
+    auto get_unknown = [&bdl]() { return bdl.getSymbol<unknown_name, int *>(); };
+    auto get_null = [&bdl]() -> int & { return bdl.getSymbol<null_name, int &>(); };
+
+    cr_assert_throw(will_throw((void)get_unknown()), cde::DLException<cde::Type::LoadSym>);
+    cr_assert_throw(will_throw((void)get_null()), cde::DLException<cde::Type::NullSym>);
+}
+
+Test(BasicLoaderTests, StaticSymbolGeneration, .description = "Retrieve a symbol whose name "
+        "is known at compile time from two loaders, and after a reset. The right address should be returned.") {
+    auto bdl = cd::BasicLoader(setup());
+    auto oth = cd::BasicLoader(tmb::MockBackend("PATH"s, tmb::MockBackend::dont_fail, list_t{{"integer", &integers}}));
+    auto get = [](auto &loader) { return loader.template getSymbol<integer_name, int *>(); };
+
+    cr_assert_eq(get(bdl), &integer);
+    cr_assert_eq(get(oth), integers);
+    cr_assert_eq(get(bdl), &integer);
+
+    bdl.reset(tmb::MockBackend("PATH"s, tmb::MockBackend::dont_fail, list_t{{"integer", &integers}}));
+    cr_assert_eq(get(bdl), integers);
+}
+/* !Testing compile time names */
+
+/* Testing batch resolution */
+Test(BasicLoaderTests, ResolveSymbols, .description = "Instantiate a BasicLoader, "
+        "then resolve a set of symbols at once, some of them missing.") {
+    auto bdl = cd::BasicLoader(setup());
+    std::vector<std::string> names = {"integer", "toto", "floating", "NULL", "tata"};
+
+    auto table = bdl.resolveSymbols(names);
+
+    cr_assert_eq(table.size(), names.size());
+    cr_assert_eq(table.get<int *>(0), &integer);
+    cr_assert_eq(table.get<float *>(2), &floating);
+    cr_assert_null(table[3]);
+    cr_assert(table.isResolved(0));
+    cr_assert_not(table.isResolved(1));
+    cr_assert(table.isResolved(3));
+    cr_assert_eq(table.getStatus()[0], 0b01101u, "Unexpected status bitmap.");
+    cr_assert_not(table.allResolved());
+    cr_assert_eq(table.getMissing().size(), 2);
+    cr_assert_eq(table.getMissing()[0].name, "toto"s);
+    cr_assert_eq(table.getMissing()[1].index, 4);
+    cr_assert_not(table.getMissing()[1].error.empty(), "Missing error is empty.");
+}
+
+Test(BasicLoaderTests, ResolveSymbolsUsesCache, .description = "Instantiate a BasicLoader, "
+        "resolve a symbol, then resolve a set of symbols. Cached symbols should not be looked up again.") {
+    auto bdl = cd::BasicLoader(setup());
+    char const *names[] = {"integer", "floating", "integer"};
+
+    cr_assert_eq(bdl.getSymbol<int *>("integer"s), &integer);
+
+    auto table = bdl.resolveSymbols(names);
+
+    cr_assert(table.allResolved());
+    cr_assert_eq(table.get<int *>(2), &integer);
+    cr_assert_eq(bdl.accessBackend().getLookupCount(), 2, "Unexpected number of backend lookups.");
+}
+
+Test(BasicLoaderTests, GetSymbolsException, .description = "Instantiate a BasicLoader, "
+        "then get a set of symbols at once. A single exception naming every missing symbols should be thrown.") {
+    auto bdl = cd::BasicLoader(setup());
+    std::vector<std::string> names = {"toto", "integer", "tata"};
+
+    try {
+        (void)bdl.getSymbols(names);
+        cr_assert(false, "No exception was thrown.");
+    } catch (cde::DLException<cde::Type::LoadSym> const &e) {
+        cr_assert_eq(e.getName(), "toto, tata"s);
+    }
+    cr_assert(bdl.getSymbols(std::vector<std::string>{"integer", "floating"}).allResolved());
+}
+/* !Testing batch resolution */
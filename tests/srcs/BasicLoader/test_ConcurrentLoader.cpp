@@ -0,0 +1,162 @@
+#include <criterion/criterion.h>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/backends.hpp"
+
+/*
+** These tests share a single loader, through a const reference, between
+** several threads, without any locking. They are meant to be run under
+** ThreadSanitizer, see the test_tsan rule of the Makefile.
+**
+** Assertions are only made from the main thread: worker threads count
+** their mismatches, which are checked once they are joined.
+*/
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace cdu = clonixin::dynamicloader::utils;
+
+using namespace std::string_literals;
+
+static constexpr std::size_t thread_count = 8;
+static constexpr std::size_t iterations = 200;
+
+static constexpr char cos_name[] = "cos";
+
+static char const *names[] = {
+    "cos", "sin", "tan", "exp", "log", "sqrt", "pow", "frexp", "ldexp",
+    "nan", "signgam", "malloc", "free", "printf",
+    "this_symbol_does_not_exist", "neither_does_this_one"
+};
+
+template <typename Loader>
+static std::size_t stress(Loader const &loader, std::vector<void *> const &expected) {
+    std::atomic<std::size_t> mismatches{0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&loader, &expected, &mismatches, t]() {
+            std::size_t local = 0;
+
+            for (std::size_t it = 0; it < iterations; ++it) {
+                for (std::size_t i = 0; i < std::size(names); ++i) {
+                    std::string name = names[(i + t) % std::size(names)];
+                    void *ref = expected[(i + t) % std::size(names)];
+                    auto sym = loader.template tryGetSymbol<void *>(name);
+
+                    local += sym.has_value() != (ref != nullptr);
+                    local += sym.has_value() && *sym != ref;
+                    local += loader.hasSymbol(name) != (ref != nullptr);
+                }
+
+                std::string unique = "missing_"s + std::to_string(t) + "_"s + std::to_string(it);
+
+                local += loader.hasSymbol(unique);
+                local += loader.template tryGetSymbol<void *>(unique).has_value();
+
+                auto fn = loader.template getSymbol<cos_name, void *>();
+                local += fn != expected[0];
+
+                auto table = loader.resolveSymbols(std::vector<std::string>{"sin", "tan", unique});
+                local += table[0] != expected[1] || table[1] != expected[2] || table.isResolved(2);
+            }
+
+            mismatches += local;
+        });
+    }
+
+    for (auto &th : threads)
+        th.join();
+
+    return mismatches;
+}
+
+static std::vector<void *> reference() {
+    void *hndl = dlopen("libm.so.6", RTLD_LAZY);
+    std::vector<void *> expected;
+
+    for (char const *name : names)
+        expected.push_back(dlsym(hndl, name));
+
+    dlclose(hndl);
+    return expected;
+}
+
+TestSuite(ConcurrencyTests);
+
+Test(ConcurrencyTests, LinuxBackend, .description = "Share a const loader using a "
+        "LinuxBackend between several threads. Every lookup should return the "
+        "same result as dlsym.") {
+    cd::BasicLoader<cdb::DefaultBackend> const loader("libm.so.6"s);
+
+    cr_assert_eq(stress(loader, reference()), 0);
+}
+
+Test(ConcurrencyTests, LinuxElfBackend, .description = "Share a const loader using a "
+        "LinuxElfBackend between several threads. Every lookup should return the "
+        "same result as dlsym.") {
+    cd::BasicLoader<cdb::ElfBackend> const loader("libm.so.6"s);
+
+    cr_assert_eq(stress(loader, reference()), 0);
+}
+
+Test(ConcurrencyTests, SymbolIndex, .description = "Build the symbol index of a "
+        "shared loader from several threads at once. Every thread should get the "
+        "same index.") {
+    cd::BasicLoader<cdb::DefaultBackend> const loader("libm.so.6"s);
+    std::vector<cdb::_linux::SymbolIndex const *> indexes(thread_count, nullptr);
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < thread_count; ++t)
+        threads.emplace_back([&loader, &indexes, t]() { indexes[t] = &loader.getSymbolIndex(); });
+
+    for (auto &th : threads)
+        th.join();
+
+    for (auto const *index : indexes)
+        cr_assert_eq(index, indexes[0]);
+    cr_assert_not(indexes[0]->empty());
+}
+
+Test(ConcurrencyTests, SymbolCache, .description = "Insert distinct names in a "
+        "SymbolCache from several threads, while others read them back. Growing "
+        "the table should never lose an entry.") {
+    cdu::SymbolCache<void *> cache;
+    std::atomic<std::size_t> mismatches{0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&cache, &mismatches, t]() {
+            std::size_t local = 0;
+
+            for (std::size_t i = 0; i < 1000; ++i) {
+                std::string name = std::to_string(i % 500) + "_"s + std::to_string(t % 4);
+                std::uint64_t hash = cdu::hashName(name.data(), name.size());
+                void *value = reinterpret_cast<void *>(hash | 1);
+
+                cdu::SymbolCache<void *>::Entry result{value, false, std::string()};
+                auto const *entry = cache.find(name, hash);
+
+                if (entry == nullptr)
+                    entry = cache.insert(name, hash, result);
+
+                local += entry->sym != value;
+            }
+
+            mismatches += local;
+        });
+    }
+
+    for (auto &th : threads)
+        th.join();
+
+    cr_assert_eq(mismatches, 0);
+    cr_assert_eq(cache.size(), 2000);
+}
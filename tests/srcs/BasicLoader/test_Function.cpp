@@ -0,0 +1,78 @@
+#include <criterion/criterion.h>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/backends.hpp"
+#include "../resources/mocks.h"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace cde = clonixin::dynamicloader::exceptions;
+
+using Loader = cd::BasicLoader<cdb::DefaultBackend>;
+
+using namespace std::string_literals;
+
+static_assert(std::is_trivially_copyable_v<cd::Function<int(int)>>);
+static_assert(sizeof(cd::Function<int(int)>) == sizeof(int (*)(int)));
+static_assert(!std::is_nothrow_invocable_v<cd::Function<int(int)>, int>);
+static_assert(std::is_nothrow_invocable_v<cd::Function<int(int) noexcept>, int>);
+static_assert(!std::is_invocable_v<cd::Function<int(int)>, char const *>);
+
+static int consume(std::unique_ptr<int> value) {
+    return *value;
+}
+
+TestSuite(FunctionTests);
+
+Test(FunctionTests, Call, .description = "Call a function of libm through a "
+        "Function handle. It should hold the same address as getSymbol.") {
+    Loader libm("libm.so.6");
+
+    auto cosine = libm.getFunction<double(double) noexcept>("cos");
+    auto raw = libm.getSymbol<double (*)(double)>("cos");
+    bool same = reinterpret_cast<void *>(cosine.get()) == reinterpret_cast<void *>(raw);
+
+    cr_assert(static_cast<bool>(cosine));
+    cr_assert(same);
+    cr_assert_float_eq(cosine(0.0), 1.0, 1e-9);
+}
+
+Test(FunctionTests, Missing, .description = "Get a handle on a function that "
+        "does not exist. getFunction should throw, and tryGetFunction should "
+        "return nothing.") {
+    Loader libm("libm.so.6");
+
+    cr_assert_throw((void)libm.getFunction<void()>("this_symbol_does_not_exist"),
+            cde::DLException<cde::Type::LoadSym>);
+    cr_assert_not(libm.tryGetFunction<void()>("this_symbol_does_not_exist").has_value());
+    cr_assert(libm.tryGetFunction<double(double)>("sin").has_value());
+}
+
+Test(FunctionTests, Null, .description = "Get a handle on a null symbol. "
+        "getFunction should throw the NullSym error of the other getters.") {
+    cd::BasicLoader<tmb::MockBackend> bdl(tmb::MockBackend("PATH"s, tmb::MockBackend::dont_fail,
+            tmb::MockBackend::list_t{{"NULL", NULL}}));
+    std::string message;
+
+    try {
+        (void)bdl.getFunction<void()>("NULL");
+    } catch (cde::DLException<cde::Type::NullSym> const &e) {
+        message = e.what();
+    }
+
+    cr_assert_str_eq(message.c_str(), "PATH: Symbol NULL is NULL and cannot be casted.");
+    cr_assert_not(bdl.tryGetFunction<void()>("NULL").has_value());
+}
+
+Test(FunctionTests, Forwarding, .description = "Call a function taking a move "
+        "only parameter. The argument should be forwarded, not copied.") {
+    cd::Function<int(std::unique_ptr<int>)> fn(&consume);
+    cd::Function<int(std::unique_ptr<int>)> copy = fn;
+
+    cr_assert_eq(fn(std::make_unique<int>(42)), 42);
+    cr_assert_eq(copy(std::make_unique<int>(7)), 7);
+    cr_assert_not(static_cast<bool>(cd::Function<void()>()));
+}
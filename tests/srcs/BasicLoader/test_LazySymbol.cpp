@@ -0,0 +1,108 @@
+#include <criterion/criterion.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BasicLoader/LazySymbol.hpp"
+#include "backends/linux/backends.hpp"
+#include "../resources/mocks.h"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace cde = clonixin::dynamicloader::exceptions;
+
+using namespace std::string_literals;
+
+/*
+** Declared at namespace scope, as plugin entry points would be. The
+** handles are constant initialized, and only resolved by the tests.
+*/
+static cd::BasicLoader<cdb::DefaultBackend> libm("libm.so.6");
+
+static cd::LazySymbol<double(double)> lazy_cos(libm, "cos");
+static cd::LazySymbol<double (*)(double, double)> lazy_pow(libm, "pow");
+static cd::LazySymbol<int *> lazy_signgam(libm, "signgam");
+static cd::LazySymbol<void()> lazy_missing(libm, "this_symbol_does_not_exist");
+
+TestSuite(LazySymbolTests);
+
+Test(LazySymbolTests, Call, .description = "Call functions through lazy handles. "
+        "They should only be resolved by their first use.") {
+    lazy_cos.reset();
+
+    cr_assert_not(lazy_cos.isResolved());
+    cr_assert_float_eq(lazy_cos(0.0), 1.0, 1e-9);
+    cr_assert(lazy_cos.isResolved());
+    cr_assert_eq(lazy_cos.get(), libm.getSymbol<double (*)(double)>("cos"));
+
+    cr_assert_float_eq(lazy_pow(2.0, 10.0), 1024.0, 1e-9);
+}
+
+Test(LazySymbolTests, Data, .description = "Access a variable through a lazy "
+        "handle. It should point to the variable of the library.") {
+    int *signgam = libm.getSymbol<int *>("signgam");
+
+    cr_assert_eq(lazy_signgam.get(), signgam);
+    cr_assert_eq(&*lazy_signgam, signgam);
+}
+
+Test(LazySymbolTests, Missing, .description = "Use a handle on a symbol that does "
+        "not exist. resolve() should fail, and a call should throw, every time.") {
+    cr_assert_not(lazy_missing.resolve());
+    cr_assert_throw(lazy_missing(), cde::DLException<cde::Type::LoadSym>);
+    cr_assert_throw(lazy_missing(), cde::DLException<cde::Type::LoadSym>);
+    cr_assert_not(lazy_missing.isResolved());
+}
+
+Test(LazySymbolTests, Null, .description = "Use handles on a null symbol. They "
+        "should throw the NullSym error a BasicLoader throws, naming the library.") {
+    cd::BasicLoader<tmb::MockBackend> bdl(tmb::MockBackend("PATH"s, tmb::MockBackend::dont_fail,
+            tmb::MockBackend::list_t{{"NULL", NULL}}));
+    cd::LazySymbol<void(), tmb::MockBackend> fn(bdl, "NULL");
+    cd::LazySymbol<int *, tmb::MockBackend> data(bdl, "NULL");
+    char const *expected = "PATH: Symbol NULL is NULL and cannot be casted.";
+    std::string called;
+    std::string dereferenced;
+
+    try {
+        fn();
+    } catch (cde::DLException<cde::Type::NullSym> const &e) {
+        called = e.what();
+    }
+    try {
+        (void)*data;
+    } catch (cde::DLException<cde::Type::NullSym> const &e) {
+        dereferenced = e.what();
+    }
+
+    cr_assert_str_eq(called.c_str(), expected);
+    cr_assert_str_eq(dereferenced.c_str(), expected);
+    cr_assert_not(fn.isResolved());
+    cr_assert_not(data.isResolved());
+}
+
+Test(LazySymbolTests, FirstUse, .description = "Use a fresh handle from several "
+        "threads at once. Every thread should get the same address.") {
+    cd::LazySymbol<double(double)> lazy_sin(libm, "sin");
+    void *expected = reinterpret_cast<void *>(libm.getSymbol<double (*)(double)>("sin"));
+    std::atomic<bool> go{false};
+    std::atomic<std::size_t> mismatches{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 8; ++i)
+        threads.emplace_back([&]() {
+            while (!go.load())
+                std::this_thread::yield();
+
+            for (int n = 0; n < 100; ++n)
+                if (reinterpret_cast<void *>(lazy_sin.get()) != expected || lazy_sin(0.0) != 0.0)
+                    mismatches.fetch_add(1);
+        });
+
+    go.store(true);
+    for (auto &t : threads)
+        t.join();
+
+    cr_assert_eq(mismatches.load(), 0);
+}
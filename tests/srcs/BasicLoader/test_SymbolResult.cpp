@@ -0,0 +1,272 @@
+#include <criterion/criterion.h>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/backends.hpp"
+#include "../resources/mocks.h"
+
+/*
+** Allocations made by the current thread are counted while counting is
+** set, so that the tests can check that a code path does not allocate.
+** They fail while failing is set, once budget of them succeeded.
+*/
+static thread_local bool counting = false;
+static thread_local bool failing = false;
+static thread_local std::size_t allocations = 0;
+static thread_local std::size_t budget = 0;
+
+void *operator new(std::size_t size) {
+    if (counting)
+        ++allocations;
+    if (failing && budget == 0)
+        throw std::bad_alloc();
+    if (failing)
+        --budget;
+
+    if (void *ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace cde = clonixin::dynamicloader::exceptions;
+
+using list_t = tmb::MockBackend::list_t;
+
+using namespace std::string_literals;
+
+static int integer = 10;
+
+static tmb::MockBackend setup() {
+    return tmb::MockBackend("PATH"s, tmb::MockBackend::dont_fail, list_t{
+        {"integer", &integer},
+        {"NULL", NULL}
+    });
+}
+
+TestSuite(SymbolResultTests);
+
+Test(SymbolResultTests, Found, .description = "Find existing symbols. The result "
+        "should hold their address, cast as requested.") {
+    auto bdl = cd::BasicLoader<tmb::MockBackend>(setup());
+    std::string name = "integer"s;
+
+    auto ptr = bdl.findSymbol<int *>(name);
+    cr_assert(ptr.hasValue());
+    cr_assert_eq(ptr.value(), &integer);
+
+    auto ref = bdl.findSymbol<int &>(name);
+    cr_assert(ref);
+    cr_assert_eq(&ref.value(), &integer);
+    cr_assert_eq(ref.address(), &integer);
+}
+
+Test(SymbolResultTests, LoadSym, .description = "Find a missing symbol. The result "
+        "should hold a LoadSym error, whose message is the backend one.") {
+    auto bdl = cd::BasicLoader<tmb::MockBackend>(setup());
+    std::string name = "missing"s;
+
+    auto res = bdl.findSymbol<int *>(name);
+    cr_assert_not(res);
+    cr_assert_eq(res.address(), nullptr);
+    cr_assert_eq(res.error().getType(), cde::Type::LoadSym);
+    cr_assert(res.error().getName() == name);
+    cr_assert_not(res.error().getMessage().empty());
+    cr_assert_throw((void)res.value(), cde::DLException<cde::Type::LoadSym>);
+}
+
+Test(SymbolResultTests, NullSym, .description = "Find a null symbol as a reference "
+        "or a value. The result should hold a NullSym error, but not as a pointer.") {
+    auto bdl = cd::BasicLoader<tmb::MockBackend>(setup());
+    std::string name = "NULL"s;
+
+    cr_assert(bdl.findSymbol<int *>(name));
+
+    auto res = bdl.findSymbol<int>(name);
+    cr_assert_not(res);
+    cr_assert_eq(res.error().getType(), cde::Type::NullSym);
+    cr_assert_str_eq(res.error().getMessage().c_str(), "PATH: Symbol NULL is NULL and cannot be casted.");
+    cr_assert_throw((void)res.value(), cde::DLException<cde::Type::NullSym>);
+}
+
+Test(SymbolResultTests, CachedFailureDoesNotAllocate, .description = "Probe a missing "
+        "symbol repeatedly. Once cached, failures should not allocate.") {
+    auto bdl = cd::BasicLoader<tmb::MockBackend>(setup());
+    std::string name = "missing"s;
+
+    (void)bdl.findSymbol<int *>(name);
+
+    counting = true;
+    allocations = 0;
+    for (int i = 0; i < 100; ++i) {
+        (void)bdl.findSymbol<int *>(name);
+        (void)bdl.tryGetSymbol<int *>(name);
+        (void)bdl.findSymbol<int>("NULL"s);
+    }
+    counting = false;
+
+    cr_assert_eq(allocations, 0);
+}
+
+Test(SymbolResultTests, RejectedProbeDoesNotAllocate, .description = "Probe symbols "
+        "that don't exist in libm, and are rejected by the bloom filters. No allocation "
+        "should happen, and the message should still be available.") {
+    cd::BasicLoader<cdb::DefaultBackend> bdl("libm.so.6"s);
+    std::vector<std::string> names;
+
+    for (int i = 0; i < 100; ++i) {
+        std::string name = "probe_"s + std::to_string(i) + "_does_not_exist"s;
+
+        if (!bdl.accessBackend().mayContainSymbol(name))
+            names.push_back(name);
+    }
+
+    cr_assert_gt(names.size(), 50, "The bloom filters should reject most names.");
+
+    std::size_t rejected = 0;
+
+    counting = true;
+    allocations = 0;
+    for (auto const &name : names) {
+        auto res = bdl.findSymbol<void *>(name);
+
+        rejected += !res && res.error().getType() == cde::Type::LoadSym;
+    }
+    counting = false;
+
+    cr_assert_eq(rejected, names.size());
+    cr_assert_eq(allocations, 0);
+
+    auto res = bdl.findSymbol<void *>(names[0]);
+    cr_assert_not(res);
+    cr_assert_str_eq(res.error().getMessage().c_str(), ("libm.so.6: undefined symbol: "s + names[0]).c_str());
+}
+
+Test(SymbolResultTests, OrderIndependent, .description = "Find a symbol of a library "
+        "opened with RTLD_GLOBAL through the program handle, before and after getting it. "
+        "Both lookups should find it, whichever comes first.") {
+    void *global = dlopen("libresolv.so.2", RTLD_LAZY | RTLD_GLOBAL);
+    cd::BasicLoader<cdb::DefaultBackend> first(cdb::DefaultBackend::InternalSymbolBackend(cdb::_linux::OpenFlags::Lazy));
+    cd::BasicLoader<cdb::DefaultBackend> second(cdb::DefaultBackend::InternalSymbolBackend(cdb::_linux::OpenFlags::Lazy));
+
+    cr_assert_not_null(global, "Could not open libresolv.so.2");
+
+    auto found = first.findSymbol<void *>("ns_samename");
+    void *sym = first.getSymbol<void *>("ns_samename");
+    cr_assert(found);
+    cr_assert_eq(found.address(), sym);
+
+    sym = second.getSymbol<void *>("ns_samename");
+    found = second.findSymbol<void *>("ns_samename");
+    cr_assert(found);
+    cr_assert_eq(found.address(), sym);
+
+    dlclose(global);
+}
+
+Test(SymbolResultTests, LiteralDoesNotAllocate, .description = "Look symbols up "
+        "by string literal and char pointer, once cached. No temporary std::string "
+        "should be built, so no allocation should happen.") {
+    cd::BasicLoader<cdb::DefaultBackend> bdl("libm.so.6"s);
+    char const *name = "sin";
+
+    (void)bdl.findSymbol<void *>("cos");
+    (void)bdl.findSymbol<void *>(name);
+
+    std::size_t found = 0;
+
+    counting = true;
+    allocations = 0;
+    for (int i = 0; i < 100; ++i) {
+        found += bdl.findSymbol<void *>("cos").hasValue();
+        found += bdl.tryGetSymbol<void *>(name).has_value();
+        found += bdl.hasSymbol("cos");
+        found += bdl.getSymbol<void *>(name) != nullptr;
+    }
+    counting = false;
+
+    cr_assert_eq(found, 400);
+    cr_assert_eq(allocations, 0);
+}
+
+Test(SymbolResultTests, OutOfMemory, .description = "Look symbols up while every "
+        "allocation fails. The results of the backend should still be returned, "
+        "without being cached, and without terminating.") {
+    cd::BasicLoader<cdb::DefaultBackend> bdl("libm.so.6"s);
+    std::string err_out = "unchanged"s;
+    cde::Type err_type = cde::Type::Open;
+
+    (void)bdl.findSymbol<void *>("probe_does_not_exist");
+
+    failing = true;
+    auto found = bdl.findSymbol<void *>("cos");
+    auto func = bdl.tryGetFunction<double(double)>("sin");
+    auto missing = bdl.tryGetSymbol<void *>("probe_does_not_exist", err_type, err_out);
+    failing = false;
+
+    cr_assert(found);
+    cr_assert(func.has_value());
+    cr_assert_eq(missing, std::nullopt);
+    cr_assert_eq(err_type, cde::Type::LoadSym);
+    cr_assert(err_out.empty(), "The message should have been dropped.");
+    cr_assert(bdl.findSymbol<void *>("cos"));
+}
+
+Test(SymbolResultTests, FailedInsert, .description = "Cache a failed lookup while "
+        "the table grows, making each allocation fail in turn. A failed insertion "
+        "should leave the cache, and the error of the caller, untouched.") {
+    using Cache = cd::utils::SymbolCache<void *>;
+
+    Cache cache;
+    std::string name = "a_symbol_name_too_long_for_the_small_string_buffer"s;
+    std::string message = "PATH: undefined symbol: "s + name;
+    std::uint64_t hash = cd::utils::hashName(name.data(), name.size());
+    Cache::Entry const *stored = nullptr;
+
+    /* The next insertion grows the table. */
+    for (std::size_t i = 0; i < 128; ++i) {
+        std::string key = std::to_string(i);
+        Cache::Entry entry{&integer, false, std::string()};
+
+        (void)cache.insert(key, cd::utils::hashName(key.data(), key.size()), entry);
+    }
+
+    for (std::size_t allowed = 0; stored == nullptr; ++allowed) {
+        Cache::Entry entry{nullptr, true, message};
+
+        budget = allowed;
+        failing = true;
+        try {
+            stored = cache.insert(name, hash, entry);
+            failing = false;
+            cr_assert_not_null(stored);
+            cr_assert(entry.error.empty());
+        } catch (std::bad_alloc const &) {
+            failing = false;
+            cr_assert(entry.error == message, "The error should be left to the caller.");
+            cr_assert_eq(cache.size(), 128);
+            cr_assert_eq(cache.getMisses(), 0);
+            cr_assert_null(cache.find(name, hash));
+        }
+    }
+
+    cr_assert_eq(cache.size(), 129);
+    cr_assert_eq(cache.getMisses(), 1);
+    cr_assert_eq(cache.find(name, hash), stored);
+    cr_assert(stored->error == message);
+}
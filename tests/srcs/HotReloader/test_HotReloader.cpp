@@ -0,0 +1,230 @@
+#include <criterion/criterion.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include <dlfcn.h>
+
+#include "HotReloader/HotReloader.hpp"
+#include "utils/Epoch.hpp"
+#include "../resources/libraries.h"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdu = clonixin::dynamicloader::utils;
+namespace fs = std::filesystem;
+
+using namespace std::string_literals;
+
+/*
+** Replace the plugin the way install(1) does: write a new file next to
+** it, then rename it over the old one.
+*/
+static void install(char const *soname, fs::path const &target) {
+    fs::path tmp = target;
+
+    tmp += ".tmp";
+    fs::copy_file(tests::realPath(soname), tmp, fs::copy_options::overwrite_existing);
+    fs::rename(tmp, target);
+}
+
+static bool waitGeneration(cd::HotReloader<> const &reloader, std::uint64_t number) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (reloader.getGeneration() < number) {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    return true;
+}
+
+static fs::path makeDir() {
+    char tmpl[] = "/tmp/hotreload_XXXXXX";
+
+    return fs::path(mkdtemp(tmpl));
+}
+
+TestSuite(HotReloaderTests);
+
+Test(HotReloaderTests, Reload, .description = "Replace a watched library. A new "
+        "generation, with freshly resolved symbols, should be published, while the "
+        "old one stays usable by pinned readers.") {
+    fs::path dir = makeDir();
+    fs::path plugin = dir / "plugin.so";
+
+    install("libm.so.6", plugin);
+    {
+        cd::HotReloader<> reloader(plugin.string(), {"cos"s, "sin"s});
+        cdu::EpochGuard guard;
+        auto const &first = reloader.current();
+        auto cos = reloader.get<double (*)(double)>(0);
+
+        cr_assert_eq(reloader.getGeneration(), 0);
+        cr_assert_not_null(cos);
+        cr_assert_float_eq(cos(0.0), 1.0, 1e-9);
+
+        install("libm.so.6", plugin);
+        cr_assert(waitGeneration(reloader, 1), "The library was not reloaded.");
+
+        auto const &second = reloader.current();
+        cr_assert_neq(&first, &second);
+        cr_assert_neq(first.table[0], second.table[0], "The new copy should be loaded.");
+        cr_assert_float_eq(first.table.get<double (*)(double)>(0)(0.0), 1.0, 1e-9);
+        cr_assert(reloader.getLastError().empty());
+    }
+    fs::remove_all(dir);
+}
+
+Test(HotReloaderTests, FailedReload, .description = "Replace a watched library with "
+        "one missing a bound symbol. The current generation should be kept.") {
+    fs::path dir = makeDir();
+    fs::path plugin = dir / "plugin.so";
+
+    install("libm.so.6", plugin);
+    {
+        cd::HotReloader<> reloader(plugin.string(), {"cos"s});
+
+        install("libdl.so.2", plugin);
+        cr_assert_not(reloader.reload());
+        cr_assert_eq(reloader.getGeneration(), 0);
+        cr_assert_not(reloader.getLastError().empty());
+        {
+            cdu::EpochGuard guard;
+            cr_assert_not_null(reloader.get<void *>(0));
+        }
+
+        install("libm.so.6", plugin);
+        cr_assert(waitGeneration(reloader, 1), "The library was not reloaded.");
+        cr_assert(reloader.getLastError().empty());
+    }
+    fs::remove_all(dir);
+}
+
+Test(HotReloaderTests, Readers, .description = "Read bound symbols from several "
+        "threads while the library is reloaded. Readers should always see a "
+        "complete table.") {
+    fs::path dir = makeDir();
+    fs::path plugin = dir / "plugin.so";
+
+    install("libm.so.6", plugin);
+    {
+        cd::HotReloader<> reloader(plugin.string(), {"cos"s, "sin"s});
+        std::atomic<bool> stop{false};
+        std::atomic<std::size_t> mismatches{0};
+        std::vector<std::thread> readers;
+
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&]() {
+                while (!stop) {
+                    cdu::EpochGuard guard;
+                    auto const &gen = reloader.current();
+                    Dl_info cos_info, sin_info;
+
+                    if (!gen.table.allResolved()
+                            || dladdr(gen.table[0], &cos_info) == 0 || dladdr(gen.table[1], &sin_info) == 0
+                            || cos_info.dli_fbase != sin_info.dli_fbase)
+                        ++mismatches;
+                }
+            });
+        }
+
+        for (int i = 0; i < 10; ++i)
+            (void)reloader.reload();
+
+        stop = true;
+        for (auto &th : readers)
+            th.join();
+
+        cr_assert_eq(reloader.getGeneration(), 10);
+        cr_assert_eq(mismatches, 0);
+    }
+    fs::remove_all(dir);
+}
+
+Test(HotReloaderTests, RetiredGenerations, .description = "Reload a library "
+        "several times. Replaced generations should be closed once no reader is "
+        "pinned anymore, instead of being kept until the reloader is destroyed.") {
+    fs::path dir = makeDir();
+    fs::path plugin = dir / "plugin.so";
+
+    install("libm.so.6", plugin);
+    {
+        cd::HotReloader<> reloader(plugin.string(), {"cos"s});
+        Dl_info info;
+
+        cdu::Epoch::pin();
+        void *first = reloader.current().table[0];
+        install("libm.so.6", plugin);
+        cr_assert(waitGeneration(reloader, 1), "The library was not reloaded.");
+        cr_assert(reloader.getLastError().empty());
+        cr_assert_neq(dladdr(first, &info), 0, "A pinned reader should keep the generation open.");
+        cdu::Epoch::unpin();
+        (void)cdu::Epoch::collect();
+        cr_assert_eq(dladdr(first, &info), 0, "The first generation should be closed.");
+
+        for (std::uint64_t i = 2; i < 7; ++i) {
+            cdu::Epoch::pin();
+            void *prev = reloader.current().table[0];
+            cdu::Epoch::unpin();
+
+            install("libm.so.6", plugin);
+            cr_assert(waitGeneration(reloader, i), "The library was not reloaded.");
+            cr_assert(reloader.getLastError().empty());
+            cr_assert_eq(dladdr(prev, &info), 0, "Unpinned, a replaced generation should be closed at once.");
+        }
+    }
+    fs::remove_all(dir);
+}
+
+Test(HotReloaderTests, PinnedReloads, .description = "Reload a library twice "
+        "while another thread stays pinned, so that the first generation is "
+        "deleted while its library is still loaded. The second reload should "
+        "still load the new file.") {
+    fs::path dir = makeDir();
+    fs::path plugin = dir / "plugin.so";
+
+    install("libm.so.6", plugin);
+    {
+        cd::HotReloader<> reloader(plugin.string(), {"cos"s});
+        std::atomic<int> step{0};
+        void *first;
+        void *second;
+
+        cdu::Epoch::pin();
+        first = reloader.current().table[0];
+        install("libm.so.6", plugin);
+        cr_assert(reloader.reload(), "%s", reloader.getLastError().c_str());
+        second = reloader.current().table[0];
+
+        std::thread reader([&]() {
+            cdu::EpochGuard guard;
+
+            step = 1;
+            while (step != 2)
+                std::this_thread::yield();
+        });
+
+        while (step != 1)
+            std::this_thread::yield();
+        cdu::Epoch::unpin();
+        (void)cdu::Epoch::collect();
+
+        install("libm.so.6", plugin);
+        cr_assert(reloader.reload(), "%s", reloader.getLastError().c_str());
+        {
+            cdu::EpochGuard guard;
+            void *third = reloader.current().table[0];
+
+            cr_assert_neq(third, first, "The first generation's library was returned again.");
+            cr_assert_neq(third, second);
+        }
+
+        step = 2;
+        reader.join();
+    }
+    fs::remove_all(dir);
+}
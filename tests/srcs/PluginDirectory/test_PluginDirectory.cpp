@@ -0,0 +1,174 @@
+#include <criterion/criterion.h>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
+
+#include "PluginDirectory/PluginDirectory.hpp"
+#include "../resources/libraries.h"
+
+namespace cd = clonixin::dynamicloader;
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+namespace fs = std::filesystem;
+
+using namespace std::string_literals;
+
+using Status = cbl::ElfFile::Status;
+
+static std::vector<char> readFile(std::string const &path) {
+    std::ifstream in(path, std::ios::binary);
+
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(fs::path const &path, std::vector<char> const &data) {
+    std::ofstream out(path, std::ios::binary);
+
+    out.write(data.data(), data.size());
+}
+
+/*
+** Fill a temporary directory with a copy of libm, libdl, a text file, and
+** copies of libm whose header was altered.
+*/
+static fs::path makePlugins() {
+    char tmpl[] = "/tmp/plugins_XXXXXX";
+    fs::path dir = mkdtemp(tmpl);
+    std::vector<char> libm = readFile(tests::realPath("libm.so.6"));
+    auto *ehdr = reinterpret_cast<ElfW(Ehdr) *>(libm.data());
+    ElfW(Half) machine = ehdr->e_machine;
+
+    writeFile(dir / "a_libm.so", libm);
+    writeFile(dir / "b_libdl.so", readFile(tests::realPath("libdl.so.2")));
+    writeFile(dir / "c_text.so", std::vector<char>{'n', 'o', 't', ' ', 'E', 'L', 'F'});
+
+    ehdr->e_machine = ehdr->e_machine == EM_AARCH64 ? EM_X86_64 : EM_AARCH64;
+    writeFile(dir / "d_machine.so", libm);
+
+    ehdr->e_machine = machine;
+    ehdr->e_ident[EI_CLASS] = ehdr->e_ident[EI_CLASS] == ELFCLASS64 ? ELFCLASS32 : ELFCLASS64;
+    writeFile(dir / "e_class.so", libm);
+
+    fs::create_directory(dir / "f_subdir");
+
+    return dir;
+}
+
+/*
+** Get the offset, in the file, of the .gnu.hash section of an ELF image.
+*/
+static std::size_t gnuHashOffset(std::vector<char> const &image) {
+    auto const *ehdr = reinterpret_cast<ElfW(Ehdr) const *>(image.data());
+    auto const *shdrs = reinterpret_cast<ElfW(Shdr) const *>(image.data() + ehdr->e_shoff);
+
+    for (ElfW(Half) i = 0; i < ehdr->e_shnum; ++i)
+        if (shdrs[i].sh_type == SHT_GNU_HASH)
+            return shdrs[i].sh_offset;
+
+    return 0;
+}
+
+TestSuite(PluginDirectoryTests);
+
+Test(PluginDirectoryTests, ElfFile, .description = "Check a shared object, an "
+        "executable and a missing file with ElfFile.") {
+    cbl::ElfFile libm(tests::realPath("libm.so.6"));
+    cbl::ElfFile executable("/proc/self/exe"s);
+    cbl::ElfFile missing("/this/file/does/not/exist.so"s);
+
+    cr_assert(libm.isValid());
+    cr_assert(libm.exports("cos"));
+    cr_assert_not(libm.exports("this_symbol_does_not_exist"));
+    cr_assert_eq(executable.getStatus(), Status::NotShared);
+    cr_assert_eq(missing.getStatus(), Status::Unreadable);
+}
+
+Test(PluginDirectoryTests, Scan, .description = "Scan a directory holding valid "
+        "and invalid plugins. Only the valid ones exporting the required symbols "
+        "should be accepted.") {
+    fs::path dir = makePlugins();
+    cd::PluginDirectory<> plugins(dir.string(), {"cos"s, "sin"s});
+
+    auto const &accepted = plugins.getAccepted();
+    auto const &rejected = plugins.getRejected();
+
+    cr_assert_eq(accepted.size(), 1);
+    cr_assert_eq(fs::path(accepted[0]).filename(), "a_libm.so");
+
+    cr_assert_eq(rejected.size(), 4);
+    cr_assert_eq(rejected[0].status, Status::Ok);
+    cr_assert_str_eq(rejected[0].reason.c_str(), "Missing required symbol: cos");
+    cr_assert_eq(rejected[1].status, Status::NotElf);
+    cr_assert_eq(rejected[2].status, Status::WrongMachine);
+    cr_assert_eq(rejected[3].status, Status::WrongClass);
+
+    fs::remove_all(dir);
+}
+
+Test(PluginDirectoryTests, Load, .description = "Load the accepted plugins of a "
+        "directory concurrently. Every loader should be usable.") {
+    fs::path dir = makePlugins();
+    cd::PluginDirectory<> plugins(dir.string());
+
+    cr_assert_eq(plugins.getAccepted().size(), 2);
+
+    auto loaders = plugins.loadAll();
+    cr_assert_eq(loaders.size(), 2);
+    cr_assert_not_null(loaders[0].getSymbol<void *>("cos"));
+
+    fs::remove_all(dir);
+}
+
+Test(PluginDirectoryTests, CorruptedGnuHash, .description = "Scan copies of libm "
+        "whose .gnu.hash table was corrupted. They should be rejected, without reading "
+        "outside of the file.") {
+    char tmpl[] = "/tmp/plugins_XXXXXX";
+    fs::path dir = mkdtemp(tmpl);
+    std::vector<char> libm = readFile(tests::realPath("libm.so.6"));
+    std::size_t offset = gnuHashOffset(libm);
+    auto *header = reinterpret_cast<std::uint32_t *>(libm.data() + offset);
+    std::vector<char> copy;
+
+    cr_assert_neq(offset, 0, "libm has no .gnu.hash section.");
+
+    copy = libm;
+    reinterpret_cast<std::uint32_t *>(copy.data() + offset)[2] = 0x10000000;
+    writeFile(dir / "a_bloom.so", copy);
+
+    copy = libm;
+    reinterpret_cast<std::uint32_t *>(copy.data() + offset)[2] = 0;
+    writeFile(dir / "b_empty_bloom.so", copy);
+
+    copy = libm;
+    reinterpret_cast<std::uint32_t *>(copy.data() + offset)[0] = 0x40000000;
+    writeFile(dir / "c_buckets.so", copy);
+
+    copy = libm;
+    reinterpret_cast<std::uint32_t *>(copy.data() + offset)[4 + header[2] * sizeof(ElfW(Addr)) / 4] = 0x7fffffff;
+    writeFile(dir / "d_chain.so", copy);
+
+    cd::PluginDirectory<> plugins(dir.string(), {"cos"s});
+    auto const &rejected = plugins.getRejected();
+
+    cr_assert_eq(plugins.getAccepted().size(), 0);
+    cr_assert_eq(rejected.size(), 4);
+    cr_assert_eq(rejected[0].status, Status::BadTables);
+    cr_assert_neq(rejected[1].status, Status::Ok);
+    cr_assert_eq(rejected[2].status, Status::BadTables);
+    cr_assert_eq(rejected[3].status, Status::BadTables);
+
+    fs::remove_all(dir);
+}
+
+Test(PluginDirectoryTests, MissingDirectory, .description = "Scan a directory that "
+        "does not exist. An Open exception should be thrown.") {
+    cr_assert_throw(cd::PluginDirectory<>("/this/directory/does/not/exist"s),
+            cd::exceptions::DLException<cd::exceptions::Type::Open>);
+}
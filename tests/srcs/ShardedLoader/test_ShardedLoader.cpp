@@ -0,0 +1,112 @@
+#include <criterion/criterion.h>
+#include <atomic>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ShardedLoader/ShardedLoader.hpp"
+#include "backends/linux/backends.hpp"
+#include "exceptions/exceptions.hpp"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+
+using namespace std::string_literals;
+
+using Frexp = double (*)(double, int *);
+
+static constexpr std::size_t shard_count = 2;
+
+TestSuite(ShardedLoaderTests);
+
+Test(ShardedLoaderTests, Copies, .description = "Open libm in two shards. Each "
+        "shard should have its own copy of libm's globals, and its functions "
+        "should work.") {
+    cd::ShardedLoader<> loader("libm.so.6"s, shard_count, cdb::ScopedBackend::NewScope);
+    auto globals = loader.getSymbols<int *>("signgam");
+    std::set<int *> distinct(globals.begin(), globals.end());
+    int exp = 0;
+
+    cr_assert_eq(loader.size(), shard_count);
+    cr_assert_eq(distinct.size(), shard_count);
+    cr_assert_eq(loader.getSymbol<int *>(1, "signgam"), globals[1]);
+    cr_assert_eq(loader.getSymbol<Frexp>("frexp")(8.0, &exp), 0.5);
+    cr_assert_eq(exp, 4);
+}
+
+Test(ShardedLoaderTests, Affinity, .description = "Use a sharded loader from as "
+        "many concurrent threads as shards. Each thread should keep its shard, "
+        "and no two threads should share one.") {
+    cdb::_linux::NamespacePool pool(shard_count);
+    cd::ShardedLoader<> loader("libm.so.6"s, shard_count, pool);
+    std::vector<std::thread> threads;
+    std::vector<std::size_t> first(shard_count);
+    std::vector<std::size_t> second(shard_count);
+    std::vector<int *> globals(shard_count);
+    std::atomic<std::size_t> leased{0};
+
+    for (std::size_t t = 0; t < shard_count; ++t) {
+        threads.emplace_back([&, t]() {
+            first[t] = loader.localIndex();
+            ++leased;
+            while (leased < shard_count)
+                std::this_thread::yield();
+            globals[t] = loader.run([](auto const &shard) {
+                return shard.template getSymbol<int *>("signgam");
+            });
+            second[t] = loader.localIndex();
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    std::set<std::size_t> indexes(first.begin(), first.end());
+
+    cr_assert_eq(pool.getLeased(), shard_count);
+    cr_assert_eq(indexes.size(), shard_count);
+    for (std::size_t t = 0; t < shard_count; ++t) {
+        cr_expect_eq(first[t], second[t]);
+        cr_expect_eq(globals[t], loader.getSymbol<int *>(first[t], "signgam"));
+    }
+}
+
+Test(ShardedLoaderTests, ThreadChurn, .description = "Keep a thread on a "
+        "sharded loader while short lived threads come and go, one at a time. "
+        "Each of them should get the shard the previous one gave back, never "
+        "the one of the long lived thread.") {
+    cd::ShardedLoader<> loader("libm.so.6"s, shard_count, cdb::ScopedBackend::NewScope);
+    std::atomic<bool> ready{false};
+    std::atomic<bool> done{false};
+    std::size_t kept = 0;
+    std::vector<std::size_t> churned(8);
+
+    std::thread keeper([&]() {
+        kept = loader.localIndex();
+        ready = true;
+        while (!done)
+            std::this_thread::yield();
+    });
+
+    while (!ready)
+        std::this_thread::yield();
+    for (auto &idx : churned)
+        std::thread([&]() { idx = loader.localIndex(); }).join();
+
+    done = true;
+    keeper.join();
+
+    for (std::size_t idx : churned) {
+        cr_expect_neq(idx, kept);
+        cr_expect_eq(idx, churned[0]);
+    }
+}
+
+Test(ShardedLoaderTests, Failure, .description = "Open more shards than the "
+        "namespace pool holds. The constructor should throw, and give back the "
+        "namespaces of the shards already opened.") {
+    cdb::_linux::NamespacePool pool(1);
+
+    cr_assert_throw((cd::ShardedLoader<>("libm.so.6"s, 2, pool)), cd::exceptions::DLException<cd::exceptions::Type::Open>);
+    cr_assert_eq(pool.getLeased(), 0);
+}
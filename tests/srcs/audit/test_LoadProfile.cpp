@@ -0,0 +1,176 @@
+#include <criterion/criterion.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <dlfcn.h>
+#include <link.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/backends.hpp"
+#include "audit/LoadProfile.hpp"
+#include "../resources/libraries.h"
+
+namespace cd = clonixin::dynamicloader;
+namespace cda = clonixin::dynamicloader::audit;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace fs = std::filesystem;
+
+using namespace std::string_literals;
+
+extern char **environ;
+
+static char const audit_path[] = "lib/rtld_audit.so";
+
+/*
+** The TSan runtime can't be loaded once an audit library took its share
+** of the static TLS block, so the audited run is skipped under TSan.
+*/
+#ifdef __SANITIZE_THREAD__
+static constexpr bool can_audit = false;
+#else
+static constexpr bool can_audit = true;
+#endif
+
+/*
+** Runs a single test again, in a new process audited by rtld_audit, and
+** returns its exit status.
+*/
+static int runAudited(char const *test) {
+    std::string audit = "LD_AUDIT="s + audit_path;
+    std::string filter = "--filter="s + test;
+    std::vector<char *> envp;
+    char exe[] = "/proc/self/exe";
+    char *argv[] = {exe, filter.data(), nullptr};
+    pid_t pid;
+    int status;
+
+    for (char **env = environ; *env != nullptr; ++env)
+        if (std::strncmp(*env, "LD_AUDIT=", 9) != 0)
+            envp.push_back(*env);
+    envp.push_back(audit.data());
+    envp.push_back(nullptr);
+
+    if (posix_spawn(&pid, exe, nullptr, nullptr, argv, envp.data()) != 0
+            || waitpid(pid, &status, 0) != pid)
+        return -1;
+
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static std::uint64_t pltSlots(std::string const &path) {
+    void *hndl = dlopen(path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+    struct link_map *lm = nullptr;
+    std::uint64_t size = 0;
+
+    if (hndl == nullptr)
+        return 0;
+    if (dlinfo(hndl, RTLD_DI_LINKMAP, &lm) == 0)
+        for (ElfW(Dyn) const *dyn = lm->l_ld; dyn->d_tag != DT_NULL; ++dyn)
+            if (dyn->d_tag == DT_PLTRELSZ)
+                size = dyn->d_un.d_val;
+    dlclose(hndl);
+
+    return size / sizeof(ElfW(Rela));
+}
+
+static cda::LoadProfile::Library profileOf(std::string const &path) {
+    cda::LoadProfile::Library found{};
+
+    for (auto const &lib : cda::LoadProfile::libraries())
+        if (lib.name == path)
+            found = lib;
+
+    return found;
+}
+
+/*
+** ns_samename() calls into libc through the PLT.
+*/
+static bool callsSamename(cdb::_linux::LinuxBackend &bck) {
+    auto fn = reinterpret_cast<int (*)(char const *, char const *)>(bck.getSymbol("ns_samename"));
+
+    return fn != nullptr && fn("example.org.", "EXAMPLE.org") == 1;
+}
+
+TestSuite(LoadProfileTests);
+
+Test(LoadProfileTests, NotAudited, .description = "Open a library while the "
+        "process isn't audited. No profile should be available.") {
+    if (std::getenv("LD_AUDIT") != nullptr)
+        return;
+
+    cd::BasicLoader<cdb::DefaultBackend> libm("libm.so.6");
+
+    cda::LoadProfile::opened();
+
+    bool active = cda::LoadProfile::isActive();
+    std::size_t libs = cda::LoadProfile::libraries().size();
+    std::uint64_t dropped = cda::LoadProfile::dropped();
+
+    cr_assert_not(active);
+    cr_assert_eq(libs, 0);
+    cr_assert_eq(dropped, 0);
+}
+
+Test(LoadProfileTests, Audited, .description = "Run again under LD_AUDIT, and "
+        "open copies of libresolv lazily and immediately. Their PLT slots should "
+        "be counted, bound on first call when lazy, and while loading otherwise.") {
+    if (std::getenv("LD_AUDIT") == nullptr) {
+        if (!can_audit)
+            return;
+
+        cr_assert_eq(access(audit_path, R_OK), 0, "%s should be built", audit_path);
+
+        int status = runAudited("LoadProfileTests/Audited");
+
+        cr_assert_eq(status, 0, "The audited run failed");
+        return;
+    }
+
+    cr_assert(cda::LoadProfile::isActive(), "The process is audited, but no profile is available");
+
+    char tmpl[] = "/tmp/audit_XXXXXX";
+    fs::path dir(mkdtemp(tmpl));
+    std::string lazy_path = (dir / "lazy.so").string();
+    std::string now_path = (dir / "now.so").string();
+
+    fs::copy_file(tests::realPath("libresolv.so.2"), lazy_path);
+    fs::copy_file(lazy_path, now_path);
+    {
+        cdb::_linux::LinuxBackend lazy(lazy_path, cdb::_linux::OpenFlags::Lazy);
+        cdb::_linux::LinuxBackend now(now_path, cdb::_linux::OpenFlags::Now);
+        std::uint64_t slots = pltSlots(lazy_path);
+
+        cr_assert_not(lazy.hasError(), "%s", lazy.getLastError().c_str());
+        cr_assert_not(now.hasError(), "%s", now.getLastError().c_str());
+        cr_assert_gt(slots, 0);
+
+        cda::LoadProfile::Library before = profileOf(lazy_path);
+
+        cr_assert(callsSamename(lazy));
+        cr_assert(callsSamename(now));
+
+        cda::LoadProfile::Library lazy_lib = profileOf(lazy_path);
+        cda::LoadProfile::Library now_lib = profileOf(now_path);
+
+        cr_assert(lazy_lib.loaded && now_lib.loaded);
+        cr_assert_eq(lazy_lib.plt_slots, slots);
+        cr_assert_eq(now_lib.plt_slots, slots);
+        /* Opening and mapping a file takes several system calls. */
+        cr_assert_gt(lazy_lib.map_ns, 1000, "The mapping of a root should be timed from dlopen()");
+        cr_assert_gt(now_lib.map_ns, 1000, "The mapping of a root should be timed from dlopen()");
+
+        cr_assert_lt(lazy_lib.load_binds, slots, "A lazy load should not bind every slot");
+        cr_assert_gt(lazy_lib.lazy_binds, before.lazy_binds, "Calls should bind slots lazily");
+        cr_assert_geq(now_lib.load_binds, slots, "An immediate load should bind every slot");
+        cr_assert_eq(now_lib.lazy_binds, 0);
+    }
+    fs::remove_all(dir);
+}
@@ -0,0 +1,162 @@
+#include <criterion/criterion.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/Bundle.hpp"
+#include "backends/linux/LinuxBundleBackend.hpp"
+#include "../../resources/libraries.h"
+
+namespace cdl = clonixin::dynamicloader;
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+
+using namespace std::string_literals;
+
+static std::string bundlePath() {
+    return "/tmp/test_bundle_"s + std::to_string(getpid());
+}
+
+static std::string textPath() {
+    return "/tmp/test_bundle_text_"s + std::to_string(getpid());
+}
+
+static void removeFiles() {
+    (void)unlink(bundlePath().c_str());
+    (void)unlink(textPath().c_str());
+}
+
+static bool createBundle(cbl::Bundle::Compression compression) {
+    {
+        std::ofstream text(textPath());
+
+        for (int i = 0; i < 1000; ++i)
+            text << "line " << i % 10 << " of the text\n";
+    }
+
+    return cbl::Bundle::create(bundlePath(), {{"libm", tests::realPath("libm.so.6")}, {"text", textPath()}}, compression);
+}
+
+TestSuite(BundleTests, .init = removeFiles, .fini = removeFiles);
+
+Test(BundleTests, Compression, .description = "Compress repetitive and ELF "
+        "data, then decompress it. The data should be the same, and truncated "
+        "or overflowing input should be rejected.") {
+    std::vector<unsigned char> data;
+
+    for (int i = 0; i < 10000; ++i)
+        data.push_back(static_cast<unsigned char>(i % 7 == 0 ? i : 'a'));
+
+    std::vector<unsigned char> packed = cbl::Bundle::compress(data.data(), data.size());
+    std::vector<unsigned char> out(data.size());
+    bool unpacked = cbl::Bundle::decompress(packed.data(), packed.size(), out.data(), out.size());
+    bool truncated = cbl::Bundle::decompress(packed.data(), packed.size() - 1, out.data(), out.size());
+    bool overflow = cbl::Bundle::decompress(packed.data(), packed.size(), out.data(), out.size() - 1);
+
+    cr_assert_lt(packed.size(), data.size() / 2);
+    cr_assert(unpacked);
+    cr_assert(out == data);
+    cr_assert_not(truncated);
+    cr_assert_not(overflow);
+
+    std::vector<unsigned char> empty = cbl::Bundle::compress(nullptr, 0);
+    bool unpacked_empty = cbl::Bundle::decompress(empty.data(), empty.size(), nullptr, 0);
+
+    cr_assert(unpacked_empty);
+}
+
+Test(BundleTests, Index, .description = "Create a bundle of libm and a text "
+        "file. The index should list both, page aligned, with libm's build-id.") {
+    cr_assert(createBundle(cbl::Bundle::Compression::None));
+
+    cbl::Bundle bundle(bundlePath());
+    cbl::Bundle::Entry libm;
+    cbl::Bundle::Entry text;
+    std::vector<std::string> names = bundle.getNames();
+
+    cr_assert(bundle.isLoaded());
+    cr_assert_eq(bundle.size(), 2);
+    cr_assert_eq(names.size(), 2);
+    cr_assert_str_eq(names[0].c_str(), "libm");
+    cr_assert_str_eq(names[1].c_str(), "text");
+    cr_assert(bundle.find("libm", libm));
+    cr_assert(bundle.find("text", text));
+    cr_assert_not(bundle.find("none", text));
+
+    cr_assert(libm.id.isValid());
+    cr_assert_not(text.id.isValid());
+    cr_assert_eq(libm.offset % cbl::Bundle::page_size, 0);
+    cr_assert_eq(text.offset % cbl::Bundle::page_size, 0);
+    cr_assert_eq(text.size, 19000);
+
+    std::string content(text.size, '\0');
+
+    cr_assert(bundle.extract(text, reinterpret_cast<unsigned char *>(content.data())));
+    cr_assert_eq(content.find("line 3 of the text\n"), 57);
+}
+
+Test(BundleTests, Open, .description = "Open libm from a stored and from a "
+        "compressed bundle. Both should load, with the build-id of the index.") {
+    for (auto compression : {cbl::Bundle::Compression::None, cbl::Bundle::Compression::Lz}) {
+        cr_assert(createBundle(compression));
+
+        cbl::Bundle bundle(bundlePath());
+        cbl::Bundle::Entry entry;
+        cbl::LinuxBundleBackend bck("libm", bundle);
+
+        cr_assert(bundle.find("libm", entry));
+        cr_assert_eq(entry.compression, compression);
+        cr_assert_not(bck.hasError(), "%s", bck.getLastError().c_str());
+        cr_assert(tests::callsFrexp(bck));
+        cr_assert(bck.getBuildId() == entry.id);
+    }
+}
+
+Test(BundleTests, IndependentCopies, .description = "Open the same plugin of "
+        "a bundle twice. Each backend should load a copy of its own.") {
+    cr_assert(createBundle(cbl::Bundle::Compression::None));
+
+    cbl::Bundle bundle(bundlePath());
+    cbl::LinuxBundleBackend first("libm", bundle);
+    cbl::LinuxBundleBackend second("libm", bundle);
+
+    cr_assert_not(first.hasError(), "%s", first.getLastError().c_str());
+    cr_assert_not(second.hasError(), "%s", second.getLastError().c_str());
+    cr_assert_neq(first.getSymbol("frexp"), second.getSymbol("frexp"));
+    cr_assert(tests::callsFrexp(first));
+    cr_assert(tests::callsFrexp(second));
+}
+
+Test(BundleTests, Loader, .description = "Open plugins of a bundle through a "
+        "BasicLoader. A missing plugin should throw, and not be opened by "
+        "reset().") {
+    cr_assert(createBundle(cbl::Bundle::Compression::Lz));
+
+    cbl::Bundle bundle(bundlePath());
+    cdl::BasicLoader<cbl::LinuxBundleBackend> loader("libm", bundle);
+
+    cr_assert_throw((cdl::BasicLoader<cbl::LinuxBundleBackend>("nothing", bundle)), std::exception);
+    cr_assert_not(loader.reset("nothing"));
+    cr_assert_not_null(loader.getSymbol<tests::Frexp>("frexp"));
+}
+
+Test(BundleTests, Corrupted, .description = "Alter a byte of the index of a "
+        "bundle. The bundle should be empty.") {
+    cr_assert(createBundle(cbl::Bundle::Compression::None));
+
+    {
+        std::fstream file(bundlePath(), std::ios::in | std::ios::out | std::ios::binary);
+
+        file.seekp(200);
+        file.put('#');
+    }
+
+    cbl::Bundle bundle(bundlePath());
+    cbl::Bundle::Entry entry;
+
+    cr_assert_not(bundle.isLoaded());
+    cr_assert_eq(bundle.size(), 0);
+    cr_assert_not(bundle.find("libm", entry));
+}
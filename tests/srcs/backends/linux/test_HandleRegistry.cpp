@@ -0,0 +1,80 @@
+#include <criterion/criterion.h>
+#include <string>
+
+#include <dlfcn.h>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/HandleRegistry.hpp"
+#include "backends/linux/LinuxSharedBackend.hpp"
+#include "../../resources/libraries.h"
+
+namespace cd = clonixin::dynamicloader;
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+
+using namespace std::string_literals;
+
+TestSuite(HandleRegistryTests);
+
+Test(HandleRegistryTests, SamePath, .description = "Open the same library twice. "
+        "Both opens should share the same backend.") {
+    auto &registry = cbl::HandleRegistry::instance();
+    auto first = registry.open("libm.so.6"s);
+    auto second = registry.open("libm.so.6"s);
+
+    cr_assert_not(first->hasError(), "Could not open libm.so.6");
+    cr_assert_eq(first.get(), second.get());
+}
+
+Test(HandleRegistryTests, SameFile, .description = "Open a library by soname, then "
+        "by absolute path. Both opens should share the same backend.") {
+    auto &registry = cbl::HandleRegistry::instance();
+    auto by_soname = registry.open("libm.so.6"s);
+    std::string path = tests::realPath("libm.so.6");
+
+    cr_assert_not(path.empty());
+
+    auto by_path = registry.open(path);
+    cr_assert_not(by_path->hasError());
+    cr_assert_eq(by_soname.get(), by_path.get());
+}
+
+Test(HandleRegistryTests, NoLoad, .description = "Open libraries with NoLoad. "
+        "Resident ones should be adopted, others should fail.") {
+    auto &registry = cbl::HandleRegistry::instance();
+    auto resident = registry.open("libc.so.6"s, cbl::OpenFlags::Lazy | cbl::OpenFlags::NoLoad);
+    auto missing = registry.open("libdoes_not_exist.so"s, cbl::OpenFlags::Lazy | cbl::OpenFlags::NoLoad);
+
+    cr_assert_not(resident->hasError(), "libc.so.6 should be resident");
+    cr_assert_not_null(resident->lookupSymbol("malloc").sym);
+    cr_assert(missing->hasError());
+}
+
+Test(HandleRegistryTests, Release, .description = "Drop every reference on a shared "
+        "backend. The registry should forget it.") {
+    auto &registry = cbl::HandleRegistry::instance();
+    std::size_t before = registry.size();
+
+    {
+        auto backend = registry.open("libdl.so.2"s);
+        auto other = registry.open("libdl.so.2"s);
+
+        cr_assert_not(backend->hasError(), "Could not open libdl.so.2");
+        cr_assert_eq(registry.size(), before + 1);
+    }
+
+    cr_assert_eq(registry.size(), before);
+}
+
+Test(HandleRegistryTests, SharedLoader, .description = "Build two loaders on a "
+        "LinuxSharedBackend for the same library. They should share their handle, "
+        "and resolve symbols as a LinuxBackend would.") {
+    cd::BasicLoader<cbl::LinuxSharedBackend> first("libm.so.6"s);
+    cd::BasicLoader<cbl::LinuxSharedBackend> second("libm.so.6"s);
+
+    cr_assert_eq(first.accessBackend().getShared().get(), second.accessBackend().getShared().get());
+    cr_assert_not_null(first.getSymbol<void *>("cos"));
+    cr_assert(second.hasSymbol("sin"));
+    cr_assert_not(second.hasSymbol("this_symbol_does_not_exist"));
+    cr_assert_throw(cd::BasicLoader<cbl::LinuxSharedBackend>("libdoes_not_exist.so"s),
+            cd::exceptions::DLException<cd::exceptions::Type::Open>);
+}
@@ -0,0 +1,92 @@
+#include <criterion/criterion.h>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <dlfcn.h>
+
+#include "backends/linux/LinuxBackend.hpp"
+#include "../../resources/libraries.h"
+
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+namespace fs = std::filesystem;
+
+using namespace std::string_literals;
+
+TestSuite(LinuxBackendTests);
+
+Test(LinuxBackendTests, HasSymbol, .description = "Open libm with a LinuxBackend, "
+        "then check for symbols defined in libm and in it's dependencies.") {
+    cbl::LinuxBackend bck("libm.so.6"s);
+
+    cr_assert_not(bck.hasError(), "Could not open libm.so.6");
+    cr_assert(bck.hasSymbol("cos"s));
+    cr_assert_not(bck.hasError());
+    cr_assert(bck.hasSymbol("malloc"s), "Symbols of dependencies should be found.");
+    cr_assert_not(bck.hasError());
+}
+
+Test(LinuxBackendTests, HasSymbolMissing, .description = "Open libm with a LinuxBackend, "
+        "then check for symbols that are not defined. hasSymbol should return false, "
+        "and a following getSymbol should still report the error.") {
+    cbl::LinuxBackend bck("libm.so.6"s);
+
+    for (int i = 0; i < 64; ++i) {
+        std::string name = "this_symbol_does_not_exist_"s + std::to_string(i);
+
+        cr_expect_not(bck.hasSymbol(name), "%s should not exist", name.c_str());
+        cr_expect(bck.hasError());
+    }
+
+    cr_assert_null(bck.getSymbol("this_symbol_does_not_exist"s));
+    cr_assert(bck.hasError());
+    cr_assert_not(bck.getLastError().empty());
+}
+
+Test(LinuxBackendTests, HasSymbolAfterReset, .description = "Reset a LinuxBackend "
+        "to another library. hasSymbol should use the scope of the new library.") {
+    cbl::LinuxBackend bck("libm.so.6"s);
+
+    cr_assert(bck.hasSymbol("cos"s));
+    bck.reset("libdl.so.2"s);
+    cr_assert_not(bck.hasError(), "Could not open libdl.so.2");
+    cr_assert(bck.hasSymbol("dlopen"s));
+}
+
+Test(LinuxBackendTests, ProgramScopeIsGlobal, .description = "Open libresolv with "
+        "RTLD_GLOBAL, then look its symbols up through the program handle. The bloom "
+        "filters of the program's dependencies should not reject them.") {
+    char const *names[] = {"inet_net_ntop", "inet_neta", "ns_datetosecs", "ns_format_ttl",
+        "ns_makecanon", "ns_msg_getflag", "ns_name_rollback", "ns_parse_ttl",
+        "ns_samedomain", "ns_samename", "ns_sprintrrf", "ns_subdomain"};
+    void *global = dlopen("libresolv.so.2", RTLD_LAZY | RTLD_GLOBAL);
+    cbl::LinuxBackend bck = cbl::LinuxBackend::InternalSymbolBackend(cbl::OpenFlags::Lazy);
+
+    cr_assert_not_null(global, "Could not open libresolv.so.2");
+    for (char const *name : names) {
+        cr_expect(bck.mayContainSymbol(name), "%s should not be filtered out", name);
+        cr_expect(bck.containsSymbol(name), "%s should be found", name);
+    }
+
+    dlclose(global);
+}
+
+Test(LinuxBackendTests, MoveAssignCloses, .description = "Move a backend over one "
+        "holding a copy of libm. The copy should be closed, not leaked.") {
+    char tmpl[] = "/tmp/moveassign_XXXXXX";
+    fs::path dir(mkdtemp(tmpl));
+    fs::path path = dir / "libm-copy.so";
+    Dl_info info;
+
+    fs::copy_file(tests::realPath("libm.so.6"), path);
+    {
+        cbl::LinuxBackend bck(path.string());
+        void *cos = bck.getSymbol("cos");
+
+        cr_assert_not_null(cos, "Could not open the copy of libm");
+        bck = cbl::LinuxBackend("libdl.so.2"s);
+        cr_assert_not(bck.hasError(), "Could not open libdl.so.2");
+        cr_assert_eq(dladdr(cos, &info), 0, "The copy of libm should be closed.");
+    }
+    fs::remove_all(dir);
+}
@@ -0,0 +1,145 @@
+#include <criterion/criterion.h>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "backends/linux/LinuxBackend.hpp"
+#include "backends/linux/LinuxCachedBackend.hpp"
+#include "backends/linux/OffsetCache.hpp"
+#include "utils/Metrics.hpp"
+
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+namespace cdu = clonixin::dynamicloader::utils;
+
+using namespace std::string_literals;
+
+static char const *names[] = {
+    "cos", "sin", "frexp", "ldexp", "nextafter", "signgam", "malloc", "printf"
+};
+
+static std::string cachePath() {
+    return "/tmp/test_offset_cache_"s + std::to_string(getpid());
+}
+
+static void removeCache() {
+    (void)unlink(cachePath().c_str());
+}
+
+static std::uint64_t dlsymCalls() {
+    return cdu::Metrics::snapshot()[cdu::Metrics::Latency::Dlsym].count;
+}
+
+TestSuite(LinuxCachedBackendTests, .init = removeCache, .fini = removeCache);
+
+Test(LinuxCachedBackendTests, NoFile, .description = "Open libm with a cache "
+        "file that doesn't exist. Every lookup should go through dlsym, and "
+        "return the same address.") {
+    cbl::OffsetCache cache(cachePath());
+    cbl::LinuxBackend ref("libm.so.6"s);
+    cbl::LinuxCachedBackend bck("libm.so.6"s, cache);
+
+    cr_assert_not(cache.isLoaded());
+    cr_assert_not(bck.hasError());
+    cr_assert(bck.getBuildId().isValid());
+
+    for (char const *name : names)
+        cr_expect_eq(bck.getSymbol(name), ref.getSymbol(name), "Address mismatch for symbol %s", name);
+}
+
+Test(LinuxCachedBackendTests, RoundTrip, .description = "Resolve symbols, save "
+        "the cache, and load it again. Symbols defined by libm itself should be "
+        "served without dlsym, the others as before.") {
+    cbl::LinuxBackend ref("libm.so.6"s);
+
+    {
+        cbl::OffsetCache cache(cachePath());
+        cbl::LinuxCachedBackend bck("libm.so.6"s, cache);
+
+        for (char const *name : names)
+            (void)bck.getSymbol(name);
+        cr_assert(cache.save());
+    }
+
+    cbl::OffsetCache cache(cachePath());
+    cbl::LinuxCachedBackend bck("libm.so.6"s, cache);
+
+    cr_assert(cache.isLoaded());
+    cr_assert_eq(cache.size(), 4);
+
+    cdu::Metrics::setEnabled(true);
+    std::uint64_t before = dlsymCalls();
+
+    for (char const *name : {"frexp", "ldexp", "nextafter", "signgam"})
+        cr_expect_eq(bck.getSymbol(name), ref.getSymbol(name), "Address mismatch for symbol %s", name);
+
+    std::uint64_t cached = dlsymCalls() - before - 4;
+
+    for (char const *name : {"cos", "malloc"})
+        cr_expect_eq(bck.getSymbol(name), ref.getSymbol(name), "Address mismatch for symbol %s", name);
+
+    std::uint64_t uncached = dlsymCalls() - before - 4 - cached;
+    cdu::Metrics::setEnabled(false);
+
+    cr_assert_eq(cached, 0);
+    cr_assert_eq(uncached, 4);
+}
+
+Test(LinuxCachedBackendTests, Corrupted, .description = "Save a cache, then "
+        "alter a byte of the file. The file should be ignored.") {
+    {
+        cbl::OffsetCache cache(cachePath());
+        cbl::LinuxCachedBackend bck("libm.so.6"s, cache);
+
+        (void)bck.getSymbol("frexp");
+        cr_assert(cache.save());
+    }
+
+    {
+        std::fstream file(cachePath(), std::ios::in | std::ios::out | std::ios::binary);
+
+        file.seekp(-1, std::ios::end);
+        file.put('#');
+    }
+
+    cbl::OffsetCache cache(cachePath());
+    cbl::LinuxBackend ref("libm.so.6"s);
+    cbl::LinuxCachedBackend bck("libm.so.6"s, cache);
+
+    cr_assert_not(cache.isLoaded());
+    cr_assert_eq(bck.getSymbol("frexp"), ref.getSymbol("frexp"));
+}
+
+Test(LinuxCachedBackendTests, Rebuilt, .description = "Save entries for a "
+        "previous build of libm, then open the current one. The old entries "
+        "should not be used, and be dropped by the next save.") {
+    cbl::BuildId old_id;
+
+    old_id.size = 20;
+    old_id.bytes.fill(0x42);
+
+    {
+        cbl::OffsetCache cache(cachePath());
+
+        (void)cache.attach(old_id, "libm.so.6", 1 << 20);
+        cache.record(old_id, "frexp", 0x1000);
+        cr_assert(cache.save());
+    }
+
+    {
+        cbl::OffsetCache cache(cachePath());
+        cbl::LinuxBackend ref("libm.so.6"s);
+        cbl::LinuxCachedBackend bck("libm.so.6"s, cache);
+
+        cr_assert(cache.isLoaded());
+        cr_assert_eq(bck.getSymbol("frexp"), ref.getSymbol("frexp"));
+        cr_assert(cache.save());
+    }
+
+    cbl::OffsetCache cache(cachePath());
+    std::size_t size = cache.size();
+    bool stale = !cache.attach(old_id, "libm.so.6", 1 << 20).empty();
+
+    cr_assert_eq(size, 1);
+    cr_assert_not(stale);
+}
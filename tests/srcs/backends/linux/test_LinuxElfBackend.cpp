@@ -0,0 +1,59 @@
+#include <criterion/criterion.h>
+#include <string>
+
+#include "backends/linux/LinuxBackend.hpp"
+#include "backends/linux/LinuxElfBackend.hpp"
+
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+
+using namespace std::string_literals;
+
+static char const *names[] = {
+    "cos", "sin", "exp", "log", "frexp", "ldexp", "nan",
+    "signgam", "malloc", "free", "printf", "environ"
+};
+
+TestSuite(LinuxElfBackendTests);
+
+Test(LinuxElfBackendTests, Open, .description = "Open libm with a LinuxElfBackend. "
+        "The lookup scope should contain libm and it's dependencies.") {
+    cbl::LinuxElfBackend bck("libm.so.6"s);
+
+    cr_assert_not(bck.hasError(), "Could not open libm.so.6");
+    cr_assert_gt(bck.getScope().size(), 1, "Dependencies of libm are missing from the scope.");
+    cr_assert_str_eq(bck.getScope()[0].getSoname(), "libm.so.6");
+}
+
+Test(LinuxElfBackendTests, OpenError, .description = "Open a non existing library "
+        "with a LinuxElfBackend. It should report an error.") {
+    cbl::LinuxElfBackend bck("libdoesnotexist.so"s);
+
+    cr_assert(bck.hasError());
+    cr_assert_not(bck.getLastError().empty());
+}
+
+Test(LinuxElfBackendTests, SameAsDlsym, .description = "Open libm with both a "
+        "LinuxBackend and a LinuxElfBackend. Every lookups should return the same address.") {
+    cbl::LinuxBackend ref("libm.so.6"s);
+    cbl::LinuxElfBackend bck("libm.so.6"s);
+
+    for (char const *name : names) {
+        void *expected = ref.getSymbol(name);
+        void *sym = bck.getSymbol(name);
+
+        cr_expect_eq(sym, expected, "Address mismatch for symbol %s", name);
+        cr_expect_not(bck.hasError(), "Error on symbol %s", name);
+    }
+}
+
+Test(LinuxElfBackendTests, UndefinedSymbol, .description = "Open libm with a LinuxElfBackend, "
+        "then look for an undefined symbol. It should report an error.") {
+    cbl::LinuxElfBackend bck("libm.so.6"s);
+
+    cr_assert_null(bck.getSymbol("this_symbol_does_not_exist"s));
+    cr_assert(bck.hasError());
+    cr_assert_not(bck.getLastError().empty());
+    cr_assert_not(bck.hasSymbol("this_symbol_does_not_exist"s));
+    cr_assert(bck.hasSymbol("cos"s));
+    cr_assert_not(bck.hasError());
+}
@@ -0,0 +1,102 @@
+#include <criterion/criterion.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "backends/linux/LinuxMemoryBackend.hpp"
+#include "../../resources/libraries.h"
+
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+
+using namespace std::string_literals;
+
+static std::vector<char> libmBytes() {
+    std::ifstream file(tests::realPath("libm.so.6"), std::ios::binary);
+
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TestSuite(LinuxMemoryBackendTests);
+
+Test(LinuxMemoryBackendTests, FromMemory, .description = "Load libm from a copy "
+        "of its bytes. It should load, and its functions should work.") {
+    std::vector<char> bytes = libmBytes();
+    cbl::LinuxMemoryBackend bck(bytes.data(), bytes.size(), "libm-copy");
+
+    cr_assert_not(bytes.empty());
+    cr_assert_not(bck.hasError(), "%s", bck.getLastError().c_str());
+    cr_assert_str_eq(bck.getPath().c_str(), "memfd:libm-copy");
+    cr_assert(tests::callsFrexp(bck));
+}
+
+Test(LinuxMemoryBackendTests, FromFileSpan, .description = "Load libm embedded "
+        "in a larger file, after a header. Only the span should be loaded.") {
+    std::vector<char> bytes = libmBytes();
+    std::string path = "/tmp/test_memory_backend_"s + std::to_string(getpid());
+
+    {
+        std::ofstream file(path, std::ios::binary);
+
+        file << std::string(100, '#');
+        file.write(bytes.data(), bytes.size());
+        file << std::string(100, '#');
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    cbl::LinuxMemoryBackend bck(fd, 100, bytes.size(), "embedded");
+    bool open = fcntl(fd, F_GETFD) != -1;
+
+    ::close(fd);
+    (void)unlink(path.c_str());
+
+    cr_assert_not(bck.hasError(), "%s", bck.getLastError().c_str());
+    cr_assert(tests::callsFrexp(bck));
+    cr_assert(open, "The descriptor of the caller should not be closed.");
+}
+
+Test(LinuxMemoryBackendTests, WholeFile, .description = "Load libm from a "
+        "descriptor on the whole file. It should be opened without a copy.") {
+    int fd = ::open(tests::realPath("libm.so.6").c_str(), O_RDONLY | O_CLOEXEC);
+    cbl::LinuxMemoryBackend bck(fd, 0, 0, "whole");
+
+    ::close(fd);
+
+    cr_assert_not(bck.hasError(), "%s", bck.getLastError().c_str());
+    cr_assert(tests::callsFrexp(bck));
+}
+
+Test(LinuxMemoryBackendTests, IndependentCopies, .description = "Load libm "
+        "twice from the same bytes, then twice from the whole file. The bytes "
+        "should give two copies, and the whole file a single shared one.") {
+    std::vector<char> bytes = libmBytes();
+    cbl::LinuxMemoryBackend first(bytes.data(), bytes.size(), "libm-first");
+    cbl::LinuxMemoryBackend second(bytes.data(), bytes.size(), "libm-second");
+
+    cr_assert_not(first.hasError(), "%s", first.getLastError().c_str());
+    cr_assert_not(second.hasError(), "%s", second.getLastError().c_str());
+    cr_assert_neq(first.getSymbol("frexp"), second.getSymbol("frexp"));
+
+    int fd = ::open(tests::realPath("libm.so.6").c_str(), O_RDONLY | O_CLOEXEC);
+    cbl::LinuxMemoryBackend whole_first(fd, 0, 0, "whole-first");
+    cbl::LinuxMemoryBackend whole_second(fd, 0, 0, "whole-second");
+
+    ::close(fd);
+    cr_assert_not(whole_first.hasError(), "%s", whole_first.getLastError().c_str());
+    cr_assert_eq(whole_first.getSymbol("frexp"), whole_second.getSymbol("frexp"));
+}
+
+Test(LinuxMemoryBackendTests, Errors, .description = "Load garbage, and from "
+        "a bad descriptor. Both should report an error.") {
+    std::string garbage(4096, 'x');
+    cbl::LinuxMemoryBackend bad_bytes(garbage.data(), garbage.size(), "garbage");
+    cbl::LinuxMemoryBackend bad_fd(-1, 0, 0, "nothing");
+
+    cr_assert(bad_bytes.hasError());
+    cr_assert_not(bad_bytes.getLastError().empty());
+    cr_assert(bad_fd.hasError());
+    cr_assert_eq(bad_fd.getLastError().find("memfd:nothing: "), 0);
+}
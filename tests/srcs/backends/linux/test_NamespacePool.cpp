@@ -0,0 +1,95 @@
+#include <criterion/criterion.h>
+#include <string>
+#include <vector>
+
+#include "backends/linux/LinuxScopedBackend.hpp"
+#include "backends/linux/NamespacePool.hpp"
+#include "../../resources/libraries.h"
+
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+
+using namespace std::string_literals;
+
+TestSuite(NamespacePoolTests);
+
+Test(NamespacePoolTests, Prepare, .description = "Prepare namespaces, then "
+        "trim them. The pool should never exceed its capacity, and close "
+        "every namespace without library.") {
+    cbl::NamespacePool pool(2);
+
+    cr_assert(pool.prepare(1));
+    cr_assert_eq(pool.size(), 1);
+    cr_assert(pool.prepare(5));
+    cr_assert_eq(pool.size(), 2);
+    cr_assert_eq(pool.getLeased(), 0);
+    cr_assert_eq(pool.trim(1), 1);
+    cr_assert_eq(pool.size(), 1);
+}
+
+Test(NamespacePoolTests, Isolate, .description = "Open libm twice with a pool "
+        "of two isolating namespaces. Each should get its own namespace, a "
+        "third one should fail, and a released namespace be reused.") {
+    cbl::NamespacePool pool(2);
+    cbl::LinuxScopedBackend first("libm.so.6"s, pool);
+
+    {
+        cbl::LinuxScopedBackend second("libm.so.6"s, pool);
+        cbl::LinuxScopedBackend third("libm.so.6"s, pool);
+        std::vector<std::string> libs = pool.getLibraries(second.getScope());
+
+        cr_assert_not(first.hasError(), "%s", first.getLastError().c_str());
+        cr_assert_not(second.hasError(), "%s", second.getLastError().c_str());
+        cr_assert(first.getScope() != second.getScope());
+        cr_assert(first.getScope() != cbl::LinuxScopedBackend::BaseScope);
+        cr_assert(tests::callsFrexp(first));
+        cr_assert(tests::callsFrexp(second));
+        cr_assert_eq(libs.size(), 1);
+        cr_assert_str_eq(libs[0].c_str(), "libm.so.6");
+
+        cr_assert(third.hasError());
+        cr_assert_eq(pool.getLeased(), 2);
+    }
+
+    cr_assert_eq(pool.getLeased(), 1);
+
+    cbl::LinuxScopedBackend again("libm.so.6"s, pool);
+
+    cr_assert_not(again.hasError(), "%s", again.getLastError().c_str());
+    cr_assert_eq(pool.size(), 2);
+    cr_assert(tests::callsFrexp(again));
+}
+
+Test(NamespacePoolTests, Pack, .description = "Open different libraries in a "
+        "pool of one namespace holding up to four. They should share it, "
+        "but the same path should not be opened twice in it.") {
+    cbl::NamespacePool pool(1, 4);
+    cbl::LinuxScopedBackend libm("libm.so.6"s, pool);
+    cbl::LinuxScopedBackend libz("libz.so.1"s, pool);
+    cbl::LinuxScopedBackend twice("libm.so.6"s, pool);
+
+    cr_assert_not(libm.hasError(), "%s", libm.getLastError().c_str());
+    cr_assert_not(libz.hasError(), "%s", libz.getLastError().c_str());
+    cr_assert(libm.getScope() == libz.getScope());
+    cr_assert(twice.hasError());
+    cr_assert_eq(pool.getLibraries(libm.getScope()).size(), 2);
+}
+
+Test(NamespacePoolTests, Reset, .description = "Reset a pooled backend to "
+        "another library, then to the base scope. Its namespace should be "
+        "given back to the pool.") {
+    cbl::NamespacePool pool(1, 4);
+    cbl::LinuxScopedBackend bck("libz.so.1"s, pool);
+
+    cr_assert(bck.reset("libm.so.6"s, pool));
+    cr_assert(tests::callsFrexp(bck));
+
+    std::vector<std::string> libs = pool.getLibraries(bck.getScope());
+
+    cr_assert_eq(libs.size(), 1);
+    cr_assert_str_eq(libs[0].c_str(), "libm.so.6");
+
+    cr_assert(bck.reset("libm.so.6"s, cbl::LinuxScopedBackend::BaseScope));
+    cr_assert(bck.getScope() == cbl::LinuxScopedBackend::BaseScope);
+    cr_assert_eq(pool.getLeased(), 0);
+    cr_assert(tests::callsFrexp(bck));
+}
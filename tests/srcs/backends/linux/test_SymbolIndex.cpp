@@ -0,0 +1,53 @@
+#include <criterion/criterion.h>
+#include <cstring>
+#include <string>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/LinuxBackend.hpp"
+#include "backends/linux/SymbolIndex.hpp"
+
+namespace cd = clonixin::dynamicloader;
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+
+using namespace std::string_literals;
+
+TestSuite(SymbolIndexTests);
+
+Test(SymbolIndexTests, Enumerate, .description = "Open libm, then enumerate it's symbols. "
+        "They should be sorted, and resolve to the same address as dlsym.") {
+    cbl::LinuxBackend bck("libm.so.6"s);
+    cbl::LinuxBackend ref("libm.so.6"s);
+    auto const &index = bck.getSymbolIndex();
+    char const *prev = "";
+
+    cr_assert_gt(index.size(), 100, "Too few symbols in libm.");
+
+    for (auto const &info : index) {
+        cr_expect_leq(std::strcmp(prev, info.name), 0, "Symbols are not sorted.");
+        prev = info.name;
+
+        if (info.type == STT_FUNC || info.type == STT_OBJECT)
+            cr_expect_eq(info.address, ref.getSymbol(info.name), "Address mismatch for %s", info.name);
+    }
+}
+
+Test(SymbolIndexTests, Find, .description = "Open libm, then look for a given symbol in it's index.") {
+    cbl::LinuxBackend bck("libm.so.6"s);
+    auto const &index = bck.getSymbolIndex();
+
+    cr_assert_not_null(index.find("cosf"s));
+    cr_assert_str_eq(index.find("cosf"s)->name, "cosf");
+    cr_assert_null(index.find("malloc"s), "Symbols of dependencies should not be listed.");
+}
+
+Test(SymbolIndexTests, Prefix, .description = "Open libm through a BasicLoader, then list every "
+        "symbols starting with a given prefix.") {
+    cd::BasicLoader<cbl::LinuxBackend> loader("libm.so.6"s);
+    auto range = loader.getSymbolIndex().withPrefix("cos"s);
+
+    cr_assert_geq(range.size(), 3, "cos, cosf and cosh should be found.");
+    for (auto const &info : range)
+        cr_expect_eq(std::strncmp(info.name, "cos", 3), 0, "%s does not start with cos", info.name);
+
+    cr_assert(loader.getSymbolIndex().withPrefix("this_prefix_does_not_exist"s).empty());
+}
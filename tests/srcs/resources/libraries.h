@@ -0,0 +1,42 @@
+#ifndef RES_LIBRARIES_H__
+#define RES_LIBRARIES_H__
+
+#include <string>
+
+#include <dlfcn.h>
+#include <link.h>
+
+namespace tests {
+    /*
+    ** Path of the file a system library is loaded from, so that tests can
+    ** copy it. Empty if it can't be opened.
+    */
+    inline std::string realPath(char const *soname) {
+        void *hndl = dlopen(soname, RTLD_LAZY);
+        struct link_map *lm = nullptr;
+        std::string path;
+
+        if (hndl != nullptr && dlinfo(hndl, RTLD_DI_LINKMAP, &lm) == 0)
+            path = lm->l_name;
+        if (hndl != nullptr)
+            dlclose(hndl);
+
+        return path;
+    }
+
+    using Frexp = double (*)(double, int *);
+
+    /*
+    ** Whether a backend opened on libm, or on a copy of it, gives a
+    ** working frexp().
+    */
+    template <class Backend>
+    bool callsFrexp(Backend &bck) {
+        Frexp fn = reinterpret_cast<Frexp>(bck.getSymbol("frexp"));
+        int exp = 0;
+
+        return fn != nullptr && fn(8.0, &exp) == 0.5 && exp == 4;
+    }
+}
+
+#endif
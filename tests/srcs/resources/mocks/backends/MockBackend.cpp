@@ -40,29 +40,30 @@ namespace tests::mocks::backends {
         return _has_error;
     }
 
-    bool    MockBackend::hasSymbol(std::string const &name) const noexcept {
+    bool    MockBackend::hasSymbol(clonixin::dynamicloader::utils::ZStringView name) const noexcept {
         resetLastError();
 
-        auto search = _map.find(name);
+        auto search = _map.find(name.view());
 
         return (search != _map.end());
     }
 
-    MockBackend::SymAddr MockBackend::getSymbol(std::string const &name) noexcept {
+    MockBackend::SymAddr MockBackend::getSymbol(clonixin::dynamicloader::utils::ZStringView name) noexcept {
         SymAddr ret = nullptr;
 
+        ++_lookups;
         resetLastError();
 
         if (hasSymbol(name) && !_fail_next.first)
-            ret = _map[name];
+            ret = _map.find(name.view())->second;
         else {
             _has_error = true;
 
             if (_fail_next.first) {
-                _last_error = _path + _fail_next.second + " when looking for symbol " + name;
+                _last_error = _path + _fail_next.second + " when looking for symbol " + name.c_str();
                 _fail_next = dont_fail;
             } else {
-                _last_error = _path + ": Could not find symbol: " + name;
+                _last_error = _path + ": Could not find symbol: " + name.c_str();
             }
         }
 
@@ -81,6 +82,10 @@ namespace tests::mocks::backends {
         return _path;
     }
 
+    std::size_t MockBackend::getLookupCount() const {
+        return _lookups;
+    }
+
     void MockBackend::setNextError(MockBackend::fail_t fail){
         _fail_next = fail;
     }
@@ -1,11 +1,14 @@
 #ifndef MOCKS_BACKENDS_MOCKBACKEND_HPP__
 #define MOCKS_BACKENDS_MOCKBACKEND_HPP__
 
-#include <unordered_map>
+#include <functional>
+#include <map>
+
+#include "utils/ZStringView.hpp"
 
 namespace tests::mocks::backends {
     class MockBackend {
-            using ptrmap_t = std::unordered_map<std::string, void *>;
+            using ptrmap_t = std::map<std::string, void *, std::less<>>;
             using ptrmap_v = ptrmap_t::value_type;
         public:
             using list_t = std::initializer_list<ptrmap_v>;
@@ -24,13 +27,15 @@ namespace tests::mocks::backends {
 
             bool reset(std::string const &path, std::initializer_list<ptrmap_v> l, fail_t const &fail = dont_fail) noexcept;
 
-            bool        hasSymbol(std::string const &name) const noexcept;
-            SymAddr     getSymbol(std::string const &name) noexcept;
+            bool        hasSymbol(clonixin::dynamicloader::utils::ZStringView name) const noexcept;
+            SymAddr     getSymbol(clonixin::dynamicloader::utils::ZStringView name) noexcept;
 
             bool        hasError() const;
             std::string getLastError() const;
             std::string getPath() const;
 
+            std::size_t getLookupCount() const;
+
             void        setNextError(fail_t fail);
             void *&     operator[](std::string const &key);// {return _map[key];}
 
@@ -42,6 +47,7 @@ namespace tests::mocks::backends {
             mutable std::string _last_error;
             mutable bool _has_error;
             std::pair<bool, std::string> _fail_next;
+            std::size_t _lookups = 0;
     };
 } // namespace clonixin::dynamicloader::back
 
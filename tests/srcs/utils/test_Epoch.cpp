@@ -0,0 +1,162 @@
+#include <criterion/criterion.h>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dlfcn.h>
+
+#include "backends/linux/LinuxBackend.hpp"
+#include "utils/Epoch.hpp"
+#include "../resources/libraries.h"
+
+namespace cbl = clonixin::dynamicloader::backends::_linux;
+namespace cdu = clonixin::dynamicloader::utils;
+namespace fs = std::filesystem;
+
+static bool isLoaded(std::string const &path) {
+    void *hndl = dlopen(path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+
+    if (hndl != nullptr)
+        dlclose(hndl);
+
+    return hndl != nullptr;
+}
+
+static void countRelease(void *counter) {
+    static_cast<std::atomic<int> *>(counter)->fetch_add(1);
+}
+
+static void deleteInt(void *value) {
+    delete static_cast<int *>(value);
+}
+
+TestSuite(EpochTests);
+
+Test(EpochTests, Unpinned, .description = "Retire a resource while no thread is "
+        "pinned. It should be released right away.") {
+    std::atomic<int> released{0};
+
+    cdu::Epoch::retire(&countRelease, &released);
+
+    cr_assert_eq(released.load(), 1);
+}
+
+Test(EpochTests, Pinned, .description = "Retire a resource while the thread is "
+        "pinned, with nested guards. It should only be released once the "
+        "outermost guard is gone.") {
+    std::atomic<int> released{0};
+
+    {
+        cdu::EpochGuard outer;
+        {
+            cdu::EpochGuard inner;
+
+            cdu::Epoch::retire(&countRelease, &released);
+        }
+
+        cr_assert(cdu::Epoch::isPinned());
+        (void)cdu::Epoch::collect();
+        cr_assert_eq(released.load(), 0);
+    }
+
+    cr_assert_not(cdu::Epoch::isPinned());
+    (void)cdu::Epoch::collect();
+    cr_assert_eq(released.load(), 1);
+}
+
+Test(EpochTests, OtherThread, .description = "Retire a resource while another "
+        "thread is pinned. synchronize() should wait for that thread.") {
+    std::atomic<int> released{0};
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> leave{false};
+
+    std::thread reader([&]() {
+        cdu::EpochGuard guard;
+
+        pinned.store(true);
+        while (!leave.load())
+            std::this_thread::yield();
+    });
+
+    while (!pinned.load())
+        std::this_thread::yield();
+
+    cdu::Epoch::retire(&countRelease, &released);
+    int before = released.load();
+
+    leave.store(true);
+    cdu::Epoch::synchronize();
+    reader.join();
+
+    cr_assert_eq(before, 0);
+    cr_assert_eq(released.load(), 1);
+}
+
+Test(EpochTests, DeferredDlclose, .description = "Destroy a backend while the "
+        "thread is pinned. The library should stay loaded, and usable, until "
+        "the guard is gone.") {
+    char tmpl[] = "/tmp/epoch_XXXXXX";
+    fs::path dir = mkdtemp(tmpl);
+    std::string path = (dir / "libm_copy.so").string();
+
+    fs::copy_file(tests::realPath("libm.so.6"), path);
+
+    {
+        cdu::EpochGuard guard;
+        double (*cosine)(double) = nullptr;
+
+        {
+            cbl::LinuxBackend backend(path, cbl::OpenFlags::Default);
+
+            cr_assert_not(backend.hasError());
+            cosine = reinterpret_cast<double (*)(double)>(backend.getSymbol("cos"));
+        }
+
+        cr_assert(isLoaded(path));
+        cr_assert_float_eq(cosine(0.0), 1.0, 1e-9);
+    }
+
+    (void)cdu::Epoch::collect();
+    cr_assert_not(isLoaded(path));
+
+    fs::remove_all(dir);
+}
+
+Test(EpochTests, Readers, .description = "Swap and retire a shared value while "
+        "pinned threads keep reading it. Every value should be released once, "
+        "and never while being read.") {
+    std::atomic<int *> current{new int(0)};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    std::atomic<long> bad{0};
+
+    for (int i = 0; i < 4; ++i)
+        readers.emplace_back([&]() {
+            while (!stop.load(std::memory_order_relaxed)) {
+                cdu::EpochGuard guard;
+                int *value = current.load(std::memory_order_acquire);
+
+                if (*value < 0)
+                    bad.fetch_add(1);
+            }
+        });
+
+    for (int i = 1; i <= 2000; ++i) {
+        int *old = current.exchange(new int(i), std::memory_order_acq_rel);
+
+        cdu::Epoch::retire(&deleteInt, old);
+    }
+
+    stop.store(true);
+    for (auto &t : readers)
+        t.join();
+
+    cdu::Epoch::synchronize();
+    delete current.load();
+
+    cr_assert_eq(bad.load(), 0);
+    cr_assert_eq(cdu::Epoch::getPending(), 0);
+}
@@ -0,0 +1,118 @@
+#include <criterion/criterion.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/backends.hpp"
+#include "utils/Metrics.hpp"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace cde = clonixin::dynamicloader::exceptions;
+namespace cdu = clonixin::dynamicloader::utils;
+
+using Metrics = cdu::Metrics;
+using Counter = Metrics::Counter;
+using Latency = Metrics::Latency;
+
+static void enable() {
+    Metrics::setEnabled(true);
+}
+
+static void disable() {
+    Metrics::setEnabled(false);
+}
+
+TestSuite(MetricsTests, .init = enable, .fini = disable);
+
+Test(MetricsTests, Loader, .description = "Open a library, look symbols up, and "
+        "close it. Every event should be counted, and every dl call timed.") {
+    Metrics::Snapshot before = Metrics::snapshot();
+
+    {
+        cd::BasicLoader<cdb::DefaultBackend> libm("libm.so.6");
+
+        (void)libm.getSymbol<void *>("cos");
+        (void)libm.getSymbol<void *>("cos");
+        (void)libm.tryGetSymbol<void *>("this_symbol_does_not_exist");
+        cr_assert_throw((void)libm.getSymbol<void *>("neither_does_this_one"),
+                cde::DLException<cde::Type::LoadSym>);
+    }
+
+    Metrics::Snapshot diff = Metrics::snapshot() - before;
+
+    cr_assert_eq(diff[Counter::Opens], 1);
+    cr_assert_eq(diff[Counter::Closes], 1);
+    cr_assert_eq(diff[Counter::Lookups], 4);
+    cr_assert_eq(diff[Counter::Hits], 1);
+    cr_assert_eq(diff[Counter::Misses], 3);
+    cr_assert_eq(diff[Counter::NotFound], 2);
+    cr_assert_eq(diff[Counter::Exceptions], 1);
+
+    cr_assert_eq(diff[Latency::Dlopen].count, 1);
+    cr_assert_eq(diff[Latency::Dlclose].count, 1);
+    cr_assert_geq(diff[Latency::Dlsym].count, 1);
+}
+
+Test(MetricsTests, Disabled, .description = "Use a loader while metrics are "
+        "disabled. Nothing should be recorded.") {
+    Metrics::setEnabled(false);
+    Metrics::Snapshot before = Metrics::snapshot();
+
+    {
+        cd::BasicLoader<cdb::DefaultBackend> libm("libm.so.6");
+
+        (void)libm.getSymbol<void *>("cos");
+    }
+
+    Metrics::Snapshot diff = Metrics::snapshot() - before;
+
+    cr_assert_eq(diff[Counter::Opens], 0);
+    cr_assert_eq(diff[Counter::Lookups], 0);
+    cr_assert_eq(diff[Latency::Dlsym].count, 0);
+}
+
+Test(MetricsTests, Threads, .description = "Count events from several threads, "
+        "which then exit. The snapshot should hold all of them.") {
+    Metrics::Snapshot before = Metrics::snapshot();
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([]() {
+            for (int n = 0; n < 1000; ++n) {
+                Metrics::add(Counter::Lookups);
+                Metrics::record(Latency::Dlsym, 1500);
+            }
+        });
+
+    for (auto &t : threads)
+        t.join();
+
+    Metrics::Snapshot diff = Metrics::snapshot() - before;
+
+    cr_assert_eq(diff[Counter::Lookups], 4000);
+    cr_assert_eq(diff[Latency::Dlsym].count, 4000);
+    cr_assert_eq(diff[Latency::Dlsym].buckets[10], 4000);
+    cr_assert_eq(diff[Latency::Dlsym].sum_ns, 6000000);
+}
+
+Test(MetricsTests, Text, .description = "Format a snapshot. It should hold "
+        "every counter, and cumulative histogram buckets, bounded by the largest "
+        "latency each of them holds.") {
+    Metrics::Snapshot snap;
+
+    snap.counters[static_cast<std::size_t>(Counter::Opens)] = 3;
+    snap.latencies[static_cast<std::size_t>(Latency::Dlopen)].buckets[2] = 5;
+    snap.latencies[static_cast<std::size_t>(Latency::Dlopen)].count = 5;
+
+    std::string text = Metrics::toText(snap);
+
+    cr_assert_neq(text.find("dynamicloader_opens_total 3\n"), std::string::npos);
+    cr_assert_neq(text.find("dynamicloader_exceptions_total 0\n"), std::string::npos);
+    cr_assert_neq(text.find("dynamicloader_dlopen_ns_bucket{le=\"3\"} 0\n"), std::string::npos);
+    cr_assert_neq(text.find("dynamicloader_dlopen_ns_bucket{le=\"7\"} 5\n"), std::string::npos);
+    cr_assert_eq(text.find("dynamicloader_dlopen_ns_bucket{le=\"8\"}"), std::string::npos,
+            "Bucket 2 does not hold 8ns operations.");
+    cr_assert_neq(text.find("dynamicloader_dlopen_ns_count 5\n"), std::string::npos);
+}
@@ -0,0 +1,148 @@
+#include <criterion/criterion.h>
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BasicLoader/BasicLoader.hpp"
+#include "backends/linux/backends.hpp"
+#include "utils/Trace.hpp"
+
+namespace cd = clonixin::dynamicloader;
+namespace cdb = clonixin::dynamicloader::backends;
+namespace cde = clonixin::dynamicloader::exceptions;
+namespace cdu = clonixin::dynamicloader::utils;
+
+using Trace = cdu::Trace;
+using Kind = Trace::Kind;
+
+static void enable() {
+    Trace::setEnabled(true);
+}
+
+static void disable() {
+    Trace::setEnabled(false);
+}
+
+static std::vector<Trace::Event> since(std::uint64_t start) {
+    std::vector<Trace::Event> events;
+
+    for (Trace::Event &e : Trace::collect())
+        if (e.start_ns >= start)
+            events.push_back(std::move(e));
+
+    return events;
+}
+
+static std::size_t count(std::vector<Trace::Event> const &events, Kind kind, std::string const &name) {
+    std::size_t n = 0;
+
+    for (Trace::Event const &e : events)
+        if (e.kind == kind && e.name.find(name) != std::string::npos)
+            ++n;
+
+    return n;
+}
+
+TestSuite(TraceTests, .init = enable, .fini = disable);
+
+Test(TraceTests, Loader, .description = "Open a library, look a symbol up, "
+        "fail another one, and close it. Every step should be traced.") {
+    std::uint64_t start = Trace::now();
+
+    {
+        cd::BasicLoader<cdb::DefaultBackend> libm("libm.so.6");
+
+        (void)libm.getSymbol<void *>("cos");
+        cr_assert_throw((void)libm.getSymbol<void *>("no_such_symbol"),
+                cde::DLException<cde::Type::LoadSym>);
+        (void)libm.reset("libm.so.6");
+    }
+
+    std::vector<Trace::Event> events = since(start);
+
+    cr_assert_eq(count(events, Kind::Load, "libm.so.6"), 2);
+    cr_assert_eq(count(events, Kind::Resolve, "cos"), 1);
+    cr_assert_eq(count(events, Kind::Error, "no_such_symbol"), 1);
+    cr_assert_eq(count(events, Kind::Reset, "libm.so.6"), 1);
+    cr_assert_geq(count(events, Kind::Close, "libm.so.6"), 1);
+}
+
+Test(TraceTests, Disabled, .description = "Use a loader while tracing is "
+        "disabled. Nothing should be recorded.") {
+    Trace::setEnabled(false);
+    std::uint64_t start = Trace::now();
+
+    {
+        cd::BasicLoader<cdb::DefaultBackend> libm("libm.so.6");
+
+        (void)libm.getSymbol<void *>("cos");
+    }
+
+    std::size_t n = since(start).size();
+
+    cr_assert_eq(n, 0);
+}
+
+Test(TraceTests, Wrap, .description = "Record more events than a ring holds. "
+        "Only the last ones should be kept.") {
+    std::vector<Trace::Event> events;
+
+    std::thread([]() {
+        for (std::size_t i = 0; i < Trace::ring_size + 100; ++i)
+            Trace::record(Kind::Resolve, "wrap_" + std::to_string(i), Trace::now(), 1);
+    }).join();
+
+    for (Trace::Event const &e : Trace::collect())
+        if (e.name.compare(0, 5, "wrap_") == 0)
+            events.push_back(e);
+
+    cr_assert_eq(events.size(), Trace::ring_size);
+    cr_assert_eq(events.front().name, "wrap_100");
+    cr_assert_eq(events.back().name, "wrap_" + std::to_string(Trace::ring_size + 99));
+}
+
+Test(TraceTests, Threads, .description = "Record events from several threads "
+        "while another one collects them. Every event should be kept.") {
+    std::uint64_t start = Trace::now();
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+
+    std::thread reader([&]() {
+        while (!done.load())
+            (void)Trace::collect();
+    });
+
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([]() {
+            for (int i = 0; i < 500; ++i)
+                Trace::Span span(Kind::Resolve, "threaded_symbol");
+        });
+
+    for (auto &t : threads)
+        t.join();
+    done.store(true);
+    reader.join();
+
+    std::size_t n = count(since(start), Kind::Resolve, "threaded_symbol");
+
+    cr_assert_eq(n, 2000);
+}
+
+Test(TraceTests, Chrome, .description = "Export a span and an error. The JSON "
+        "document should hold a complete and an instant event.") {
+    std::ostringstream out;
+
+    Trace::record(Kind::Load, "/some/\"quoted\"/lib.so", Trace::now(), 1500);
+    Trace::instant(Kind::Error, "chrome_error");
+    Trace::writeChrome(out);
+
+    std::string json = out.str();
+
+    cr_assert_neq(json.find("\"traceEvents\":["), std::string::npos);
+    cr_assert_neq(json.find("\"name\":\"load /some/\\\"quoted\\\"/lib.so\",\"cat\":\"load\",\"ph\":\"X\""), std::string::npos);
+    cr_assert_neq(json.find("\"dur\":1.500"), std::string::npos);
+    cr_assert_neq(json.find("\"name\":\"error chrome_error\",\"cat\":\"error\",\"ph\":\"i\",\"s\":\"t\""), std::string::npos);
+}